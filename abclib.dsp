@@ -4171,6 +4171,14 @@ SOURCE=.\src\misc\util\utilSort.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\misc\util\utilStat.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\misc\util\utilStat.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\misc\util\utilTruth.h
 # End Source File
 # End Group
@@ -42,6 +42,7 @@
 #include "misc/nm/nm.h"
 #include "misc/mem/mem.h"
 #include "misc/util/utilCex.h"
+#include "misc/util/utilStat.h"
 #include "misc/extra/extra.h"
 
 ////////////////////////////////////////////////////////////////////////
@@ -128,10 +129,10 @@ struct Abc_Time_t_
     float             Fall;
 };
 
-struct Abc_Obj_t_     // 48/72 bytes (32-bits/64-bits)
+struct Abc_Obj_t_     // 52/80 bytes (32-bits/64-bits)
 {
     Abc_Ntk_t *       pNtk;          // the host network
-    Abc_Obj_t *       pNext;         // the next pointer in the hash table
+    Abc_Obj_t *       pNext;         // the next pointer (temporary)
     int               Id;            // the object ID
     unsigned          Type    :  4;  // the object type
     unsigned          fMarkA  :  1;  // the multipurpose mark
@@ -151,9 +152,6 @@ struct Abc_Obj_t_     // 48/72 bytes (32-bits/64-bits)
       Abc_Obj_t *     pCopy;         // the copy of this object
       int             iTemp;
       float           dTemp; }; 
-    float             pr;           // pagerank score of the node 
-    float             ppr;          // previous pagerank score of the node 
-    unsigned          fHandled:  1;  // marks the node is handled
     List_Ptr_Node_t * oLNode;        // pointer to the node in the ordered list
 };
 
@@ -199,10 +197,13 @@ struct Abc_Ntk_t_
     Mem_Step_t *      pMmStep;       // memory manager for arrays
     void *            pManFunc;      // functionality manager (AIG manager, BDD manager, or memory manager for SOPs)
     Abc_ManTime_t *   pManTime;      // the timing manager (for mapped networks) stores arrival/required times for all nodes
-    void *            pManCut;       // the cut manager (for AIGs) stores information about the cuts computed for the nodes
+    void *            pManCut;       // the cut manager (for AIGs) stores information about the cuts computed for the nodes (kept between rewriting passes)
     float             AndGateDelay;  // an average estimated delay of one AND gate
     int               LevelMax;      // maximum number of levels
     Vec_Int_t *       vLevelsR;      // level in the reverse topological order (for AIGs)
+    Vec_Flt_t *       vPageRank;     // PageRank scores of the objects (by object ID)
+    Vec_Bit_t *       vHandled;      // the objects handled by the current pass (by object ID)
+    float             PageRankBase;  // the constant term of the PageRank scores
     Vec_Ptr_t *       vSupps;        // CO support information
     int *             pModel;        // counter-example (for miters)
     Abc_Cex_t *       pSeqModel;     // counter-example (for sequential miters)
@@ -348,15 +349,15 @@ static inline Abc_Ntk_t * Abc_ObjModel( Abc_Obj_t * pObj )           { assert( p
 static inline void *      Abc_ObjData( Abc_Obj_t * pObj )            { return pObj->pData;              }
 static inline Abc_Obj_t * Abc_ObjEquiv( Abc_Obj_t * pObj )           { return (Abc_Obj_t *)pObj->pData; }
 static inline Abc_Obj_t * Abc_ObjCopyCond( Abc_Obj_t * pObj )        { return Abc_ObjRegular(pObj)->pCopy? Abc_ObjNotCond(Abc_ObjRegular(pObj)->pCopy, Abc_ObjIsComplement(pObj)) : NULL;  }
-static float       Abc_ObjPPR( Abc_Obj_t * pObj )             { return pObj->ppr;                }   
-static float       Abc_ObjPR( Abc_Obj_t * pObj )              { return pObj->pr;                 }
+static inline float       Abc_ObjPR( Abc_Obj_t * pObj )              { Vec_Flt_t * v = pObj->pNtk->vPageRank; return (v && pObj->Id < Vec_FltSize(v)) ? Vec_FltEntry(v, pObj->Id) : 0; }
+static inline int         Abc_ObjIsHandled( Abc_Obj_t * pObj )       { Vec_Bit_t * v; if ( pObj->Type == ABC_OBJ_NONE ) return 0; v = pObj->pNtk->vHandled; return (v && pObj->Id < Vec_BitSize(v)) ? Vec_BitEntry(v, pObj->Id) : 0; }
 
 // setting data members of the network
 static inline void        Abc_ObjSetLevel( Abc_Obj_t * pObj, int Level )         { pObj->Level =  Level;    } 
 static inline void        Abc_ObjSetCopy( Abc_Obj_t * pObj, Abc_Obj_t * pCopy )  { pObj->pCopy =  pCopy;    } 
 static inline void        Abc_ObjSetData( Abc_Obj_t * pObj, void * pData )       { pObj->pData =  pData;    } 
-static inline void        Abc_ObjsetPPR( Abc_Obj_t * pObj, float ppr )           { pObj->ppr =  ppr;        }
-static inline void        Abc_ObjsetPR( Abc_Obj_t * pObj, float pr )             { pObj->pr =  pr;          }
+static inline void        Abc_ObjsetPR( Abc_Obj_t * pObj, float pr )             { if ( pObj->pNtk->vPageRank == NULL ) pObj->pNtk->vPageRank = Vec_FltAlloc( 0 ); Vec_FltFillExtra( pObj->pNtk->vPageRank, pObj->Id + 1, 0 ); Vec_FltWriteEntry( pObj->pNtk->vPageRank, pObj->Id, pr ); }
+static inline void        Abc_ObjSetHandled( Abc_Obj_t * pObj, int fHandled )    { if ( pObj->Type == ABC_OBJ_NONE ) return; if ( pObj->pNtk->vHandled == NULL ) { if ( !fHandled ) return; pObj->pNtk->vHandled = Vec_BitStart( Vec_PtrSize(pObj->pNtk->vObjs) ); } Vec_BitSetEntry( pObj->pNtk->vHandled, pObj->Id, fHandled ); }
 
 // checking the object type
 static inline int         Abc_ObjIsNone( Abc_Obj_t * pObj )          { return pObj->Type == ABC_OBJ_NONE;    }
@@ -566,7 +567,7 @@ extern ABC_DLL int                Abc_AigCleanupInc( Abc_Aig_t * pMan );
 extern ABC_DLL int                Abc_AigCheck( Abc_Aig_t * pMan );
 extern ABC_DLL int                Abc_AigLevel( Abc_Ntk_t * pNtk );
 // Network path analysis    
-extern ABC_DLL float               Abc_NtkPathRank( Abc_Ntk_t * pNtk ); 
+extern ABC_DLL float               Abc_NtkPathRank( Abc_Ntk_t * pNtk, int nThreads ); 
 extern ABC_DLL float               Abc_NtkMaxPR( Abc_Ntk_t * pNtk ); 
 // lazy update strategy
 extern ABC_DLL void                Abc_AigUpdateLevel_Trigger( Abc_Aig_t * pMan, int candidateLevel, int finalUpdate );
@@ -579,6 +580,7 @@ extern ABC_DLL int                Abc_AigQueryUnhandledLevel( Abc_Obj_t * pNode
 extern ABC_DLL Abc_Obj_t *        Abc_AigConst1( Abc_Ntk_t * pNtk );
 extern ABC_DLL Abc_Obj_t *        Abc_AigAnd( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 );
 extern ABC_DLL Abc_Obj_t *        Abc_AigAndLookup( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 );
+extern ABC_DLL void               Abc_AigAndPrefetch( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 );
 extern ABC_DLL Abc_Obj_t *        Abc_AigXorLookup( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1, int * pType );
 extern ABC_DLL Abc_Obj_t *        Abc_AigMuxLookup( Abc_Aig_t * pMan, Abc_Obj_t * pC, Abc_Obj_t * pT, Abc_Obj_t * pE, int * pType );
 extern ABC_DLL Abc_Obj_t *        Abc_AigOr( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 );
@@ -592,6 +594,7 @@ extern ABC_DLL void               Abc_AigDeleteNode( Abc_Aig_t * pMan, Abc_Obj_t
 extern ABC_DLL void               Abc_AigDeleteNodeInc( Abc_Aig_t * pMan, Abc_Obj_t * pOld );
 
 extern ABC_DLL void               Abc_AigRehash( Abc_Aig_t * pMan );
+extern ABC_DLL void               Abc_AigRemapIds( Abc_Aig_t * pMan, Vec_Int_t * vMap );
 extern ABC_DLL int                Abc_AigNodeHasComplFanoutEdge( Abc_Obj_t * pNode );
 extern ABC_DLL int                Abc_AigNodeHasComplFanoutEdgeTrav( Abc_Obj_t * pNode );
 extern ABC_DLL void               Abc_AigPrintNode( Abc_Obj_t * pNode );
@@ -601,6 +604,9 @@ extern ABC_DLL void               Abc_AigSetNodePhases( Abc_Ntk_t * pNtk );
 extern ABC_DLL Vec_Ptr_t *        Abc_AigUpdateStart( Abc_Aig_t * pMan, Vec_Ptr_t ** pvUpdatedNets );
 extern ABC_DLL void               Abc_AigUpdateStop( Abc_Aig_t * pMan );
 extern ABC_DLL void               Abc_AigUpdateReset( Abc_Aig_t * pMan );
+extern ABC_DLL void               Abc_AigSetTouched( Abc_Aig_t * pMan, Vec_Int_t * vTouched );
+extern ABC_DLL void               Abc_AigSetDeleted( Abc_Aig_t * pMan, Vec_Int_t * vDeleted );
+extern ABC_DLL void               Abc_AigSetDeferLevels( Abc_Aig_t * pMan, int fDefer );
 /*=== abcAttach.c ==========================================================*/
 extern ABC_DLL int                Abc_NtkAttach( Abc_Ntk_t * pNtk );
 /*=== abcBarBuf.c ==========================================================*/
@@ -629,6 +635,15 @@ extern ABC_DLL int                Abc_NtkIsAcyclicHierarchy( Abc_Ntk_t * pNtk );
 extern ABC_DLL int                Abc_NtkCheckUniqueCiNames( Abc_Ntk_t * pNtk );
 extern ABC_DLL int                Abc_NtkCheckUniqueCoNames( Abc_Ntk_t * pNtk );
 extern ABC_DLL int                Abc_NtkCheckUniqueCioNames( Abc_Ntk_t * pNtk );
+/*=== abcCkp.c ==========================================================*/
+typedef struct Abc_Ckp_t_         Abc_Ckp_t;
+extern ABC_DLL Abc_Ckp_t *        Abc_NtkCkpStart( char * pFileName, int nSecs, int fVerbose );
+extern ABC_DLL void               Abc_NtkCkpStop( Abc_Ckp_t * p );
+extern ABC_DLL void               Abc_NtkCkpUpdate( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, int iNode, int nNodes, int nNodeIdMax, int nRewritten, int nNodesBeg );
+extern ABC_DLL Abc_Ntk_t *        Abc_NtkCkpResume( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, char * pFileName );
+extern ABC_DLL int                Abc_NtkCkpRestoreList( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, int fUpdateLevel, int * piNode, int * pnNodes, int * pnRewritten, int * pnNodesBeg );
+extern ABC_DLL int                Abc_NtkCkpNodeIsFresh( Abc_Ckp_t * p, Abc_Obj_t * pNode );
+extern ABC_DLL void               Abc_NtkCkpRemapIds( Abc_Ckp_t * p, Vec_Int_t * vMap );
 /*=== abcCollapse.c ==========================================================*/
 extern ABC_DLL Abc_Ntk_t *        Abc_NtkCollapse( Abc_Ntk_t * pNtk, int fBddSizeMax, int fDualRail, int fReorder, int fReverse, int fDumpOrder, int fVerbose );
 extern ABC_DLL Abc_Ntk_t *        Abc_NtkCollapseSat( Abc_Ntk_t * pNtk, int nCubeLim, int nBTLimit, int nCostMax, int fCanon, int fReverse, int fCnfShared, int fVerbose );
@@ -639,6 +654,10 @@ extern ABC_DLL void *             Abc_NodeGetCuts( void * p, Abc_Obj_t * pObj, i
 extern ABC_DLL void               Abc_NodeGetCutsSeq( void * p, Abc_Obj_t * pObj, int fFirst );
 extern ABC_DLL void *             Abc_NodeReadCuts( void * p, Abc_Obj_t * pObj );
 extern ABC_DLL void               Abc_NodeFreeCuts( void * p, Abc_Obj_t * pObj );
+extern ABC_DLL void               Abc_NodeFreeCutsTfo( void * p, Abc_Obj_t * pObj );
+extern ABC_DLL void               Abc_NtkRemapCuts( Abc_Ntk_t * pNtk, Vec_Int_t * vMap );
+extern ABC_DLL void               Abc_NtkFreeCuts( Abc_Ntk_t * pNtk );
+extern ABC_DLL void               Abc_NtkLimitCuts( Abc_Ntk_t * pNtk );
 /*=== abcDar.c ============================================================*/
 extern ABC_DLL int                Abc_NtkPhaseFrameNum( Abc_Ntk_t * pNtk );
 extern ABC_DLL int                Abc_NtkDarPrintCone( Abc_Ntk_t * pNtk );
@@ -681,8 +700,12 @@ extern ABC_DLL Abc_Ntk_t *        Abc_NtkFindExact( word * pTruth, int nVars, in
 /*=== abcFanio.c ==========================================================*/
 extern ABC_DLL void               Abc_ObjAddFanin( Abc_Obj_t * pObj, Abc_Obj_t * pFanin );
 extern ABC_DLL void               Abc_ObjDeleteFanin( Abc_Obj_t * pObj, Abc_Obj_t * pFanin );
+extern ABC_DLL void               Abc_ObjReserveFanouts( Abc_Obj_t * pObj, int nFanouts );
 extern ABC_DLL void               Abc_ObjRemoveFanins( Abc_Obj_t * pObj );
+extern ABC_DLL void               Abc_ObjRemoveFaninsLazy( Abc_Obj_t * pObj );
 extern ABC_DLL void               Abc_ObjPatchFanin( Abc_Obj_t * pObj, Abc_Obj_t * pFaninOld, Abc_Obj_t * pFaninNew );
+extern ABC_DLL void               Abc_ObjPatchFaninLazy( Abc_Obj_t * pObj, Abc_Obj_t * pFaninOld, Abc_Obj_t * pFaninNew );
+extern ABC_DLL int                Abc_ObjCompactFanouts( Abc_Obj_t * pObj );
 extern ABC_DLL void               Abc_ObjPatchFanoutFanin( Abc_Obj_t * pObj, int iObjNew );
 extern ABC_DLL Abc_Obj_t *        Abc_ObjInsertBetween( Abc_Obj_t * pNodeIn, Abc_Obj_t * pNodeOut, Abc_ObjType_t Type );
 extern ABC_DLL void               Abc_ObjTransferFanout( Abc_Obj_t * pObjOld, Abc_Obj_t * pObjNew );
@@ -861,6 +884,27 @@ extern ABC_DLL Odc_Man_t *        Abc_NtkDontCareAlloc( int nVarsMax, int nLevel
 extern ABC_DLL void               Abc_NtkDontCareClear( Odc_Man_t * p );
 extern ABC_DLL void               Abc_NtkDontCareFree( Odc_Man_t * p );
 extern ABC_DLL int                Abc_NtkDontCareCompute( Odc_Man_t * p, Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves, unsigned * puTruth );
+/*=== abcPart.c ==========================================================*/
+// the max number of threads of rewrite/refactor/resub (see Util_ProcessThreads)
+#define ABC_RESYN_THREADS_MAX  99
+typedef struct Abc_ResynPars_t_   Abc_ResynPars_t;
+struct Abc_ResynPars_t_
+{
+    int               Engine;        // 0 = rewrite, 1 = refactor, 2 = resub
+    int               nThreads;      // the number of threads
+    int               nPartSize;     // the number of nodes in one partition (0 = automatic)
+    int               nNodeSizeMax;  // refactor: the max support of the collapsed node
+    int               nConeSizeMax;  // refactor: the max support of the containing cone
+    int               nCutsMax;      // resub: the max cut size
+    int               nNodesMax;     // resub: the max number of nodes to add
+    int               nLevelsOdc;    // resub: the number of fanout levels for ODC computation
+    int               nMinSaved;     // refactor, resub: the min number of nodes saved
+    int               fUpdateLevel;  // preserve the number of levels
+    int               fUseZeros;     // use zero-cost replacements
+    int               fUseDcs;       // refactor: use don't-cares
+    int               fVerbose;      // verbose printout
+};
+extern ABC_DLL Abc_Ntk_t *        Abc_NtkResynPartitioned( Abc_Ntk_t * pNtk, Abc_ResynPars_t * pPars );
 /*=== abcPrint.c ==========================================================*/
 extern ABC_DLL float              Abc_NtkMfsTotalSwitching( Abc_Ntk_t * pNtk );
 extern ABC_DLL float              Abc_NtkMfsTotalGlitching( Abc_Ntk_t * pNtk, int nPats, int Prob, int fVerbose );
@@ -899,11 +943,17 @@ extern ABC_DLL Vec_Ptr_t *        Abc_NtkManCutReadVisited( Abc_ManCut_t * p );
 extern ABC_DLL Vec_Ptr_t *        Abc_NodeFindCut( Abc_ManCut_t * p, Abc_Obj_t * pRoot, int  fContain );
 extern ABC_DLL void               Abc_NodeConeCollect( Abc_Obj_t ** ppRoots, int nRoots, Vec_Ptr_t * vFanins, Vec_Ptr_t * vVisited, int fIncludeFanins );
 extern ABC_DLL Vec_Ptr_t *        Abc_NodeCollectTfoCands( Abc_ManCut_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vFanins, int LevelMax );
+/*=== abcRank.c ==========================================================*/
+extern ABC_DLL int                Abc_NtkPageRank( Abc_Ntk_t * pNtk, int nThreads );
+extern ABC_DLL int                Abc_NtkPageRankRefresh( Abc_Ntk_t * pNtk, Vec_Int_t * vSeeds, int nIters );
 /*=== abcRefs.c ==========================================================*/
 extern ABC_DLL int                Abc_NodeMffcSize( Abc_Obj_t * pNode );
 extern ABC_DLL int                Abc_NodeMffcSizeSupp( Abc_Obj_t * pNode );
 extern ABC_DLL int                Abc_NodeMffcSizeStop( Abc_Obj_t * pNode );
 extern ABC_DLL int                Abc_NodeMffcLabelAig( Abc_Obj_t * pNode );
+extern ABC_DLL int                Abc_NodeMffcCollectAig( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vMffc, Vec_Ptr_t * vCone, Vec_Int_t * vRefs );
+extern ABC_DLL int                Abc_NodeMffcCollectLimit( Abc_Obj_t * pNode, Vec_Ptr_t * vMffc, int nLimit );
+extern ABC_DLL int                Abc_NodeMffcLabelLeaves( Vec_Ptr_t * vMffc, Vec_Ptr_t * vLeaves, int * pfLabeled );
 extern ABC_DLL int                Abc_NodeMffcLabel( Abc_Obj_t * pNode, Vec_Ptr_t * vNodes );
 extern ABC_DLL void               Abc_NodeMffcConeSupp( Abc_Obj_t * pNode, Vec_Ptr_t * vCone, Vec_Ptr_t * vSupp );
 extern ABC_DLL int                Abc_NodeDeref_rec( Abc_Obj_t * pNode );
@@ -911,7 +961,8 @@ extern ABC_DLL int                Abc_NodeRef_rec( Abc_Obj_t * pNode );
 /*=== abcRefactor.c ==========================================================*/
 extern ABC_DLL int                Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nConeSizeMax, int  fUpdateLevel, int  fUseZeros, int  fUseDcs, int  fVerbose );
 /*=== abcRewrite.c ==========================================================*/
-extern ABC_DLL int                Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int fVerbose, int fVeryVerbose, int fPlaceEnable );
+extern ABC_DLL int                Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int nThreads, int nNodeBudget, int nTimeLimit, int fVerbose, int fVeryVerbose, int fPlaceEnable, Abc_Ckp_t * pCkp );
+extern ABC_DLL void *             Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk );
 /*=== abcSat.c ==========================================================*/
 extern ABC_DLL int                Abc_NtkMiterSat( Abc_Ntk_t * pNtk, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimit, int fVerbose, ABC_INT64_T * pNumConfs, ABC_INT64_T * pNumInspects );
 extern ABC_DLL void *             Abc_NtkMiterSatCreate( Abc_Ntk_t * pNtk, int fAllPrimes );
@@ -1072,6 +1123,7 @@ extern ABC_DLL int                Abc_NodeCompareLevelsDecrease( Abc_Obj_t ** pp
 extern ABC_DLL Vec_Int_t *        Abc_NtkFanoutCounts( Abc_Ntk_t * pNtk );
 extern ABC_DLL Vec_Ptr_t *        Abc_NtkCollectObjects( Abc_Ntk_t * pNtk );
 extern ABC_DLL Vec_Int_t *        Abc_NtkGetCiIds( Abc_Ntk_t * pNtk );
+extern ABC_DLL Vec_Int_t *        Abc_NtkCompactIds( Abc_Ntk_t * pNtk );
 extern ABC_DLL void               Abc_NtkReassignIds( Abc_Ntk_t * pNtk );
 extern ABC_DLL int                Abc_ObjPointerCompare( void ** pp1, void ** pp2 );
 extern ABC_DLL void               Abc_NtkTransferCopy( Abc_Ntk_t * pNtk );
@@ -22,17 +22,6 @@
 
 ABC_NAMESPACE_IMPL_START
 
-abctime global_update_time = 0;         // do not use 
-// abctime global_traverse_time = 0; 
-abctime global_time = 0; 
-abctime global_resynthesis_time = 0; 
-abctime global_cut_time = 0; 
-abctime global_aig_update_time = 0;     // maintain order, level /reverse level computation 
-abctime global_aig_converter_time = 0;      
-long int global_level_updates = 0;
-long int global_reverse_updates = 0;
-long int global_node_rewritten = 0; 
-long int global_reorder_nodes = 0;
 
 
  
@@ -63,28 +52,49 @@ long int global_reorder_nodes = 0;
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+// the entry of the structural hashing table
+typedef struct Abc_AigEnt_t_ Abc_AigEnt_t;
+struct Abc_AigEnt_t_
+{
+    int               iLit0;             // the first fanin literal (-1 if the entry was deleted)
+    int               iLit1;             // the second fanin literal
+    Abc_Obj_t *       pObj;              // the AND node (NULL if the entry is empty)
+};
+
 // the simple AIG manager
 struct Abc_Aig_t_
 {
     Abc_Ntk_t *       pNtkAig;           // the AIG network
     Abc_Obj_t *       pConst1;           // the constant 1 object (not a node!)
-    Abc_Obj_t **      pBins;             // the table bins
-    int               nBins;             // the size of the table
-    int               nEntries;          // the total number of entries in the table
+    Abc_AigEnt_t *    pTable;            // the table (open addressing with linear probing)
+    int               nTableSize;        // the size of the table (a power of 2)
+    int               nEntries;          // the total number of entries in both tables
+    Abc_AigEnt_t *    pTableOld;         // the previous table while it is being migrated
+    int               nTableSizeOld;     // the size of the previous table
+    int               iTableOld;         // the next entry of the previous table to migrate
     Vec_Ptr_t *       vNodes;            // the temporary array of nodes
     Vec_Ptr_t *       vStackReplaceOld;  // the nodes to be replaced
     Vec_Ptr_t *       vStackReplaceNew;  // the nodes to be used for replacement
     Vec_Vec_t *       vLevels;           // the nodes to be updated
     Vec_Vec_t *       vLevelsR;          // the nodes to be updated
 
-    P_Que_t *         qLevels;            // the queue of nodes to be updated
-    P_Que_t *         qLevelsR;           // the queue of nodes to be updated    
+    B_Que_t *         qLevels;            // the nodes whose levels are updated (bucketed by level)
+    B_Que_t *         qLevelsR;           // the nodes whose reverse levels are updated (bucketed by reverse level)
     Vec_Ptr_t *       vTopoAff;           // the queue of nodes whose topological order are affected
+    Vec_Int_t *       vLevelsRDefer;      // the nodes whose reverse levels may be relaxed later
+    Vec_Bit_t *       vLevelsDirty;       // the nodes waiting in qLevels (by object ID)
+    Vec_Wrd_t *       vFanoutsLazy;       // the (fanin, fanout) pairs of the rewired fanouts to be compacted
+    Vec_Int_t *       vFanoutsSeen;       // the temporary flags used while compacting them
+    Vec_Int_t *       vFanoutsDead;       // for each object, the number of its lazily deleted fanouts
+    Vec_Int_t *       vFaninsDead;        // the objects with lazily deleted fanouts
 
     int               nLevelMin;         // the minimum level to be updated
+    int               fDeferLevels;      // the level updates wait for Abc_AigUpdateLevel_Trigger()
     
     Vec_Ptr_t *       vAddedCells;       // the added nodes
     Vec_Ptr_t *       vUpdatedNets;      // the nodes whose fanouts have changed
+    Vec_Int_t *       vTouched;          // the IDs of the nodes whose fanouts have changed (if not NULL)
+    Vec_Int_t *       vDeleted;          // the IDs of the deleted nodes (if not NULL)
 
     // Heap<Abc_Obj_t *>  vHeap;            // the heap of nodes to be updated 
     // Heap<Abc_Obj_t *>  vHeapR;            // the heap of nodes to be updated 
@@ -98,40 +108,47 @@ struct Abc_Aig_t_
     int               nStrash2;
 };
 
-// iterators through the entries in the linked lists of nodes
-#define Abc_AigBinForEachEntry( pBin, pEnt )                   \
-    for ( pEnt = pBin;                                         \
-          pEnt;                                                \
-          pEnt = pEnt->pNext )
-#define Abc_AigBinForEachEntrySafe( pBin, pEnt, pEnt2 )        \
-    for ( pEnt = pBin,                                         \
-          pEnt2 = pEnt? pEnt->pNext: NULL;                     \
-          pEnt;                                                \
-          pEnt = pEnt2,                                        \
-          pEnt2 = pEnt? pEnt->pNext: NULL )
-
-// hash key for the structural hash table
-//static inline unsigned Abc_HashKey2( Abc_Obj_t * p0, Abc_Obj_t * p1, int TableSize ) { return ((unsigned)(p0) + (unsigned)(p1) * 12582917) % TableSize; }
-//static inline unsigned Abc_HashKey2( Abc_Obj_t * p0, Abc_Obj_t * p1, int TableSize ) { return ((unsigned)((a)->Id + (b)->Id) * ((a)->Id + (b)->Id + 1) / 2) % TableSize; }
-
-// hashing the node
-static unsigned Abc_HashKey2( Abc_Obj_t * p0, Abc_Obj_t * p1, int TableSize ) 
+// the number of entries of the previous table migrated with each insertion
+#define ABC_AIG_MIGRATE_STEP  4
+
+// iterator through the entries of the table (the table should not be migrating)
+#define Abc_AigTableForEachEntry( pMan, pEnt, i )                          \
+    for ( i = 0; i < (pMan)->nTableSize; i++ )                             \
+        if ( ((pEnt) = (pMan)->pTable[i].pObj) == NULL ) {} else
+
+// the fanin literals of the node
+static inline int Abc_AigLit0( Abc_Obj_t * p ) { return Abc_Var2Lit( Abc_ObjFaninId0(p), Abc_ObjFaninC0(p) ); }
+static inline int Abc_AigLit1( Abc_Obj_t * p ) { return Abc_Var2Lit( Abc_ObjFaninId1(p), Abc_ObjFaninC1(p) ); }
+static inline int Abc_AigLit( Abc_Obj_t * p )  { return Abc_Var2Lit( Abc_ObjRegular(p)->Id, Abc_ObjIsComplement(p) ); }
+
+// hashing the fanin literals
+static inline unsigned Abc_HashKey2( int iLit0, int iLit1, int TableSize ) 
 {
-    unsigned Key = 0;
-    Key ^= Abc_ObjRegular(p0)->Id * 7937;
-    Key ^= Abc_ObjRegular(p1)->Id * 2971;
-    Key ^= Abc_ObjIsComplement(p0) * 911;
-    Key ^= Abc_ObjIsComplement(p1) * 353;
-    return Key % TableSize;
+    unsigned Key = (unsigned)iLit0 * 0x9E3779B1 ^ (unsigned)iLit1 * 0x85EBCA77;
+    return (Key ^ (Key >> 16)) & (TableSize - 1);
 }
 
+// returns 1 if the node is in the order list at or before the current iterator
+static inline int Abc_AigNodeIsOrdered( Abc_Aig_t * pMan, Abc_Obj_t * pNode ) 
+{
+    return pNode->oLNode != NULL && !List_PtrNodePrecedes( pMan->oList->pCurItera, pNode->oLNode );
+}
+// the nodes waiting in qLevels are marked in a separate array rather than with fMarkA, 
+// so that the cut and cone computations using fMarkA can run while the updates are pending
+static inline int  Abc_AigNodeIsDirty( Abc_Aig_t * pMan, Abc_Obj_t * pNode )            { return pNode->Id < Vec_BitSize(pMan->vLevelsDirty) && Vec_BitEntry(pMan->vLevelsDirty, pNode->Id); }
+static inline void Abc_AigNodeSetDirty( Abc_Aig_t * pMan, Abc_Obj_t * pNode, int fDirty ) { Vec_BitSetEntry( pMan->vLevelsDirty, pNode->Id, fDirty ); }
+
 // structural hash table procedures
 static Abc_Obj_t * Abc_AigAndCreate( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 );
 static Abc_Obj_t * Abc_AigAndCreateFrom( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1, Abc_Obj_t * pAnd );
 static void        Abc_AigAndDelete( Abc_Aig_t * pMan, Abc_Obj_t * pThis );
 static void        Abc_AigResize( Abc_Aig_t * pMan );
+static void        Abc_AigTableInsert( Abc_Aig_t * pMan, Abc_Obj_t * pAnd );
+static void        Abc_AigTableMigrate( Abc_Aig_t * pMan, int nSteps );
 // incremental AIG procedures
 static void        Abc_AigReplace_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, int fUpdateLevel );
+static void        Abc_AigCompactFanoutsLazy( Abc_Aig_t * pMan );
+static void        Abc_AigDeleteNodeInc_rec( Abc_Aig_t * pMan, Abc_Obj_t * pNode );
 static void        Abc_AigUpdateLevel_int( Abc_Aig_t * pMan );
 static void        Abc_AigUpdateLevelR_int( Abc_Aig_t * pMan );
 static void        Abc_AigRemoveFromLevelStructure( Vec_Vec_t * vStruct, Abc_Obj_t * pNode );
@@ -144,7 +161,8 @@ static void        Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t
 // new graph incremental algorithm for reverse level updates
 static void        Abc_AigUpdateLevelR_new( Abc_Aig_t * pMan, Abc_Obj_t * pOld);
 static void        Abc_AigUpdateLevelInc_int( Abc_Aig_t * pMan );
-static void        Abc_AigUpdateLevelIncR_int( Abc_Aig_t * pMan );
+static void        Abc_AigUpdateLevelIncR_int( Abc_Aig_t * pMan, int fDefer );
+static void        Abc_AigUpdateLevelRelaxR_int( Abc_Aig_t * pMan );
 static void        Abc_AigAndDeleteInc( Abc_Aig_t * pMan, Abc_Obj_t * pThis );
 static void        Abc_AigReplaceFindAff_rec( Abc_Aig_t * pMan, Abc_Obj_t * pFrom);
  
@@ -171,18 +189,23 @@ Abc_Aig_t * Abc_AigAlloc( Abc_Ntk_t * pNtkAig )
     pMan = ABC_ALLOC( Abc_Aig_t, 1 );
     memset( pMan, 0, sizeof(Abc_Aig_t) );
     // allocate the table
-    pMan->nBins    = Abc_PrimeCudd( 10000 );
-    pMan->pBins    = ABC_ALLOC( Abc_Obj_t *, pMan->nBins );
-    memset( pMan->pBins, 0, sizeof(Abc_Obj_t *) * pMan->nBins );
+    pMan->nTableSize = (1 << 14);
+    pMan->pTable     = ABC_CALLOC( Abc_AigEnt_t, pMan->nTableSize );
     pMan->vNodes   = Vec_PtrAlloc( 100 );
     pMan->vLevels  = Vec_VecAlloc( 100 );
     pMan->vLevelsR = Vec_VecAlloc( 100 );
     pMan->vStackReplaceOld = Vec_PtrAlloc( 100 );
     pMan->vStackReplaceNew = Vec_PtrAlloc( 100 );
 
-    pMan->qLevels = P_QueAlloc( 100 );
-    pMan->qLevelsR = P_QueAlloc( 100 );
+    pMan->qLevels = B_QueAlloc( 100 );
+    pMan->qLevelsR = B_QueAlloc( 100 );
     pMan->vTopoAff = Vec_PtrAlloc( 100 );
+    pMan->vLevelsRDefer = Vec_IntAlloc( 100 );
+    pMan->vLevelsDirty = Vec_BitAlloc( 100 );
+    pMan->vFanoutsLazy = Vec_WrdAlloc( 100 );
+    pMan->vFanoutsSeen = Vec_IntAlloc( 100 );
+    pMan->vFanoutsDead = Vec_IntAlloc( 100 );
+    pMan->vFaninsDead = Vec_IntAlloc( 100 );
     pMan->nLevelMin = ABC_INFINITY;
 
     pMan->oList = List_PtrAlloc();
@@ -224,11 +247,18 @@ void Abc_AigFree( Abc_Aig_t * pMan )
     Vec_PtrFree( pMan->vStackReplaceNew );
     Vec_PtrFree( pMan->vNodes );
     // free the queues  
-    P_QueFree( pMan->qLevels );
-    P_QueFree( pMan->qLevelsR );
+    B_QueFree( pMan->qLevels );
+    B_QueFree( pMan->qLevelsR );
     Vec_PtrFree( pMan->vTopoAff );
+    Vec_IntFree( pMan->vLevelsRDefer );
+    Vec_BitFree( pMan->vLevelsDirty );
+    Vec_WrdFree( pMan->vFanoutsLazy );
+    Vec_IntFree( pMan->vFanoutsSeen );
+    Vec_IntFree( pMan->vFanoutsDead );
+    Vec_IntFree( pMan->vFaninsDead );
     List_PtrFree( pMan->oList );
-    ABC_FREE( pMan->pBins );
+    ABC_FREE( pMan->pTableOld );
+    ABC_FREE( pMan->pTable );
     ABC_FREE( pMan );
 }
 
@@ -253,10 +283,10 @@ int Abc_AigCleanup( Abc_Aig_t * pMan )
     nNodesOld = pMan->nEntries;
     // collect the AND nodes that do not fanout
     vDangles = Vec_PtrAlloc( 100 );
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntry( pMan->pBins[i], pAnd )
-            if ( Abc_ObjFanoutNum(pAnd) == 0 )
-                Vec_PtrPush( vDangles, pAnd );
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+    Abc_AigTableForEachEntry( pMan, pAnd, i )
+        if ( Abc_ObjFanoutNum(pAnd) == 0 )
+            Vec_PtrPush( vDangles, pAnd );
     // process the dangling nodes and their MFFCs
     Vec_PtrForEachEntry( Abc_Obj_t *, vDangles, pAnd, i )
         Abc_AigDeleteNode( pMan, pAnd );
@@ -309,9 +339,9 @@ int Abc_AigCheck( Abc_Aig_t * pMan )
     }
     // count the number of nodes in the table
     Counter = 0;
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntry( pMan->pBins[i], pAnd )
-            Counter++;
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+    Abc_AigTableForEachEntry( pMan, pAnd, i )
+        Counter++;
     if ( Counter != Abc_NtkNodeNum(pMan->pNtkAig) )
     {
         printf( "Abc_AigCheck: The number of nodes in the structural hashing table is wrong.\n" );
@@ -387,10 +417,6 @@ List_Ptr_t * Abc_AigGetOList(Abc_Aig_t * pMan){
 Abc_Obj_t * Abc_AigAndCreate( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 )
 {
     Abc_Obj_t * pAnd;
-    unsigned Key;
-    // check if it is a good time for table resizing
-    if ( pMan->nEntries > 2 * pMan->nBins )
-        Abc_AigResize( pMan );
     // order the arguments
     if ( Abc_ObjRegular(p0)->Id > Abc_ObjRegular(p1)->Id )
         pAnd = p0, p0 = p1, p1 = pAnd;
@@ -398,15 +424,14 @@ Abc_Obj_t * Abc_AigAndCreate( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 )
     pAnd = Abc_NtkCreateNode( pMan->pNtkAig );
     Abc_ObjAddFanin( pAnd, p0 );
     Abc_ObjAddFanin( pAnd, p1 );
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, Abc_ObjRegular(p0)->Id, Abc_ObjRegular(p1)->Id );
     // set the level of the new node
     pAnd->Level  = 1 + Abc_MaxInt( Abc_ObjRegular(p0)->Level, Abc_ObjRegular(p1)->Level ); 
     pAnd->fExor  = Abc_NodeIsExorType(pAnd);
     pAnd->fPhase = (Abc_ObjIsComplement(p0) ^ Abc_ObjRegular(p0)->fPhase) & (Abc_ObjIsComplement(p1) ^ Abc_ObjRegular(p1)->fPhase);
-    // add the node to the corresponding linked list in the table
-    Key = Abc_HashKey2( p0, p1, pMan->nBins );
-    pAnd->pNext      = pMan->pBins[Key];
-    pMan->pBins[Key] = pAnd;
-    pMan->nEntries++;
+    // add the node to the table
+    Abc_AigTableInsert( pMan, pAnd );
     // create the cuts if defined
 //    if ( pAnd->pNtk->pManCut )
 //        Abc_NodeGetCuts( pAnd->pNtk->pManCut, pAnd );
@@ -432,7 +457,6 @@ Abc_Obj_t * Abc_AigAndCreate( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 )
 Abc_Obj_t * Abc_AigAndCreateFrom( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1, Abc_Obj_t * pAnd )
 {
     Abc_Obj_t * pTemp;
-    unsigned Key;
     assert( !Abc_ObjIsComplement(pAnd) );
     // order the arguments
     if ( Abc_ObjRegular(p0)->Id > Abc_ObjRegular(p1)->Id )
@@ -440,14 +464,13 @@ Abc_Obj_t * Abc_AigAndCreateFrom( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t *
     // create the new node
     Abc_ObjAddFanin( pAnd, p0 );
     Abc_ObjAddFanin( pAnd, p1 );
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, Abc_ObjRegular(p0)->Id, Abc_ObjRegular(p1)->Id );
     // set the level of the new node
     pAnd->Level      = 1 + Abc_MaxInt( Abc_ObjRegular(p0)->Level, Abc_ObjRegular(p1)->Level ); 
     pAnd->fExor      = Abc_NodeIsExorType(pAnd);
-    // add the node to the corresponding linked list in the table
-    Key = Abc_HashKey2( p0, p1, pMan->nBins );
-    pAnd->pNext      = pMan->pBins[Key];
-    pMan->pBins[Key] = pAnd;
-    pMan->nEntries++;
+    // add the node to the table
+    Abc_AigTableInsert( pMan, pAnd );
     // create the cuts if defined
 //    if ( pAnd->pNtk->pManCut )
 //        Abc_NodeGetCuts( pAnd->pNtk->pManCut, pAnd );
@@ -472,6 +495,8 @@ Abc_Obj_t * Abc_AigAndCreateFrom( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t *
 Abc_Obj_t * Abc_AigAndLookup( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 )
 {
     Abc_Obj_t * pAnd, * pConst1;
+    Abc_AigEnt_t * pEnt;
+    int iLit0, iLit1, Mask;
     unsigned Key;
     assert( Abc_ObjRegular(p0)->pNtk->pManFunc == pMan );
     assert( Abc_ObjRegular(p1)->pNtk->pManFunc == pMan );
@@ -517,18 +542,47 @@ Abc_Obj_t * Abc_AigAndLookup( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 )
     // order the arguments
     if ( Abc_ObjRegular(p0)->Id > Abc_ObjRegular(p1)->Id )
         pAnd = p0, p0 = p1, p1 = pAnd;
-    // get the hash key for these two nodes
-    Key = Abc_HashKey2( p0, p1, pMan->nBins );
-    // find the matching node in the table
-    Abc_AigBinForEachEntry( pMan->pBins[Key], pAnd )
-        if ( p0 == Abc_ObjChild0(pAnd) && p1 == Abc_ObjChild1(pAnd) )
-        {
-//            assert( Abc_ObjFanoutNum(Abc_ObjRegular(p0)) && Abc_ObjFanoutNum(p1) );
-             return pAnd;
-        }
+    // find the matching node in the table (comparing the literals without touching the nodes)
+    iLit0 = Abc_AigLit( p0 );
+    iLit1 = Abc_AigLit( p1 );
+    Mask  = pMan->nTableSize - 1;
+    for ( Key = Abc_HashKey2( iLit0, iLit1, pMan->nTableSize ); (pEnt = pMan->pTable + Key)->pObj; Key = (Key + 1) & Mask )
+        if ( pEnt->iLit0 == iLit0 && pEnt->iLit1 == iLit1 )
+            return pEnt->pObj;
+    // look into the previous table if it is still being migrated
+    if ( pMan->pTableOld == NULL )
+        return NULL;
+    Mask  = pMan->nTableSizeOld - 1;
+    for ( Key = Abc_HashKey2( iLit0, iLit1, pMan->nTableSizeOld ); (pEnt = pMan->pTableOld + Key)->pObj || pEnt->iLit0 == -1; Key = (Key + 1) & Mask )
+        if ( pEnt->pObj && pEnt->iLit0 == iLit0 && pEnt->iLit1 == iLit1 )
+            return pEnt->pObj;
     return NULL;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Prefetches the table entry that Abc_AigAndLookup() will probe.]
+
+  Description [Allows the caller to issue the memory requests for several
+  lookups before performing them. The argument nodes can be complemented.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigAndPrefetch( Abc_Aig_t * pMan, Abc_Obj_t * p0, Abc_Obj_t * p1 )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    int iLit0, iLit1;
+    if ( Abc_ObjRegular(p0)->Id > Abc_ObjRegular(p1)->Id )
+        iLit0 = Abc_AigLit( p1 ), iLit1 = Abc_AigLit( p0 );
+    else
+        iLit0 = Abc_AigLit( p0 ), iLit1 = Abc_AigLit( p1 );
+    __builtin_prefetch( pMan->pTable + Abc_HashKey2(iLit0, iLit1, pMan->nTableSize) );
+#endif
+}
+
 /**Function*************************************************************
 
   Synopsis    [Returns the gate implementing EXOR of the two arguments if it exists.]
@@ -610,83 +664,149 @@ Abc_Obj_t * Abc_AigMuxLookup( Abc_Aig_t * pMan, Abc_Obj_t * pC, Abc_Obj_t * pT,
 ***********************************************************************/
 void Abc_AigAndDelete( Abc_Aig_t * pMan, Abc_Obj_t * pThis )
 {
-    Abc_Obj_t * pAnd, * pAnd0, * pAnd1, ** ppPlace;
-    unsigned Key;
+    Abc_AigEnt_t * pEnt;
+    int iLit0, iLit1, Mask;
+    unsigned Key, KeyNext, KeyHome;
     assert( !Abc_ObjIsComplement(pThis) );
     assert( Abc_ObjIsNode(pThis) );
     assert( Abc_ObjFaninNum(pThis) == 2 );
     assert( pMan->pNtkAig == pThis->pNtk );
-    // get the hash key for these two nodes
-    pAnd0 = Abc_ObjRegular( Abc_ObjChild0(pThis) );
-    pAnd1 = Abc_ObjRegular( Abc_ObjChild1(pThis) );
-    Key = Abc_HashKey2( Abc_ObjChild0(pThis), Abc_ObjChild1(pThis), pMan->nBins );
-    // find the matching node in the table
-    ppPlace = pMan->pBins + Key;
-    Abc_AigBinForEachEntry( pMan->pBins[Key], pAnd )
+    iLit0 = Abc_AigLit0( pThis );
+    iLit1 = Abc_AigLit1( pThis );
+    // find the node in the table
+    Mask  = pMan->nTableSize - 1;
+    for ( Key = Abc_HashKey2( iLit0, iLit1, pMan->nTableSize ); (pEnt = pMan->pTable + Key)->pObj; Key = (Key + 1) & Mask )
+        if ( pEnt->pObj == pThis )
+            break;
+    if ( pEnt->pObj )
     {
-        if ( pAnd != pThis )
+        // shift back the following entries of the cluster that may no longer be reached
+        for ( KeyNext = (Key + 1) & Mask; pMan->pTable[KeyNext].pObj; KeyNext = (KeyNext + 1) & Mask )
         {
-            ppPlace = &pAnd->pNext;
-            continue;
+            KeyHome = Abc_HashKey2( pMan->pTable[KeyNext].iLit0, pMan->pTable[KeyNext].iLit1, pMan->nTableSize );
+            if ( Key <= KeyNext ? (Key < KeyHome && KeyHome <= KeyNext) : (Key < KeyHome || KeyHome <= KeyNext) )
+                continue;
+            pMan->pTable[Key] = pMan->pTable[KeyNext];
+            Key = KeyNext;
         }
-        *ppPlace = pAnd->pNext;
-        break;
+        memset( pMan->pTable + Key, 0, sizeof(Abc_AigEnt_t) );
+    }
+    else
+    {
+        // the node is still in the previous table, where it is marked as deleted
+        assert( pMan->pTableOld != NULL );
+        Mask  = pMan->nTableSizeOld - 1;
+        for ( Key = Abc_HashKey2( iLit0, iLit1, pMan->nTableSizeOld ); (pEnt = pMan->pTableOld + Key)->pObj != pThis; Key = (Key + 1) & Mask )
+            assert( pEnt->pObj || pEnt->iLit0 == -1 );
+        pEnt->pObj  = NULL;
+        pEnt->iLit0 = -1;
     }
-    assert( pAnd == pThis );
     pMan->nEntries--;
-    // delete the cuts if defined
+    // delete the cuts if defined, including the cuts computed through this node
     if ( pThis->pNtk->pManCut )
-        Abc_NodeFreeCuts( pThis->pNtk->pManCut, pThis );
+        Abc_NodeFreeCutsTfo( pThis->pNtk->pManCut, pThis );
 }
 
 /**Function*************************************************************
 
-  Synopsis    [Resizes the hash table of AIG nodes.]
+  Synopsis    [Adds the node to the hash table of AIG nodes.]
 
-  Description []
+  Description [The table is resized incrementally: when it becomes half
+  full, a table of twice the size is started and the entries of the 
+  previous table are moved into it a few at a time with each insertion, 
+  while the lookups check both tables.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_AigResize( Abc_Aig_t * pMan )
+void Abc_AigTableInsert( Abc_Aig_t * pMan, Abc_Obj_t * pAnd )
 {
-    Abc_Obj_t ** pBinsNew;
-    Abc_Obj_t * pEnt, * pEnt2;
-    int nBinsNew, Counter, i;
-    abctime clk;
+    Abc_AigEnt_t * pEnt;
+    int iLit0, iLit1, Mask;
     unsigned Key;
+    // check if it is a good time for table resizing
+    if ( pMan->pTableOld )
+        Abc_AigTableMigrate( pMan, ABC_AIG_MIGRATE_STEP );
+    if ( 2 * (pMan->nEntries + 1) > pMan->nTableSize )
+        Abc_AigResize( pMan );
+    // add the node to the first empty entry after its key
+    iLit0 = Abc_AigLit0( pAnd );
+    iLit1 = Abc_AigLit1( pAnd );
+    Mask  = pMan->nTableSize - 1;
+    for ( Key = Abc_HashKey2( iLit0, iLit1, pMan->nTableSize ); (pEnt = pMan->pTable + Key)->pObj; Key = (Key + 1) & Mask )
+        assert( pEnt->iLit0 != iLit0 || pEnt->iLit1 != iLit1 );
+    pEnt->iLit0 = iLit0;
+    pEnt->iLit1 = iLit1;
+    pEnt->pObj  = pAnd;
+    pMan->nEntries++;
+}
 
-clk = Abc_Clock();
-    // get the new table size
-    nBinsNew = Abc_PrimeCudd( 3 * pMan->nBins ); 
-    // allocate a new array
-    pBinsNew = ABC_ALLOC( Abc_Obj_t *, nBinsNew );
-    memset( pBinsNew, 0, sizeof(Abc_Obj_t *) * nBinsNew );
-    // rehash the entries from the old table
-    Counter = 0;
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntrySafe( pMan->pBins[i], pEnt, pEnt2 )
-        {
-            Key = Abc_HashKey2( Abc_ObjChild0(pEnt), Abc_ObjChild1(pEnt), nBinsNew );
-            pEnt->pNext   = pBinsNew[Key];
-            pBinsNew[Key] = pEnt;
-            Counter++;
-        }
-    assert( Counter == pMan->nEntries );
-//    printf( "Increasing the structural table size from %6d to %6d. ", pMan->nBins, nBinsNew );
-//    ABC_PRT( "Time", Abc_Clock() - clk );
-    // replace the table and the parameters
-    ABC_FREE( pMan->pBins );
-    pMan->pBins = pBinsNew;
-    pMan->nBins = nBinsNew;
+/**Function*************************************************************
+
+  Synopsis    [Moves the given number of entries from the previous table.]
+
+  Description [Finishes the migration if nSteps is ABC_INFINITY.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigTableMigrate( Abc_Aig_t * pMan, int nSteps )
+{
+    Abc_AigEnt_t * pEntOld, * pEnt;
+    int Mask = pMan->nTableSize - 1;
+    unsigned Key;
+    if ( pMan->pTableOld == NULL )
+        return;
+    for ( ; nSteps > 0 && pMan->iTableOld < pMan->nTableSizeOld; nSteps--, pMan->iTableOld++ )
+    {
+        pEntOld = pMan->pTableOld + pMan->iTableOld;
+        if ( pEntOld->pObj == NULL )
+            continue;
+        for ( Key = Abc_HashKey2( pEntOld->iLit0, pEntOld->iLit1, pMan->nTableSize ); (pEnt = pMan->pTable + Key)->pObj; Key = (Key + 1) & Mask );
+        *pEnt = *pEntOld;
+        // the moved entry should not be found in the previous table
+        pEntOld->pObj  = NULL;
+        pEntOld->iLit0 = -1;
+    }
+    if ( pMan->iTableOld < pMan->nTableSizeOld )
+        return;
+    ABC_FREE( pMan->pTableOld );
+    pMan->nTableSizeOld = 0;
+    pMan->iTableOld = 0;
 }
 
 /**Function*************************************************************
 
   Synopsis    [Resizes the hash table of AIG nodes.]
 
+  Description [Starts the table of twice the size. The entries are moved
+  into it by Abc_AigTableMigrate().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigResize( Abc_Aig_t * pMan )
+{
+    // the previous migration should be over by now
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+//    printf( "Increasing the structural table size from %6d to %6d.\n", pMan->nTableSize, 2 * pMan->nTableSize );
+    pMan->pTableOld     = pMan->pTable;
+    pMan->nTableSizeOld = pMan->nTableSize;
+    pMan->iTableOld     = 0;
+    pMan->nTableSize   *= 2;
+    pMan->pTable        = ABC_CALLOC( Abc_AigEnt_t, pMan->nTableSize );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Rehashes the AIG nodes after their IDs have changed.]
+
   Description []
                
   SideEffects []
@@ -696,41 +816,66 @@ clk = Abc_Clock();
 ***********************************************************************/
 void Abc_AigRehash( Abc_Aig_t * pMan )
 {
-    Abc_Obj_t ** pBinsNew;
-    Abc_Obj_t * pEnt, * pEnt2;
+    Abc_Obj_t * pEnt;
     int * pArray;
-    unsigned Key;
     int Counter, Temp, i;
-
-    // allocate a new array
-    pBinsNew = ABC_ALLOC( Abc_Obj_t *, pMan->nBins );
-    memset( pBinsNew, 0, sizeof(Abc_Obj_t *) * pMan->nBins );
-    // rehash the entries from the old table
+    // collect the nodes
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+    Vec_PtrClear( pMan->vNodes );
+    Abc_AigTableForEachEntry( pMan, pEnt, i )
+        Vec_PtrPush( pMan->vNodes, pEnt );
+    assert( Vec_PtrSize(pMan->vNodes) == pMan->nEntries );
+    // rehash the nodes
+    memset( pMan->pTable, 0, sizeof(Abc_AigEnt_t) * pMan->nTableSize );
+    pMan->nEntries = 0;
     Counter = 0;
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntrySafe( pMan->pBins[i], pEnt, pEnt2 )
+    Vec_PtrForEachEntry( Abc_Obj_t *, pMan->vNodes, pEnt, i )
+    {
+        // swap the fanins if needed
+        pArray = pEnt->vFanins.pArray;
+        if ( pArray[0] > pArray[1] )
         {
-            // swap the fanins if needed
-            pArray = pEnt->vFanins.pArray;
-            if ( pArray[0] > pArray[1] )
-            {
-                Temp = pArray[0];
-                pArray[0] = pArray[1];
-                pArray[1] = Temp;
-                Temp = pEnt->fCompl0;
-                pEnt->fCompl0 = pEnt->fCompl1;
-                pEnt->fCompl1 = Temp;
-            }
-            // rehash the node
-            Key = Abc_HashKey2( Abc_ObjChild0(pEnt), Abc_ObjChild1(pEnt), pMan->nBins );
-            pEnt->pNext   = pBinsNew[Key];
-            pBinsNew[Key] = pEnt;
-            Counter++;
+            Temp = pArray[0];
+            pArray[0] = pArray[1];
+            pArray[1] = Temp;
+            Temp = pEnt->fCompl0;
+            pEnt->fCompl0 = pEnt->fCompl1;
+            pEnt->fCompl1 = Temp;
         }
+        // rehash the node
+        Abc_AigTableInsert( pMan, pEnt );
+        Counter++;
+    }
     assert( Counter == pMan->nEntries );
-    // replace the table and the parameters
-    ABC_FREE( pMan->pBins );
-    pMan->pBins = pBinsNew;
+    Vec_PtrClear( pMan->vNodes );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Updates the manager after the objects are renumbered.]
+
+  Description [vMap maps the old IDs into the new ones (-1 for the deleted
+  objects). The fanins of the nodes should be already renumbered.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigRemapIds( Abc_Aig_t * pMan, Vec_Int_t * vMap )
+{
+    int i, Id, k = 0, nObjs = Vec_PtrSize(pMan->pNtkAig->vObjs);
+    // the deferred reverse level updates of the deleted nodes are dropped
+    Vec_IntForEachEntry( pMan->vLevelsRDefer, Id, i )
+        if ( Id < Vec_IntSize(vMap) && Vec_IntEntry(vMap, Id) >= 0 )
+            Vec_IntWriteEntry( pMan->vLevelsRDefer, k++, Vec_IntEntry(vMap, Id) );
+    Vec_IntShrink( pMan->vLevelsRDefer, k );
+    // the pending nodes are moved with their new IDs (the IDs only decrease)
+    for ( Id = 0; Id < Vec_BitSize(pMan->vLevelsDirty) && Id < Vec_IntSize(vMap); Id++ )
+        if ( Vec_IntEntry(vMap, Id) >= 0 )
+            Vec_BitWriteEntry( pMan->vLevelsDirty, Vec_IntEntry(vMap, Id), Vec_BitEntry(pMan->vLevelsDirty, Id) );
+    Vec_BitShrink( pMan->vLevelsDirty, Abc_MinInt(Vec_BitSize(pMan->vLevelsDirty), nObjs) );
+    Abc_AigRehash( pMan );
 }
 
 
@@ -945,7 +1090,7 @@ int Abc_AigReplace( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, int fU
         Abc_AigReplace_int( pMan, pOld, pNew, fUpdateLevel );
     }
     if (num_updates > 1) printf("##num updates %d node (%d)\n", num_updates, Abc_ObjId(pOld));
-    abctime clk = Abc_Clock();
+    abctime clk = Util_StatClock();
     if ( fUpdateLevel )
     {
         Abc_AigUpdateLevel_int( pMan );
@@ -954,8 +1099,7 @@ int Abc_AigReplace( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, int fU
             // Abc_AigUpdateLevelR_new( pMan, pOld );
             Abc_AigUpdateLevelR_int( pMan );
     } 
-    
-        global_update_time += Abc_Clock() - clk;
+    Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
     return 1;
 }
 
@@ -981,10 +1125,10 @@ int Abc_AigCleanupInc( Abc_Aig_t * pMan )
     nNodesOld = pMan->nEntries;
     // collect the AND nodes that do not fanout
     vDangles = Vec_PtrAlloc( 100 );
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntry( pMan->pBins[i], pAnd )
-            if ( Abc_ObjFanoutNum(pAnd) == 0 )
-                Vec_PtrPush( vDangles, pAnd );
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+    Abc_AigTableForEachEntry( pMan, pAnd, i )
+        if ( Abc_ObjFanoutNum(pAnd) == 0 )
+            Vec_PtrPush( vDangles, pAnd );
     // process the dangling nodes and their MFFCs
     Vec_PtrForEachEntry( Abc_Obj_t *, vDangles, pAnd, i )
         Abc_AigDeleteNodeInc( pMan, pAnd );
@@ -993,6 +1137,64 @@ int Abc_AigCleanupInc( Abc_Aig_t * pMan )
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Compacts the fanout arrays of the other fanins of the rewired fanouts.]
+
+  Description [When a fanout of the old node is rewired, it is appended
+  to the fanout array of its other fanin without removing its previous
+  entry there. For each such fanin, the earlier entries are dropped in one
+  backward pass, which leaves the array in the same order as removing
+  them one by one would.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigCompactFanoutsLazy( Abc_Aig_t * pMan )
+{
+    Vec_Wrd_t * vPairs = pMan->vFanoutsLazy;
+    Vec_Int_t * vFanouts;
+    int i, k, iBeg, iEnd, iLo, iHi, iMid, iFanin, Id;
+    if ( Vec_WrdSize(vPairs) == 0 )
+        return;
+    Vec_WrdSort( vPairs, 0 );
+    for ( iBeg = 0; iBeg < Vec_WrdSize(vPairs); iBeg = iEnd )
+    {
+        // collect the rewired fanouts of this fanin (sorted by ID)
+        iFanin = (int)(Vec_WrdEntry(vPairs, iBeg) >> 32);
+        for ( iEnd = iBeg + 1; iEnd < Vec_WrdSize(vPairs); iEnd++ )
+            if ( (int)(Vec_WrdEntry(vPairs, iEnd) >> 32) != iFanin )
+                break;
+        Vec_IntFill( pMan->vFanoutsSeen, iEnd - iBeg, 0 );
+        // keep the last entry of each rewired fanout
+        vFanouts = &Abc_NtkObj(pMan->pNtkAig, iFanin)->vFanouts;
+        for ( i = k = vFanouts->nSize - 1; i >= 0; i-- )
+        {
+            Id = vFanouts->pArray[i];
+            for ( iLo = iBeg, iHi = iEnd; iLo < iHi; )
+            {
+                iMid = (iLo + iHi) / 2;
+                if ( (int)(unsigned)Vec_WrdEntry(vPairs, iMid) < Id )
+                    iLo = iMid + 1;
+                else
+                    iHi = iMid;
+            }
+            if ( iLo < iEnd && (int)(unsigned)Vec_WrdEntry(vPairs, iLo) == Id )
+            {
+                if ( Vec_IntEntry(pMan->vFanoutsSeen, iLo - iBeg) )
+                    continue;
+                Vec_IntWriteEntry( pMan->vFanoutsSeen, iLo - iBeg, 1 );
+            }
+            vFanouts->pArray[k--] = Id;
+        }
+        memmove( vFanouts->pArray, vFanouts->pArray + k + 1, sizeof(int) * (vFanouts->nSize - k - 1) );
+        vFanouts->nSize -= k + 1;
+    }
+    Vec_WrdClear( vPairs );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs internal replacement step.]
@@ -1012,6 +1214,9 @@ void Abc_AigReplace_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, i
     // (the new node can be complemented and can have fanouts)
     assert( !Abc_ObjIsComplement(pOld) );
     assert( Abc_ObjFanoutNum(pOld) > 0 );
+    // the fanouts of both nodes are going to change
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, pOld->Id, Abc_ObjRegular(pNew)->Id );
     // look at the fanouts of old node
     Abc_NodeCollectFanouts( pOld, pMan->vNodes );
     Vec_PtrForEachEntry( Abc_Obj_t *, pMan->vNodes, pFanout, k )
@@ -1031,7 +1236,7 @@ void Abc_AigReplace_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, i
                     Vec_VecPush( pMan->vLevelsR, Abc_ObjReverseLevel(pFanin1), pFanin1 );
                 }
             }
-            Abc_ObjPatchFanin( pFanout, pOld, pNew );            
+            Abc_ObjPatchFaninLazy( pFanout, pOld, pNew );            
             continue;
         }
         // find the old node as a fanin of this fanout
@@ -1066,8 +1271,9 @@ void Abc_AigReplace_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, i
 
         // remove the old fanout node from the structural hashing table
         Abc_AigAndDelete( pMan, pFanout );
-        // remove the fanins of the old fanout
-        Abc_ObjRemoveFanins( pFanout );
+        // remove the fanins of the old fanout (their fanout arrays are compacted after the loop)
+        Abc_ObjRemoveFaninsLazy( pFanout );
+        Vec_WrdPush( pMan->vFanoutsLazy, ((word)Abc_ObjRegular(pFanin2)->Id << 32) | (word)pFanout->Id );
         // recreate the old fanout with new fanins and add it to the table
         Abc_AigAndCreateFrom( pMan, pFanin1, pFanin2, pFanout );
         assert( Abc_AigNodeIsAcyclic(pFanout, pFanout) );
@@ -1112,6 +1318,9 @@ void Abc_AigReplace_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, i
     //     }
 
 
+    // drop the rewired fanouts of the old node and of their other fanins in one pass
+    Abc_ObjCompactFanouts( pOld );
+    Abc_AigCompactFanoutsLazy( pMan );
     // if the node has no fanouts left, remove its MFFC
     if ( Abc_ObjFanoutNum(pOld) == 0 )
         Abc_AigDeleteNode( pMan, pOld );
@@ -1168,6 +1377,8 @@ void Abc_AigDeleteNode( Abc_Aig_t * pMan, Abc_Obj_t * pNode )
         Vec_PtrPushUnique( pMan->vUpdatedNets, pNode0 );
         Vec_PtrPushUnique( pMan->vUpdatedNets, pNode1 );
     }
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, pNode0->Id, pNode1->Id );
 
     // remove the node from the table
     Abc_AigAndDelete( pMan, pNode );
@@ -1320,20 +1531,36 @@ void Abc_AigUpdateLevelR_int( Abc_Aig_t * pMan )
 
 
 
+/**Function*************************************************************
+
+  Synopsis    [Flushes the deferred level updates when they may be needed.]
+
+  Description [The incremental replacements collect the nodes whose levels
+  are affected (qLevels) and the nodes whose reverse levels may decrease
+  (vLevelsRDefer) without processing them. The batch is flushed in one
+  level-ordered sweep when the candidate level exceeds the lowest level
+  touched since the last flush (the nodes at or below nLevelMin cannot be
+  in the TFO of a pending update), or unconditionally if finalUpdate is set.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
 void Abc_AigUpdateLevel_Trigger( Abc_Aig_t * pMan, int candidateLevel, int finalUpdate ){  
-    // if current level is larger or equal to the minimum level, perform batch update  
-    return; 
-    abctime clk = Abc_Clock();
-    if (candidateLevel > pMan->nLevelMin)
-        Abc_AigUpdateLevelInc_int( pMan );
-    // if flag is true, perform final update
-    if (finalUpdate)
-        Abc_AigUpdateLevelInc_int( pMan );
+    abctime clk;
+    // the candidate cannot depend on the pending updates
+    if ( !finalUpdate && candidateLevel <= pMan->nLevelMin )
+        return; 
+    clk = Util_StatClock();
+    Abc_AigUpdateLevelInc_int( pMan );
+    if ( pMan->pNtkAig->vLevelsR )
+        Abc_AigUpdateLevelRelaxR_int( pMan );
+    else
+        Vec_IntClear( pMan->vLevelsRDefer );
     // reset the minimum level
     pMan->nLevelMin = ABC_INFINITY;
-    global_update_time += Abc_Clock() - clk;
-
-    return; 
+    Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
 }
 
 
@@ -1355,9 +1582,9 @@ int Abc_AigUpdateLevel_rec(  Abc_Obj_t * pNode ){
     // mark the node as visited
     // Abc_NodeSetTravIdCurrent( pNode ); 
     pNode->Level = 0;
+    Util_StatAdd( UTIL_STAT_LEVEL_UPDATES, Abc_ObjFaninNum(pNode) );
     Abc_ObjForEachFanin( pNode, pNext, i )
     {
-        global_level_updates += 1;  
         // Level = Abc_AigUpdateLevel_rec( Abc_ObjFanin0Ntk(pNext) );  
         Level = Abc_AigUpdateLevel_rec( Abc_ObjRegular(pNext) );  
         if ( pNode->Level < (unsigned)Level )
@@ -1371,13 +1598,13 @@ int Abc_AigUpdateLevel_rec(  Abc_Obj_t * pNode ){
 void Abc_AigUpdateLevel_Lazy( Abc_Obj_t * pNode ){  
     // perform back dfs until the nodes are visited  
     // may introduce bug here 
-    abctime clk = Abc_Clock(); 
+    abctime clk = Util_StatClock(); 
     Abc_Obj_t * pFanin0, * pFanin1; 
     pFanin0 = Abc_ObjFanin0(pNode); 
     pFanin1 = Abc_ObjFanin1(pNode); 
     pNode -> Level = Abc_MaxInt(pFanin0->Level, pFanin1->Level) + 1; 
-    global_level_updates += 2; 
-    global_aig_update_time += Abc_Clock() - clk;
+    Util_StatAdd( UTIL_STAT_LEVEL_UPDATES, 2 ); 
+    Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
     return;  
     // Abc_AigUpdateLevel_rec( pNode );  
 }
@@ -1404,10 +1631,8 @@ int Abc_AigReplaceInc( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, int
     int num_updates = 0;
      
     if (fUpdateLevel) {
-        // clear the priority queue
-        P_QueClear(pMan->qLevels);
-        P_QueClear(pMan->qLevelsR);
-        
+        // the level queues are not cleared: they accumulate across replacements
+        // and are flushed by Abc_AigUpdateLevel_Trigger()
         assert(pMan->vTopoAff != NULL);
         Vec_PtrClear(pMan->vTopoAff);
         // // the first node is the order of pTo node, 
@@ -1433,16 +1658,20 @@ int Abc_AigReplaceInc( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew, int
         Abc_AigReplaceInc_int( pMan, pOld, pNew, fUpdateLevel ); 
 
     }
+    Util_StatAdd( UTIL_STAT_REPLACE_STEPS, num_updates );
      
     if ( fUpdateLevel )
     {
-        // using lazy updates to maintain the level structure  (batch updates) 
-        abctime clk = Abc_Clock();
-        // Abc_AigUpdateLevelInc_int( pMan ); 
+        Util_StatAdd( UTIL_STAT_REPLACE_TFO, Vec_PtrSize(pMan->vTopoAff) );
+        // tighten the reverse levels right away (required by the level constraint), 
+        // while their relaxations and the forward levels are updated in batches
+        abctime clk = Util_StatClock();
         if ( pMan->pNtkAig->vLevelsR )  
-            Abc_AigUpdateLevelIncR_int( pMan ); 
-        global_aig_update_time  += Abc_Clock() - clk;
-        
+            Abc_AigUpdateLevelIncR_int( pMan, 1 ); 
+        Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
+        // unless the caller flushes the batch, update the levels right away
+        if ( !pMan->fDeferLevels )
+            Abc_AigUpdateLevel_Trigger( pMan, 0, 1 );
     }   
     return 1;
 }
@@ -1457,9 +1686,8 @@ int Abc_AigReplaceIncLevelUpdate( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t
     int num_updates = 0;
      
     if (fUpdateLevel) {
-        // clear the priority queue
-        P_QueClear(pMan->qLevels);
-        P_QueClear(pMan->qLevelsR);
+        // finish the updates batched by the previous replacements
+        Abc_AigUpdateLevel_Trigger( pMan, 0, 1 );
         
         assert(pMan->vTopoAff != NULL);
         Vec_PtrClear(pMan->vTopoAff);
@@ -1488,11 +1716,11 @@ int Abc_AigReplaceIncLevelUpdate( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t
      
     if ( fUpdateLevel )
     {
-        abctime clk = Abc_Clock();
+        abctime clk = Util_StatClock();
         Abc_AigUpdateLevelInc_int( pMan ); 
         if ( pMan->pNtkAig->vLevelsR )  
-            Abc_AigUpdateLevelIncR_int( pMan ); 
-        global_aig_update_time  += Abc_Clock() - clk;
+            Abc_AigUpdateLevelRelaxR_int( pMan ); 
+        Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
         
     }   
     return 1;
@@ -1512,11 +1740,11 @@ int Abc_AigReplaceIncLevelUpdate( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t
   SeeAlso     []
 ***********************************************************************/
 int Abc_AigReplaceUpdateAff( Abc_Aig_t * pMan ){ 
-    abctime clk = Abc_Clock(); 
+    abctime clk = Util_StatClock(); 
     Abc_Obj_t * pNode;
     List_Ptr_Node_t * oNodeFirst, * newOrder;
     List_Ptr_t * oList = Abc_AigGetOList(pMan);
-    int i; 
+    int i, nReordered = 0; 
 
     // verify input parameters
     if ( pMan == NULL || oList == NULL )
@@ -1531,24 +1759,24 @@ int Abc_AigReplaceUpdateAff( Abc_Aig_t * pMan ){
           
         // clean the mark
         pNode ->fMarkC = 0;
-        if (pNode -> fHandled ) continue; 
+        if (Abc_ObjIsHandled(pNode) ) continue; 
+        // the node is already ordered before the current iterator
+        if ( Abc_AigNodeIsOrdered(pMan, pNode) ) continue; 
   
-        // insert the newly created nodes into oList
-        // // skip the nodes that are not in the old order
-        // if (pNode -> oLNode == NULL)
-        //     continue;  
-
-        // create new order for the nodes in AFF
-        newOrder = List_PtrInsertAfter(oList, oNodeFirst, pNode); 
+        // the newly created nodes are inserted into oList,
+        // the old nodes are spliced without reallocating their entries
+        if ( pNode->oLNode == NULL )
+            newOrder = List_PtrInsertAfter(oList, oNodeFirst, pNode); 
+        else
+            newOrder = List_PtrMoveAfter(oList, oNodeFirst, pNode->oLNode); 
         assert(newOrder != NULL);
-        // remove the node from the old order
-        List_PtrRemoveNode(oList, pNode->oLNode);
         // update the node's order
         pNode->oLNode = newOrder;
         oNodeFirst = newOrder; 
-        global_reorder_nodes++;
+        nReordered++;
     } 
-    global_aig_update_time += Abc_Clock() - clk; 
+    Util_StatAdd( UTIL_STAT_REORDER_NODES, nReordered );
+    Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk ); 
     // free the nodes in vAffTmp
     Vec_PtrErase(pMan->vTopoAff);
     return 1; 
@@ -1573,9 +1801,13 @@ void Abc_AigReplaceFindAff( Abc_Aig_t * pMan, Abc_Obj_t * pFrom ){
     assert(pFrom != NULL);
     if (Abc_ObjIsCi(pFrom) || Abc_AigNodeIsConst(pFrom)) 
         return; 
-    if (pFrom -> fHandled)
+    // the order list is not being traversed
+    if (pMan->oList->pCurItera == NULL)
+        return; 
+    if (Abc_ObjIsHandled(pFrom))
         return; 
-    if (pFrom == (Abc_Obj_t *) pMan ->oList->pCurItera->pData )
+    // the node (and hence its TFI) is already ordered before the current iterator
+    if ( Abc_AigNodeIsOrdered(pMan, pFrom) )
         return; 
  
     Abc_AigReplaceFindAff_rec( pMan, pFrom); 
@@ -1591,12 +1823,12 @@ void  Abc_AigReplaceFindAff_rec( Abc_Aig_t * pMan, Abc_Obj_t * pFrom ){
     Abc_ObjForEachFanin( pFrom, pFanin, i ){
         if (Abc_ObjIsCi(pFanin) || Abc_AigNodeIsConst(pFanin) )
                 continue; 
-        if (pFanin -> fHandled)
+        if (Abc_ObjIsHandled(pFanin))
             continue;   
         if (pFanin -> fMarkC)
             continue;
-        // skip the current iterator node 
-        if (pFanin == (Abc_Obj_t *) pMan ->oList->pCurItera->pData )
+        // stop at the nodes ordered at or before the current iterator
+        if ( Abc_AigNodeIsOrdered(pMan, pFanin) )
             continue; 
         pFanin->fMarkC = 1; 
         Abc_AigReplaceFindAff_rec( pMan, pFanin ); 
@@ -1612,7 +1844,7 @@ void  Abc_AigReplaceFindAff_rec( Abc_Aig_t * pMan, Abc_Obj_t * pFrom ){
 
   Synopsis    [Performs internal replacement step, with priority queue to update the level]
 
-  Description [ 1. fMarkA is used to mark the node to be updated in the level structure, 
+  Description [ 1. vLevelsDirty marks the nodes to be updated in the level structure, 
                 2. fMarkB is used to mark the node to be updated in the reverse level structure]
                
   SideEffects []
@@ -1631,6 +1863,9 @@ void Abc_AigReplaceInc_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew
     // (the new node can be complemented and can have fanouts)
     assert( !Abc_ObjIsComplement(pOld) );
     assert( Abc_ObjFanoutNum(pOld) > 0 );
+    // the fanouts of both nodes are going to change
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, pOld->Id, Abc_ObjRegular(pNew)->Id );
     // look at the fanouts of old node
     Abc_NodeCollectFanouts( pOld, pMan->vNodes );
     Vec_PtrForEachEntry( Abc_Obj_t *, pMan->vNodes, pFanout, k )
@@ -1649,10 +1884,10 @@ void Abc_AigReplaceInc_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew
                 if ( !Abc_ObjIsCi(pFanin1) )
                 {
                     pFanin1->fMarkB = 1; 
-                    P_QuePush(pMan->qLevelsR, pFanin1, 1.0 * Abc_ObjReverseLevel(pFanin1)); 
+                    B_QuePush(pMan->qLevelsR, pFanin1, Abc_ObjReverseLevel(pFanin1)); 
                 }
             }
-            Abc_ObjPatchFanin( pFanout, pOld, pNew );            
+            Abc_ObjPatchFaninLazy( pFanout, pOld, pNew );            
             continue;  
         }
         // find the old node as a fanin of this fanout
@@ -1677,9 +1912,9 @@ void Abc_AigReplaceInc_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew
         assert( Abc_ObjRegular(pFanin1) != Abc_ObjRegular(pFanin2) );             
         
         if (isFirst && fUpdateLevel) {
-            abctime clk = Abc_Clock();
+            abctime clk = Util_StatClock();
             Abc_AigReplaceFindAff( pMan, Abc_ObjRegular(pNew)); 
-            global_aig_update_time += Abc_Clock() - clk;
+            Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
             // // print the affected nodes
             // Abc_Obj_t * pNodeTmp;
             // int i = 0; 
@@ -1693,8 +1928,9 @@ void Abc_AigReplaceInc_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew
  
         // remove the old fanout node from the structural hashing table
         Abc_AigAndDelete( pMan, pFanout );
-        // remove the fanins of the old fanout
-        Abc_ObjRemoveFanins( pFanout );
+        // remove the fanins of the old fanout (their fanout arrays are compacted after the loop)
+        Abc_ObjRemoveFaninsLazy( pFanout );
+        Vec_WrdPush( pMan->vFanoutsLazy, ((word)Abc_ObjRegular(pFanin2)->Id << 32) | (word)pFanout->Id );
         // recreate the old fanout with new fanins and add it to the table
         Abc_AigAndCreateFrom( pMan, pFanin1, pFanin2, pFanout );
 
@@ -1703,15 +1939,16 @@ void Abc_AigReplaceInc_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew
 
         if ( fUpdateLevel )
         {
-            // if (pFanout->fMarkA == 0){
-            //     pFanout->fMarkA = 1;
-            //     P_QuePush(pMan->qLevels, pFanout, 1.0 * pFanout->Level); 
-            // }   
+            // the fanout is dirty, its TFO levels are fixed by the next batch flush
+            if ( !Abc_AigNodeIsDirty(pMan, pFanout) ){
+                Abc_AigNodeSetDirty( pMan, pFanout, 1 );
+                B_QuePush(pMan->qLevels, pFanout, pFanout->Level); 
+            }   
 
             if (pMan->pNtkAig->vLevelsR){
                 if (pFanout->fMarkB == 0){   // && pFanout->fUpdated == 0
                     pFanout->fMarkB = 1;
-                    P_QuePush(pMan->qLevelsR, pFanout, 1.0 * Abc_ObjReverseLevel(pFanout)); 
+                    B_QuePush(pMan->qLevelsR, pFanout, Abc_ObjReverseLevel(pFanout)); 
                 }
             } 
         }
@@ -1721,16 +1958,20 @@ void Abc_AigReplaceInc_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_Obj_t * pNew
             if ( Abc_AigNodeIsAnd(pFanoutFanout) )
                 pFanoutFanout->fExor = Abc_NodeIsExorType(pFanoutFanout);
     }  
+    // drop the rewired fanouts of the old node and of their other fanins in one pass
+    Abc_ObjCompactFanouts( pOld );
+    Abc_AigCompactFanoutsLazy( pMan );
     // if the node has no fanouts left, remove its MFFC
     if ( Abc_ObjFanoutNum(pOld) == 0 )
         Abc_AigDeleteNodeInc( pMan, pOld );     
     // clear the candidate for reverse level maintanance
     if (!fUpdateLevel) { 
         Abc_Obj_t * pNodeTmp;
-        while (P_QueSize(pMan->qLevelsR) > 0){
-            pNodeTmp = (Abc_Obj_t *)P_QuePop(pMan->qLevelsR);
+        while (B_QueSize(pMan->qLevelsR) > 0){
+            pNodeTmp = (Abc_Obj_t *)B_QuePopMin(pMan->qLevelsR);
             pNodeTmp->fMarkB = 0;
         }
+        Vec_IntClear( pMan->vLevelsRDefer );
     }
 } 
 
@@ -1745,6 +1986,9 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
     // (the new node can be complemented and can have fanouts)
     assert( !Abc_ObjIsComplement(pOld) );
     assert( Abc_ObjFanoutNum(pOld) > 0 );
+    // the fanouts of both nodes are going to change
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, pOld->Id, Abc_ObjRegular(pNew)->Id );
     // look at the fanouts of old node
     Abc_NodeCollectFanouts( pOld, pMan->vNodes );
     Vec_PtrForEachEntry( Abc_Obj_t *, pMan->vNodes, pFanout, k )
@@ -1763,10 +2007,10 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
                 if ( !Abc_ObjIsCi(pFanin1) )
                 {
                     pFanin1->fMarkB = 1; 
-                    P_QuePush(pMan->qLevelsR, pFanin1, 1.0 * Abc_ObjReverseLevel(pFanin1)); 
+                    B_QuePush(pMan->qLevelsR, pFanin1, Abc_ObjReverseLevel(pFanin1)); 
                 }
             }
-            Abc_ObjPatchFanin( pFanout, pOld, pNew );            
+            Abc_ObjPatchFaninLazy( pFanout, pOld, pNew );            
             continue;  
         }
         // find the old node as a fanin of this fanout
@@ -1791,9 +2035,9 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
         assert( Abc_ObjRegular(pFanin1) != Abc_ObjRegular(pFanin2) );             
         
         if (isFirst && fUpdateLevel) {
-            abctime clk = Abc_Clock();
+            abctime clk = Util_StatClock();
             Abc_AigReplaceFindAff( pMan, Abc_ObjRegular(pNew)); 
-            global_aig_update_time += Abc_Clock() - clk;
+            Util_StatAddTime( UTIL_STAT_AIG_UPDATE_TIME, clk );
             // // print the affected nodes
             // Abc_Obj_t * pNodeTmp;
             // int i = 0; 
@@ -1807,8 +2051,9 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
  
         // remove the old fanout node from the structural hashing table
         Abc_AigAndDelete( pMan, pFanout );
-        // remove the fanins of the old fanout
-        Abc_ObjRemoveFanins( pFanout );
+        // remove the fanins of the old fanout (their fanout arrays are compacted after the loop)
+        Abc_ObjRemoveFaninsLazy( pFanout );
+        Vec_WrdPush( pMan->vFanoutsLazy, ((word)Abc_ObjRegular(pFanin2)->Id << 32) | (word)pFanout->Id );
         // recreate the old fanout with new fanins and add it to the table
         Abc_AigAndCreateFrom( pMan, pFanin1, pFanin2, pFanout );
 
@@ -1817,15 +2062,15 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
 
         if ( fUpdateLevel )
         {
-            if (pFanout->fMarkA == 0){
-                pFanout->fMarkA = 1;
-                P_QuePush(pMan->qLevels, pFanout, 1.0 * pFanout->Level); 
+            if ( !Abc_AigNodeIsDirty(pMan, pFanout) ){
+                Abc_AigNodeSetDirty( pMan, pFanout, 1 );
+                B_QuePush(pMan->qLevels, pFanout, pFanout->Level); 
             }   
 
             if (pMan->pNtkAig->vLevelsR){
                 if (pFanout->fMarkB == 0){   // && pFanout->fUpdated == 0
                     pFanout->fMarkB = 1;
-                    P_QuePush(pMan->qLevelsR, pFanout, 1.0 * Abc_ObjReverseLevel(pFanout)); 
+                    B_QuePush(pMan->qLevelsR, pFanout, Abc_ObjReverseLevel(pFanout)); 
                 }
             } 
         }
@@ -1835,16 +2080,20 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
             if ( Abc_AigNodeIsAnd(pFanoutFanout) )
                 pFanoutFanout->fExor = Abc_NodeIsExorType(pFanoutFanout);
     }  
+    // drop the rewired fanouts of the old node and of their other fanins in one pass
+    Abc_ObjCompactFanouts( pOld );
+    Abc_AigCompactFanoutsLazy( pMan );
     // if the node has no fanouts left, remove its MFFC
     if ( Abc_ObjFanoutNum(pOld) == 0 )
         Abc_AigDeleteNodeInc( pMan, pOld );     
     // clear the candidate for reverse level maintanance
     if (!fUpdateLevel) { 
         Abc_Obj_t * pNodeTmp;
-        while (P_QueSize(pMan->qLevelsR) > 0){
-            pNodeTmp = (Abc_Obj_t *)P_QuePop(pMan->qLevelsR);
+        while (B_QueSize(pMan->qLevelsR) > 0){
+            pNodeTmp = (Abc_Obj_t *)B_QuePopMin(pMan->qLevelsR);
             pNodeTmp->fMarkB = 0;
         }
+        Vec_IntClear( pMan->vLevelsRDefer );
     }
 }
 
@@ -1861,17 +2110,17 @@ void Abc_AigReplaceIncLevelUpdate_int( Abc_Aig_t * pMan, Abc_Obj_t * pOld, Abc_O
 void Abc_AigUpdateLevelInc_int( Abc_Aig_t * pMan )
 {
     Abc_Obj_t * pNode, * pFanout;
-    int LevelNew, v;
+    int LevelNew, v, nUpdates = 0;
 
     // using priority queue to update the level
-    while (P_QueSize(pMan->qLevels) > 0){
-        pNode = P_QuePop(pMan->qLevels); 
-        global_level_updates++;
+    while (B_QueSize(pMan->qLevels) > 0){
+        pNode = B_QuePopMin(pMan->qLevels); 
+        nUpdates++;
         // we do not remove the pNode from pMan->vQueue in Abc_AigDeleteNodeInc
-        // so we need first to check pNode->fMarkA rather than assert pNode == NULL
-        if (pNode->fMarkA == 0) continue;
+        // so we need first to check the dirty mark rather than assert pNode == NULL
+        if ( !Abc_AigNodeIsDirty(pMan, pNode) ) continue;
         // reset pNode umark, as it has removed from the queue
-        pNode->fMarkA = 0;
+        Abc_AigNodeSetDirty( pMan, pNode, 0 );
 
         if (pNode == NULL) continue;
         assert( Abc_ObjIsNode(pNode) );
@@ -1893,26 +2142,25 @@ void Abc_AigUpdateLevelInc_int( Abc_Aig_t * pMan )
             // update the fanout level
             pFanout->Level = LevelNew;   
             // push the fanout to the queue
-            // if (pFanout->fMarkA == 0 && (pFanout->oLNode == NULL || pFanout->fHandled == 1)){
-            if (pFanout->fMarkA == 0){
-                pFanout->fMarkA = 1;
-                P_QuePush(pMan->qLevels, pFanout, 1.0 * pFanout->Level); 
+            if ( !Abc_AigNodeIsDirty(pMan, pFanout) ){
+                Abc_AigNodeSetDirty( pMan, pFanout, 1 );
+                B_QuePush(pMan->qLevels, pFanout, pFanout->Level); 
             }  
         }
     }
- 
+    Util_StatAdd( UTIL_STAT_LEVEL_UPDATES, nUpdates );
 }
  
 
-void Abc_AigUpdateLevelIncR_int( Abc_Aig_t * pMan )
+void Abc_AigUpdateLevelIncR_int( Abc_Aig_t * pMan, int fDefer )
 {
     Abc_Obj_t * pNode, * pFanin, * pFanout;
-    int LevelNew, j, v;
+    int LevelNew, j, v, nUpdates = 0;
 
     // using priority queue to update the level
-    while (P_QueSize(pMan->qLevelsR) > 0){
-        pNode = (Abc_Obj_t *)P_QuePop(pMan->qLevelsR);
-        global_reverse_updates++;
+    while (B_QueSize(pMan->qLevelsR) > 0){
+        pNode = (Abc_Obj_t *)B_QuePopMin(pMan->qLevelsR);
+        nUpdates++;
         if (pNode->fMarkB == 0) continue;
         pNode->fMarkB = 0;
         if (pNode == NULL) continue;
@@ -1923,7 +2171,7 @@ void Abc_AigUpdateLevelIncR_int( Abc_Aig_t * pMan )
             if ( Abc_ObjIsCi(pFanin) || Abc_AigNodeIsConst(pFanin) )
                 continue;
 
-            if (pFanin->fHandled) // 
+            if (Abc_ObjIsHandled(pFanin)) // 
                 continue;
 
             // get the new reverse level of this fanin
@@ -1936,29 +2184,101 @@ void Abc_AigUpdateLevelIncR_int( Abc_Aig_t * pMan )
            
             if (  Abc_ObjReverseLevel(pFanin) == LevelNew  ) // no change
                 continue;
+            // keeping a larger reverse level is conservative, postpone the relaxation
+            if ( fDefer && LevelNew < Abc_ObjReverseLevel(pFanin) )
+            {
+                Vec_IntPush( pMan->vLevelsRDefer, Abc_ObjId(pFanin) );
+                continue;
+            }
             // update the reverse level
             Abc_ObjSetReverseLevel( pFanin, LevelNew );
             // push the fanin to the queue
             if (pFanin->fMarkB == 0){
                 pFanin->fMarkB = 1;
-                P_QuePush(pMan->qLevelsR, pFanin, 1.0 * pFanin->Level); 
+                B_QuePush(pMan->qLevelsR, pFanin, LevelNew); 
             }   
         }
     } 
+    Util_StatAdd( UTIL_STAT_REVERSE_UPDATES, nUpdates );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Relaxes the reverse levels postponed by the incremental updates.]
+
+  Description [The deferred nodes are recomputed from their fanouts and
+  the decreased reverse levels are propagated to the TFI in one sweep.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigUpdateLevelRelaxR_int( Abc_Aig_t * pMan )
+{
+    Abc_Obj_t * pNode;
+    int i, Id, LevelNew;
+    Vec_IntForEachEntry( pMan->vLevelsRDefer, Id, i )
+    {
+        // the node may have been deleted after it was deferred
+        pNode = Abc_NtkObj( pMan->pNtkAig, Id );
+        if ( pNode == NULL || !Abc_ObjIsNode(pNode) || Abc_ObjIsHandled(pNode) || pNode->fMarkB )
+            continue;
+        LevelNew = Abc_ObjReverseLevelNew( pNode );
+        if ( Abc_ObjReverseLevel(pNode) == LevelNew )
+            continue;
+        Abc_ObjSetReverseLevel( pNode, LevelNew );
+        pNode->fMarkB = 1;
+        B_QuePush(pMan->qLevelsR, pNode, LevelNew);
+    }
+    Vec_IntClear( pMan->vLevelsRDefer );
+    Abc_AigUpdateLevelIncR_int( pMan, 0 );
 }
 
    
+/**Function*************************************************************
 
+  Synopsis    [Deletes the dangling node and its MFFC.]
+
+  Description [The deleted nodes are not removed from the fanout arrays
+  of their fanins one by one. Instead, the number of deleted fanouts is
+  counted for each fanin, and each fanin is compacted once at the end.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
 void Abc_AigDeleteNodeInc( Abc_Aig_t * pMan, Abc_Obj_t * pNode )
+{
+    Abc_Obj_t * pFanin;
+    int i, Id;
+    Abc_AigDeleteNodeInc_rec( pMan, pNode );
+    Vec_IntForEachEntry( pMan->vFaninsDead, Id, i )
+    {
+        Vec_IntWriteEntry( pMan->vFanoutsDead, Id, 0 );
+        if ( (pFanin = Abc_NtkObj(pMan->pNtkAig, Id)) )
+            Abc_ObjCompactFanouts( pFanin );
+    }
+    Vec_IntClear( pMan->vFaninsDead );
+}
+
+// returns the number of fanouts of the node that are not lazily deleted
+static inline int Abc_AigFanoutNumLive( Abc_Aig_t * pMan, Abc_Obj_t * pObj ) 
+{
+    return Abc_ObjFanoutNum(pObj) - Vec_IntGetEntry( pMan->vFanoutsDead, pObj->Id );
+}
+
+void Abc_AigDeleteNodeInc_rec( Abc_Aig_t * pMan, Abc_Obj_t * pNode )
 {
     Abc_Obj_t * pNode0, * pNode1, * pTemp;
-    int i, k;
+    int i, k, * pDead;
 
     // make sure the node is regular and dangling
     assert( !Abc_ObjIsComplement(pNode) );
     assert( Abc_ObjIsNode(pNode) );
     assert( Abc_ObjFaninNum(pNode) == 2 );
-    assert( Abc_ObjFanoutNum(pNode) == 0 );
+    assert( Abc_AigFanoutNumLive(pMan, pNode) == 0 );
 
     // when deleting an old node that is scheduled for replacement, remove it from the replacement queue
     Vec_PtrForEachEntry( Abc_Obj_t *, pMan->vStackReplaceOld, pTemp, i )
@@ -1989,60 +2309,80 @@ void Abc_AigDeleteNodeInc( Abc_Aig_t * pMan, Abc_Obj_t * pNode )
         Vec_PtrPushUnique( pMan->vUpdatedNets, pNode0 );
         Vec_PtrPushUnique( pMan->vUpdatedNets, pNode1 );
     }
+    if ( pMan->vTouched )
+        Vec_IntPushTwo( pMan->vTouched, pNode0->Id, pNode1->Id );
+    if ( pMan->vDeleted )
+        Vec_IntPush( pMan->vDeleted, pNode->Id );
      
-    // duplicate the list node, with null pData. 
+    // remove the node from the order list
     // pMan ->oList != NULL   :  when delete the node in fUpdateLevel mode
     // pNode ->oLNode != NULL :  to skip the new created node 
-    // we should redirect the current oLNode iterator
+    // the entry of the current iterator is kept with null pData, so that 
+    // the traversal can continue from it (such entries are removed by List_PtrCompact)
     if (pMan ->oList != NULL && pNode ->oLNode != NULL) {
-        List_Ptr_Node_t * tmp = List_PtrDupNodeEmpty (pMan->oList, pNode->oLNode);
-        // current iteraotr is deleted. 
-        if (pNode ->oLNode == pMan->oList->pCurItera) {
-            pMan->oList->pCurItera = tmp; 
-        } 
+        if (pNode ->oLNode == pMan->oList->pCurItera)
+            pNode->oLNode->pData = NULL; 
+        else
+            List_PtrRemoveNode( pMan->oList, pNode->oLNode );
+        pNode->oLNode = NULL;
     }        
  
     
+    // the remaining fanout entries of the node belong to the deleted nodes
+    Vec_IntClear( &pNode->vFanouts );
     // then remove the node from the table
     Abc_AigAndDelete( pMan, pNode );
     // if the node is in the level structure, remove it
     // Note: different from Abc_AigUpdateLevel_int, we only mark the node as unmarked when the node is deleted  
     //       because we do not remove the node from pMan->vQueue in Abc_AigDeleteNodeInc
-    if ( pNode->fMarkA )
-        pNode->fMarkA = 0; 
+    if ( Abc_AigNodeIsDirty(pMan, pNode) )
+        Abc_AigNodeSetDirty( pMan, pNode, 0 ); 
     if ( pNode->fMarkB )
         pNode->fMarkB = 0;
         
+    // detach the node from its fanins (their fanout arrays are compacted later)
+    Abc_ObjForEachFanin( pNode, pTemp, i )
+    {
+        pDead = Vec_IntGetEntryP( pMan->vFanoutsDead, pTemp->Id );
+        if ( (*pDead)++ == 0 )
+            Vec_IntPush( pMan->vFaninsDead, pTemp->Id );
+    }
+    Abc_ObjRemoveFaninsLazy( pNode );
     // remove the node from the network
     Abc_NtkDeleteObj( pNode );
 
     
     // call recursively for the fanins
-    if ( Abc_ObjIsNode(pNode0) && pNode0->vFanouts.nSize == 0 ) {
-        Abc_AigDeleteNodeInc( pMan, pNode0 );
+    if ( Abc_ObjIsNode(pNode0) && Abc_AigFanoutNumLive(pMan, pNode0) == 0 ) {
+        Abc_AigDeleteNodeInc_rec( pMan, pNode0 );
     } else {
         // if the node is not handled and not in the queue, push it to the queue, reverse level maintanance
-        if (pNode0->fHandled == 0 && pNode0->fMarkB == 0 && Abc_ObjIsNode(pNode0)) {
+        if (pMan->pNtkAig->vLevelsR && Abc_ObjIsHandled(pNode0) == 0 && pNode0->fMarkB == 0 && Abc_ObjIsNode(pNode0)) {
             pNode0->fMarkB = 1;
-            P_QuePush(pMan->qLevelsR, pNode0, 1.0 * Abc_ObjReverseLevel(pNode0));
+            B_QuePush(pMan->qLevelsR, pNode0, Abc_ObjReverseLevel(pNode0));
         }
+        // the fanin has lost a fanout, its own reverse level may decrease
+        if ( pMan->pNtkAig->vLevelsR && Abc_ObjIsNode(pNode0) )
+            Vec_IntPush( pMan->vLevelsRDefer, Abc_ObjId(pNode0) );
     }
         
 
-    if ( Abc_ObjIsNode(pNode1) && pNode1->vFanouts.nSize == 0 ) {
-        Abc_AigDeleteNodeInc( pMan, pNode1 );
+    if ( Abc_ObjIsNode(pNode1) && Abc_AigFanoutNumLive(pMan, pNode1) == 0 ) {
+        Abc_AigDeleteNodeInc_rec( pMan, pNode1 );
     } else {
         // if the node is not handled and not in the queue, push it to the queue, reverse level maintanance
-        if (pNode1->fHandled == 0 && pNode1->fMarkB == 0 && Abc_ObjIsNode(pNode1)) {
+        if (pMan->pNtkAig->vLevelsR && Abc_ObjIsHandled(pNode1) == 0 && pNode1->fMarkB == 0 && Abc_ObjIsNode(pNode1)) {
             pNode1->fMarkB = 1;
-            P_QuePush(pMan->qLevelsR, pNode1, 1.0 * Abc_ObjReverseLevel(pNode1));
+            B_QuePush(pMan->qLevelsR, pNode1, Abc_ObjReverseLevel(pNode1));
         }
+        if ( pMan->pNtkAig->vLevelsR && Abc_ObjIsNode(pNode1) )
+            Vec_IntPush( pMan->vLevelsRDefer, Abc_ObjId(pNode1) );
     }
 
     
-    // if (pNode0->fHandled == 0 && pNode0->fMarkB == 0) {
+    // if (Abc_ObjIsHandled(pNode0) == 0 && pNode0->fMarkB == 0) {
     //         pNode0->fMarkB = 1;
-    //         P_QuePush(pMan->qLevelsR, pNode0, 1.0 * Abc_ObjReverseLevel(pNode0));
+    //         B_QuePush(pMan->qLevelsR, pNode0, Abc_ObjReverseLevel(pNode0));
     // }
 }
 
@@ -2326,16 +2666,16 @@ void Abc_AigCheckFaninOrder( Abc_Aig_t * pMan )
 {
     Abc_Obj_t * pEnt;
     int i;
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntry( pMan->pBins[i], pEnt )
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+    Abc_AigTableForEachEntry( pMan, pEnt, i )
+    {
+        if ( Abc_ObjRegular(Abc_ObjChild0(pEnt))->Id > Abc_ObjRegular(Abc_ObjChild1(pEnt))->Id )
         {
-            if ( Abc_ObjRegular(Abc_ObjChild0(pEnt))->Id > Abc_ObjRegular(Abc_ObjChild1(pEnt))->Id )
-            {
-//                int i0 = Abc_ObjRegular(Abc_ObjChild0(pEnt))->Id;
-//                int i1 = Abc_ObjRegular(Abc_ObjChild1(pEnt))->Id;
-                printf( "Node %d has incorrect ordering of fanins.\n", pEnt->Id );
-            }
+//            int i0 = Abc_ObjRegular(Abc_ObjChild0(pEnt))->Id;
+//            int i1 = Abc_ObjRegular(Abc_ObjChild1(pEnt))->Id;
+            printf( "Node %d has incorrect ordering of fanins.\n", pEnt->Id );
         }
+    }
 }
 
 /**Function*************************************************************
@@ -2427,6 +2767,63 @@ void Abc_AigUpdateReset( Abc_Aig_t * pMan )
     Vec_PtrClear( pMan->vUpdatedNets );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Sets the array to collect the nodes whose fanouts change.]
+
+  Description [The IDs of the nodes are added to the array, possibly
+  more than once, when the fanouts of the nodes are added or removed.
+  The array is owned by the caller. Collecting is stopped if it is NULL.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigSetTouched( Abc_Aig_t * pMan, Vec_Int_t * vTouched )
+{
+    pMan->vTouched = vTouched;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts or stops deferring the level updates.]
+
+  Description [While the updates are deferred, Abc_AigReplaceInc() only
+  collects the nodes whose levels are affected, and the caller flushes 
+  them with Abc_AigUpdateLevel_Trigger() before the levels are used. 
+  The pending updates are flushed when deferring is stopped.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigSetDeferLevels( Abc_Aig_t * pMan, int fDefer )
+{
+    if ( !fDefer )
+        Abc_AigUpdateLevel_Trigger( pMan, 0, 1 );
+    pMan->fDeferLevels = fDefer;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the array to collect the deleted nodes.]
+
+  Description [The IDs of the nodes deleted by Abc_AigDeleteNodeInc()
+  are added to the array before they are deleted. The array is owned
+  by the caller. Collecting is stopped if it is NULL.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_AigSetDeleted( Abc_Aig_t * pMan, Vec_Int_t * vDeleted )
+{
+    pMan->vDeleted = vDeleted;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Start the update list.]
@@ -2442,14 +2839,14 @@ int Abc_AigCountNext( Abc_Aig_t * pMan )
 {
     Abc_Obj_t * pAnd;
     int i, Counter = 0, CounterTotal = 0;
-    // count how many nodes have pNext set
-    for ( i = 0; i < pMan->nBins; i++ )
-        Abc_AigBinForEachEntry( pMan->pBins[i], pAnd )
-        {
-            Counter += (pAnd->pNext != NULL);
-            CounterTotal++;
-        }
-    printf( "Counter = %d.  Nodes = %d.  Ave = %6.2f\n", Counter, CounterTotal, 1.0 * CounterTotal/pMan->nBins );
+    // count how many nodes are not at their hash key
+    Abc_AigTableMigrate( pMan, ABC_INFINITY );
+    Abc_AigTableForEachEntry( pMan, pAnd, i )
+    {
+        Counter += ((int)Abc_HashKey2( pMan->pTable[i].iLit0, pMan->pTable[i].iLit1, pMan->nTableSize ) != i);
+        CounterTotal++;
+    }
+    printf( "Counter = %d.  Nodes = %d.  Ave = %6.2f\n", Counter, CounterTotal, 1.0 * CounterTotal/pMan->nTableSize );
     return Counter;
 }
 
@@ -1493,87 +1493,18 @@ int Abc_NtkLevel( Abc_Ntk_t * pNtk )
 
   Synopsis    [Computes the cirtical path of pagerank score for the given AIG.]
 
-  Description []
+  Description [The PageRank scores are computed by Abc_NtkPageRank()
+  using the given number of threads.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-float Abc_NtkPathRank( Abc_Ntk_t * pNtk ){
-    Abc_Obj_t * pNode, *pNext;
-    int i, j;
-   
-    // set for pagerank 
-    int num_iterations = 0;
-    int max_iterations = 100;
-    float convergence = 0.0001;
-    float damping_factor = 0.85;
-    float diff = 1.0;
-    float sum_pr = 0; 
-    float dangling_pr = 0; 
-    int num_nodes =  Abc_NtkObjNum(pNtk);
-    if ( num_nodes == 0 )
+float Abc_NtkPathRank( Abc_Ntk_t * pNtk, int nThreads ){
+    if ( Abc_NtkObjNum(pNtk) == 0 )
         return 0;
-
-    // init pagerank 
-    Abc_NtkForEachObj( pNtk, pNode, i ){
-        pNode->pr = 1.0 / (num_nodes*1.0);
-        pNode->ppr = 1.0 / (num_nodes*1.0);
-        // Abc_ObjSetPR(pNode, 1.0 / (num_nodes*1.0));
-        // Abc_ObjSetPPR(pNode, 1.0 / (num_nodes*1.0));
-    }
-
-    while (diff > convergence && num_iterations < max_iterations) {
-        sum_pr = 0;
-        dangling_pr = 0;
-
-        // compute danling pagerank and non-dangling pagerank
-        Abc_NtkForEachObj( pNtk, pNode, i ){
-            float curr_pr = pNode->pr;
-            sum_pr += curr_pr;
-            if (Abc_ObjFaninNum(pNode) == 0){       // PI nodes
-                dangling_pr += curr_pr;
-            }
-        }
-
-        if (num_iterations != 0){
-            Abc_NtkForEachObj( pNtk, pNode, i ){
-                pNode->ppr = pNode->pr;
-            }
-        }
-
-        // normalize the elments of the pagerank vertor sum to 1
-        sum_pr = 1; 
-
-        float one_Av = damping_factor * dangling_pr / num_nodes;
-        float one_Iv = (1-damping_factor) * sum_pr / num_nodes;
-        diff = 0; 
-
-        Abc_NtkForEachObj( pNtk, pNode, i ){   
-            float h = 0.0; 
-            Abc_ObjForEachFanout(pNode, pNext, j ){
-                float h_v = (Abc_ObjFaninNum(pNext)) ? 1.0 / Abc_ObjFaninNum(pNext): 0.0;
-                h += h_v * pNext->ppr;
-            }    
-            h *= damping_factor;
-            pNode->pr = one_Av + one_Iv + h; 
-            diff += fabs(pNode->pr - pNode->ppr);
-        }
-        num_iterations++;
-    }
-
-    sum_pr = 0;
-    dangling_pr = 0;    
-    // 找出最大的 PageRank 值
-    Abc_NtkForEachObj( pNtk, pNode, i ){
-        sum_pr += Abc_ObjPR(pNode);
-        if (Abc_ObjFaninNum(pNode) == 0){
-            dangling_pr += Abc_ObjPR(pNode);
-        }
-        // printf("PR: %f , id %d \n", Abc_ObjPR(pNode), Abc_ObjId(pNode) );
-    }
-    // printf("sum_damp: %f , sum_non_damp: %f \n", dangling_pr, sum_pr-dangling_pr);
+    Abc_NtkPageRank( pNtk, nThreads );
     // compute the max path from the pagerank score
     return  Abc_NtkMaxPR(pNtk);
 }
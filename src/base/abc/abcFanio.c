@@ -70,6 +70,42 @@ static inline void Vec_IntPushMem( Mem_Step_t * pMemMan, Vec_Int_t * p, int Entr
     p->pArray[p->nSize++] = Entry;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Grows the array allocated by Vec_IntPushMem().]
+
+  Description [The capacity is doubled until it reaches nCapMin, so that
+  the recycled entries have the same sizes as in Vec_IntPushMem().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Vec_IntGrowMem( Mem_Step_t * pMemMan, Vec_Int_t * p, int nCapMin )
+{
+    int * pArray;
+    int i, nCap;
+    if ( p->nCap >= nCapMin )
+        return;
+    for ( nCap = Abc_MaxInt( p->nCap, 1 ); nCap < nCapMin; nCap *= 2 );
+    if ( pMemMan )
+        pArray = (int *)Mem_StepEntryFetch( pMemMan, nCap * 4 );
+    else
+        pArray = ABC_ALLOC( int, nCap );
+    if ( p->pArray )
+    {
+        for ( i = 0; i < p->nSize; i++ )
+            pArray[i] = p->pArray[i];
+        if ( pMemMan )
+            Mem_StepEntryRecycle( pMemMan, (char *)p->pArray, p->nCap * 4 );
+        else
+            ABC_FREE( p->pArray );
+    }
+    p->nCap = nCap;
+    p->pArray = pArray;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Creates fanout/fanin relationship between the nodes.]
@@ -97,6 +133,24 @@ void Abc_ObjAddFanin( Abc_Obj_t * pObj, Abc_Obj_t * pFanin )
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Reserves the room for the given number of fanouts.]
+
+  Description [Used before adding several fanouts to the node at once,
+  so that its fanout array is reallocated at most once.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ObjReserveFanouts( Abc_Obj_t * pObj, int nFanouts )
+{
+    assert( !Abc_ObjIsComplement(pObj) );
+    Vec_IntGrowMem( pObj->pNtk->pMmStep, &pObj->vFanouts, nFanouts );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Destroys fanout/fanin relationship between the nodes.]
@@ -155,6 +209,26 @@ void Abc_ObjRemoveFanins( Abc_Obj_t * pObj )
     assert( vFaninsOld->nSize == 0 );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Destroys fanout/fanin relationship between the nodes.]
+
+  Description [Same as Abc_ObjRemoveFanins() except that the node is not
+  removed from the fanout arrays of its fanins. The caller is responsible
+  for compacting these arrays when done (see Abc_ObjCompactFanouts()).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ObjRemoveFaninsLazy( Abc_Obj_t * pObj )
+{
+    Vec_IntClear( &pObj->vFanins );
+    pObj->fCompl0 = 0;
+    pObj->fCompl1 = 0;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Replaces a fanin of the node.]
@@ -209,6 +283,72 @@ void Abc_ObjPatchFanin( Abc_Obj_t * pObj, Abc_Obj_t * pFaninOld, Abc_Obj_t * pFa
     Vec_IntPushMem( pObj->pNtk->pMmStep, &pFaninNewR->vFanouts, pObj->Id );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Replaces a fanin of the node.]
+
+  Description [Same as Abc_ObjPatchFanin() except that the node is not
+  removed from the fanout array of pFaninOld. The caller is responsible
+  for calling Abc_ObjCompactFanouts() on pFaninOld when done.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ObjPatchFaninLazy( Abc_Obj_t * pObj, Abc_Obj_t * pFaninOld, Abc_Obj_t * pFaninNew )
+{
+    Abc_Obj_t * pFaninNewR = Abc_ObjRegular(pFaninNew);
+    int iFanin;
+    assert( !Abc_ObjIsComplement(pObj) );
+    assert( !Abc_ObjIsComplement(pFaninOld) );
+    assert( pFaninOld != pFaninNewR );
+    assert( pObj->pNtk == pFaninOld->pNtk );
+    assert( pObj->pNtk == pFaninNewR->pNtk );
+    if ( (iFanin = Vec_IntFind( &pObj->vFanins, pFaninOld->Id )) == -1 )
+    {
+        printf( "Node %s is not among", Abc_ObjName(pFaninOld) );
+        printf( " the fanins of node %s...\n", Abc_ObjName(pObj) );
+        return;
+    }
+    Vec_IntWriteEntry( &pObj->vFanins, iFanin, pFaninNewR->Id );
+    if ( Abc_ObjIsComplement(pFaninNew) )
+        Abc_ObjXorFaninC( pObj, iFanin );
+    Vec_IntPushMem( pObj->pNtk->pMmStep, &pFaninNewR->vFanouts, pObj->Id );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Removes the stale entries from the fanout array.]
+
+  Description [An entry is stale if the fanout no longer has the node
+  among its fanins. The relative order of the remaining fanouts is preserved,
+  so that a batch of lazy removals leaves the array in the same state as
+  the corresponding sequence of Abc_ObjDeleteFanin() calls, in linear rather
+  than quadratic time. Returns the number of removed entries.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_ObjCompactFanouts( Abc_Obj_t * pObj )
+{
+    Vec_Int_t * vFanouts = &pObj->vFanouts;
+    Abc_Obj_t * pFanout;
+    int i, k, nRemoved;
+    assert( !Abc_ObjIsComplement(pObj) );
+    for ( i = k = 0; i < vFanouts->nSize; i++ )
+    {
+        pFanout = Abc_NtkObj( pObj->pNtk, vFanouts->pArray[i] );
+        if ( pFanout && Vec_IntFind( &pFanout->vFanins, pObj->Id ) >= 0 )
+            vFanouts->pArray[k++] = vFanouts->pArray[i];
+    }
+    nRemoved = vFanouts->nSize - k;
+    vFanouts->nSize = k;
+    return nRemoved;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Replaces pObj by iObjNew in the fanin arrays of the fanouts.]
@@ -291,24 +431,28 @@ Abc_Obj_t * Abc_ObjInsertBetween( Abc_Obj_t * pNodeIn, Abc_Obj_t * pNodeOut, Abc
 ***********************************************************************/
 void Abc_ObjTransferFanout( Abc_Obj_t * pNodeFrom, Abc_Obj_t * pNodeTo )
 {
-    Vec_Ptr_t * vFanouts;
-    int nFanoutsOld, i;
+    Vec_Int_t * vFanouts = &pNodeFrom->vFanouts;
+    Abc_Obj_t * pFanout;
+    int nFanoutsOld, iFanin, i;
     assert( !Abc_ObjIsComplement(pNodeFrom) );
     assert( !Abc_ObjIsComplement(pNodeTo) );
     assert( !Abc_ObjIsPo(pNodeFrom) && !Abc_ObjIsPo(pNodeTo) );
     assert( pNodeFrom->pNtk == pNodeTo->pNtk );
     assert( pNodeFrom != pNodeTo );
     assert( !Abc_ObjIsNode(pNodeFrom) || Abc_ObjFanoutNum(pNodeFrom) > 0 );
-    // get the fanouts of the old node
     nFanoutsOld = Abc_ObjFanoutNum(pNodeTo);
-    vFanouts = Vec_PtrAlloc( nFanoutsOld );
-    Abc_NodeCollectFanouts( pNodeFrom, vFanouts );
-    // patch the fanin of each of them
+    // patch the fanin of each fanout and move the whole fanout array at once
+    // (this is equivalent to calling Abc_ObjPatchFanin() for each fanout in order)
     for ( i = 0; i < vFanouts->nSize; i++ )
-        Abc_ObjPatchFanin( (Abc_Obj_t *)vFanouts->pArray[i], pNodeFrom, pNodeTo );
-    assert( Abc_ObjFanoutNum(pNodeFrom) == 0 );
+    {
+        pFanout = Abc_NtkObj( pNodeFrom->pNtk, vFanouts->pArray[i] );
+        iFanin = Vec_IntFind( &pFanout->vFanins, pNodeFrom->Id );
+        assert( iFanin >= 0 );
+        Vec_IntWriteEntry( &pFanout->vFanins, iFanin, pNodeTo->Id );
+        Vec_IntPushMem( pNodeFrom->pNtk->pMmStep, &pNodeTo->vFanouts, pFanout->Id );
+    }
     assert( Abc_ObjFanoutNum(pNodeTo) == nFanoutsOld + vFanouts->nSize );
-    Vec_PtrFree( vFanouts );
+    Vec_IntClear( vFanouts );
 }
 
 /**Function*************************************************************
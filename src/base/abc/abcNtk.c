@@ -1432,6 +1432,9 @@ void Abc_NtkDelete( Abc_Ntk_t * pNtk )
     Vec_PtrFree( pNtk->vBoxes );
     ABC_FREE( pNtk->vTravIds.pArray );
     if ( pNtk->vLevelsR ) Vec_IntFree( pNtk->vLevelsR );
+    Vec_FltFreeP( &pNtk->vPageRank );
+    Vec_BitFreeP( &pNtk->vHandled );
+    Abc_NtkFreeCuts( pNtk );
     ABC_FREE( pNtk->pModel );
     ABC_FREE( pNtk->pSeqModel );
     if ( pNtk->vSeqModelVec )
@@ -60,10 +60,6 @@ Abc_Obj_t * Abc_ObjAlloc( Abc_Ntk_t * pNtk, Abc_ObjType_t Type )
     pObj->pNtk = pNtk;
     pObj->Type = Type;
     pObj->Id   = -1;
-    pObj->ppr = 0;
-    pObj->pr = 0;
-    pObj->fHandled = 0;
-    pObj->oLNode = NULL;
     return pObj;
 }
 
@@ -0,0 +1,469 @@
+/**CFile****************************************************************
+
+  FileName    [abcRank.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Network and node package.]
+
+  Synopsis    [PageRank scores of the objects.]
+
+  Author      [ABC contributors]
+
+  Affiliation [ABC open-source project]
+
+  Date        [Ver. 1.0. Started - October 17, 2026.]
+
+  Revision    [$Id: abcRank.c,v 1.00 2026/10/17 00:00:00 abc Exp $]
+
+***********************************************************************/
+
+#include "abc.h"
+#include <math.h>
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+/*
+    The score of an object is the probability of reaching it by walking
+    from the COs towards the CIs: each object passes its score to its
+    fanins in equal parts, and the objects without fanins pass their
+    score to all objects. The power iteration runs on a compact copy of
+    the fanout lists (CSR arrays indexed by object IDs), which is built
+    once. Each iteration has two loops over the objects: the first one
+    scales the scores of the previous iteration by the fanin weights, the
+    second one gathers the scaled scores of the fanouts. With threads, the
+    ID range is split into parts with similar numbers of fanout edges.
+    The arithmetic is the same with and without threads, except that the
+    residual is summed by parts, which may change the iteration count.
+
+    After the network is modified, the scores are refreshed locally:
+    a few Gauss-Seidel sweeps start from the objects whose fanouts have
+    changed and propagate to the fanins of the objects whose scores have
+    changed, while the constant term of the last power iteration is kept.
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define ABC_PR_DAMPING      ((float)0.85)  // the damping factor
+#define ABC_PR_CONVERGENCE  ((float)0.0001)// the total residual at convergence
+#define ABC_PR_ITERS_MAX    100            // the max number of power iterations
+#define ABC_PR_PAR_MIN      50000          // the min number of objects to use threads
+#define ABC_PR_THREADS_MAX  64             // the max number of threads
+
+typedef struct Abc_PrMan_t_ Abc_PrMan_t;
+typedef struct Abc_PrJob_t_ Abc_PrJob_t;
+
+struct Abc_PrJob_t_
+{
+    Abc_PrMan_t *    p;             // the manager
+    int              iBeg;          // the first object ID of this part
+    int              iEnd;          // the object ID following this part
+    float            Diff;          // the residual of this part
+};
+
+struct Abc_PrMan_t_
+{
+    int              nObjs;         // the number of object IDs
+    int              nLive;         // the number of objects
+    int *            pStart;        // the first fanout of each object in pAdj
+    int *            pAdj;          // the fanout IDs
+    float *          pWeight;       // the reciprocal of the fanin count of each object
+    char *           pLive;         // marks the IDs used by the objects
+    Vec_Int_t *      vDangling;     // the objects without fanins
+    float *          pPr;           // the scores of the current iteration
+    float *          pPrev;         // the scores of the previous iteration
+    float *          pScaled;       // the previous scores multiplied by the weights
+    float            Base;          // the constant term of the current iteration
+    int              fStop;         // the threads should exit
+    Abc_PrJob_t *    pJobs;         // the parts of the ID range
+    int              nJobs;         // the number of parts
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t  Mutex;         // the barrier of the threads
+    pthread_cond_t   Cond;
+    int              nWaiting;      // the number of threads at the barrier
+    int              Phase;         // the number of passed barriers
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the weight of the edge from the fanout.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline float Abc_NtkPageRankWeight( Abc_Obj_t * pObj )
+{
+    return Abc_ObjFaninNum(pObj) ? 1.0 / Abc_ObjFaninNum(pObj) : 0.0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Builds the CSR arrays of the fanouts.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_PrMan_t * Abc_NtkPageRankStart( Abc_Ntk_t * pNtk )
+{
+    Abc_PrMan_t * p;
+    Abc_Obj_t * pObj, * pFanout;
+    int i, k, nEdges = 0;
+    p = ABC_CALLOC( Abc_PrMan_t, 1 );
+    p->nObjs     = Abc_NtkObjNumMax(pNtk);
+    p->nLive     = Abc_NtkObjNum(pNtk);
+    p->pStart    = ABC_CALLOC( int, p->nObjs + 1 );
+    p->pWeight   = ABC_CALLOC( float, p->nObjs );
+    p->pLive     = ABC_CALLOC( char, p->nObjs );
+    p->pPrev     = ABC_ALLOC( float, p->nObjs );
+    p->pScaled   = ABC_ALLOC( float, p->nObjs );
+    p->vDangling = Vec_IntAlloc( Abc_NtkCiNum(pNtk) + 1 );
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        p->pLive[i]   = 1;
+        p->pWeight[i] = Abc_NtkPageRankWeight( pObj );
+        if ( Abc_ObjFaninNum(pObj) == 0 )
+            Vec_IntPush( p->vDangling, i );
+        nEdges += Abc_ObjFanoutNum(pObj);
+    }
+    p->pAdj = ABC_ALLOC( int, Abc_MaxInt(nEdges, 1) );
+    for ( i = 0; i < p->nObjs; i++ )
+    {
+        p->pStart[i+1] = p->pStart[i];
+        if ( (pObj = Abc_NtkObj(pNtk, i)) == NULL )
+            continue;
+        Abc_ObjForEachFanout( pObj, pFanout, k )
+            p->pAdj[p->pStart[i+1]++] = pFanout->Id;
+    }
+    assert( p->pStart[p->nObjs] == nEdges );
+    return p;
+}
+void Abc_NtkPageRankStop( Abc_PrMan_t * p )
+{
+    Vec_IntFree( p->vDangling );
+    ABC_FREE( p->pStart );
+    ABC_FREE( p->pAdj );
+    ABC_FREE( p->pWeight );
+    ABC_FREE( p->pLive );
+    ABC_FREE( p->pPrev );
+    ABC_FREE( p->pScaled );
+    ABC_FREE( p->pJobs );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Splits the IDs into parts with similar amounts of work.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkPageRankSplit( Abc_PrMan_t * p, int nJobs )
+{
+    word nWork = (word)p->nObjs + p->pStart[p->nObjs];
+    int i, k = 0;
+    p->nJobs = nJobs;
+    p->pJobs = ABC_CALLOC( Abc_PrJob_t, nJobs );
+    for ( i = 0; i < nJobs; i++ )
+    {
+        p->pJobs[i].p    = p;
+        p->pJobs[i].iBeg = k;
+        while ( k < p->nObjs && (word)k + p->pStart[k] < nWork * (i + 1) / nJobs )
+            k++;
+        p->pJobs[i].iEnd = i == nJobs - 1 ? p->nObjs : k;
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs one power iteration on a part of the IDs.]
+
+  Description [The scaling loop and the gathering loop should be separated
+  by a barrier when the parts are processed by different threads.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Abc_NtkPageRankScale( Abc_PrMan_t * p, int iBeg, int iEnd )
+{
+    float * pScaled = p->pScaled, * pWeight = p->pWeight, * pPrev = p->pPrev;
+    int i;
+    for ( i = iBeg; i < iEnd; i++ )
+        pScaled[i] = pWeight[i] * pPrev[i];
+}
+static inline float Abc_NtkPageRankGather( Abc_PrMan_t * p, int iBeg, int iEnd )
+{
+    float Diff = 0, h;
+    int i, k;
+    for ( i = iBeg; i < iEnd; i++ )
+    {
+        if ( !p->pLive[i] )
+            continue;
+        h = 0;
+        for ( k = p->pStart[i]; k < p->pStart[i+1]; k++ )
+            h += p->pScaled[p->pAdj[k]];
+        h *= ABC_PR_DAMPING;
+        p->pPr[i] = p->Base + h;
+        Diff += fabs( p->pPr[i] - p->pPrev[i] );
+    }
+    return Diff;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Prepares the next iteration.]
+
+  Description [Returns 0 if the iterations are over.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkPageRankNext( Abc_PrMan_t * p, int nIters )
+{
+    float Dangling = 0, Diff = 0, * pTemp;
+    int i, Id;
+    if ( nIters > 0 )
+    {
+        for ( i = 0; i < p->nJobs; i++ )
+            Diff += p->pJobs[i].Diff;
+        if ( Diff <= ABC_PR_CONVERGENCE || nIters >= ABC_PR_ITERS_MAX )
+            return 0;
+    }
+    Vec_IntForEachEntry( p->vDangling, Id, i )
+        Dangling += p->pPr[Id];
+    // the scores of the dead IDs are equal in both arrays
+    if ( nIters > 0 )
+        pTemp = p->pPr, p->pPr = p->pPrev, p->pPrev = pTemp;
+    p->Base = ABC_PR_DAMPING * Dangling / p->nLive + (1 - ABC_PR_DAMPING) / p->nLive;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs the power iteration in the threads.]
+
+  Description [The calling thread processes the first part and controls
+  the iterations, the other threads process the other parts.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+static void Abc_NtkPageRankBarrier( Abc_PrMan_t * p )
+{
+    int Phase;
+    pthread_mutex_lock( &p->Mutex );
+    Phase = p->Phase;
+    if ( ++p->nWaiting == p->nJobs )
+    {
+        p->nWaiting = 0;
+        p->Phase++;
+        pthread_cond_broadcast( &p->Cond );
+    }
+    else while ( Phase == p->Phase )
+        pthread_cond_wait( &p->Cond, &p->Mutex );
+    pthread_mutex_unlock( &p->Mutex );
+}
+static void * Abc_NtkPageRankWorker( void * pArg )
+{
+    Abc_PrJob_t * pJob = (Abc_PrJob_t *)pArg;
+    Abc_PrMan_t * p = pJob->p;
+    while ( 1 )
+    {
+        Abc_NtkPageRankBarrier( p );
+        if ( p->fStop )
+            break;
+        Abc_NtkPageRankScale( p, pJob->iBeg, pJob->iEnd );
+        Abc_NtkPageRankBarrier( p );
+        pJob->Diff = Abc_NtkPageRankGather( p, pJob->iBeg, pJob->iEnd );
+        Abc_NtkPageRankBarrier( p );
+    }
+    return NULL;
+}
+static int Abc_NtkPageRankPar( Abc_PrMan_t * p )
+{
+    pthread_t Threads[ABC_PR_THREADS_MAX];
+    Abc_PrJob_t * pJob = p->pJobs;
+    int i, status, nIters = 0;
+    pthread_mutex_init( &p->Mutex, NULL );
+    pthread_cond_init( &p->Cond, NULL );
+    for ( i = 1; i < p->nJobs; i++ )
+    {
+        status = pthread_create( Threads + i, NULL, Abc_NtkPageRankWorker, (void *)(p->pJobs + i) );
+        assert( status == 0 );
+    }
+    while ( Abc_NtkPageRankNext(p, nIters) )
+    {
+        Abc_NtkPageRankBarrier( p );
+        Abc_NtkPageRankScale( p, pJob->iBeg, pJob->iEnd );
+        Abc_NtkPageRankBarrier( p );
+        pJob->Diff = Abc_NtkPageRankGather( p, pJob->iBeg, pJob->iEnd );
+        Abc_NtkPageRankBarrier( p );
+        nIters++;
+    }
+    p->fStop = 1;
+    Abc_NtkPageRankBarrier( p );
+    for ( i = 1; i < p->nJobs; i++ )
+    {
+        status = pthread_join( Threads[i], NULL );
+        assert( status == 0 );
+    }
+    pthread_cond_destroy( &p->Cond );
+    pthread_mutex_destroy( &p->Mutex );
+    return nIters;
+}
+#endif
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the PageRank scores of the objects.]
+
+  Description [The scores are stored in pNtk->vPageRank. Returns the
+  number of iterations.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkPageRank( Abc_Ntk_t * pNtk, int nThreads )
+{
+    Abc_PrMan_t * p;
+    float * pScores;
+    int nIters = 0;
+    if ( Abc_NtkObjNum(pNtk) == 0 )
+        return 0;
+    if ( pNtk->vPageRank == NULL )
+        pNtk->vPageRank = Vec_FltAlloc( 0 );
+    Vec_FltFill( pNtk->vPageRank, Abc_NtkObjNumMax(pNtk), 1.0 / (Abc_NtkObjNum(pNtk)*1.0) );
+    p = Abc_NtkPageRankStart( pNtk );
+    pScores = p->pPr = Vec_FltArray( pNtk->vPageRank );
+    memcpy( p->pPrev, p->pPr, sizeof(float) * p->nObjs );
+    nThreads = Abc_MinInt( nThreads, ABC_PR_THREADS_MAX );
+#ifdef ABC_USE_PTHREADS
+    if ( nThreads > 1 && p->nObjs >= ABC_PR_PAR_MIN )
+    {
+        Abc_NtkPageRankSplit( p, nThreads );
+        nIters = Abc_NtkPageRankPar( p );
+    }
+    else
+#endif
+    {
+        Abc_NtkPageRankSplit( p, 1 );
+        while ( Abc_NtkPageRankNext(p, nIters) )
+        {
+            Abc_NtkPageRankScale( p, 0, p->nObjs );
+            p->pJobs[0].Diff = Abc_NtkPageRankGather( p, 0, p->nObjs );
+            nIters++;
+        }
+    }
+    // the last scores may be in the other array
+    if ( p->pPr != pScores )
+    {
+        memcpy( pScores, p->pPr, sizeof(float) * p->nObjs );
+        p->pPrev = p->pPr;
+    }
+    pNtk->PageRankBase = p->Base;
+    Abc_NtkPageRankStop( p );
+    return nIters;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Refreshes the PageRank scores after the network has changed.]
+
+  Description [The seeds are the IDs of the objects whose fanouts have
+  changed (the deleted objects are skipped). Performs at most nIters
+  sweeps, each of them recomputing the scores of the objects in the
+  frontier, starting from the seeds. The fanins of the objects whose
+  scores have changed make up the next frontier. Returns the number
+  of the updated scores. Does nothing if the scores were not computed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkPageRankRefresh( Abc_Ntk_t * pNtk, Vec_Int_t * vSeeds, int nIters )
+{
+    Vec_Flt_t * vPr = pNtk->vPageRank;
+    Vec_Int_t * vFront, * vNext, * vTemp;
+    Abc_Obj_t * pObj, * pNext;
+    float Tolerance, h, Score;
+    int i, k, r, Id, nUpdates = 0;
+    if ( vPr == NULL || Vec_IntSize(vSeeds) == 0 || Abc_NtkObjNum(pNtk) == 0 )
+        return 0;
+    Tolerance = ABC_PR_CONVERGENCE / Abc_NtkObjNum(pNtk);
+    // the new objects start with the constant term
+    Vec_FltFillExtra( vPr, Abc_NtkObjNumMax(pNtk), pNtk->PageRankBase );
+    vFront = Vec_IntDup( vSeeds );
+    vNext  = Vec_IntAlloc( 2 * Vec_IntSize(vSeeds) );
+    for ( r = 0; r < nIters && Vec_IntSize(vFront) > 0; r++ )
+    {
+        Vec_IntUniqify( vFront );
+        Vec_IntClear( vNext );
+        // the fanouts usually have larger IDs than the fanins
+        Vec_IntForEachEntryReverse( vFront, Id, i )
+        {
+            if ( (pObj = Abc_NtkObj(pNtk, Id)) == NULL )
+                continue;
+            h = 0;
+            Abc_ObjForEachFanout( pObj, pNext, k )
+                h += Abc_NtkPageRankWeight(pNext) * Vec_FltEntry( vPr, pNext->Id );
+            h *= ABC_PR_DAMPING;
+            Score = pNtk->PageRankBase + h;
+            if ( fabs(Score - Vec_FltEntry(vPr, Id)) <= Tolerance )
+                continue;
+            Vec_FltWriteEntry( vPr, Id, Score );
+            Abc_ObjForEachFanin( pObj, pNext, k )
+                Vec_IntPush( vNext, pNext->Id );
+            nUpdates++;
+        }
+        vTemp = vFront, vFront = vNext, vNext = vTemp;
+    }
+    Vec_IntFree( vFront );
+    Vec_IntFree( vNext );
+    return nUpdates;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
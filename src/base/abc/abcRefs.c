@@ -112,6 +112,167 @@ int Abc_NodeMffcLabelAig( Abc_Obj_t * pNode )
     return nConeSize1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects MFFC of the node bounded by the leaves.]
+
+  Description [Same as Abc_NodeMffcLabelAig() with the leaves' fanout
+  counters incremented, except that the network is not modified: the
+  reference counters are kept in vCone/vRefs. This makes it possible to
+  call the procedure concurrently from several threads. The MFFC nodes,
+  including the root, are returned in vMffc. If vLeaves is NULL, the MFFC
+  is not bounded, as in Abc_NodeMffcSize(). Returns the MFFC size.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NodeMffcCollectAig_rec( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vMffc, Vec_Ptr_t * vCone, Vec_Int_t * vRefs )
+{
+    Abc_Obj_t * pFanin, * pLeaf;
+    int i, k, iCone, Counter = 1;
+    if ( Abc_ObjIsCi(pNode) )
+        return 0;
+    Abc_ObjForEachFanin( pNode, pFanin, i )
+    {
+        // the leaves are referenced from outside
+        if ( vLeaves )
+        {
+            Vec_PtrForEachEntry( Abc_Obj_t *, vLeaves, pLeaf, k )
+                if ( Abc_ObjRegular(pLeaf) == pFanin )
+                    break;
+            if ( k < Vec_PtrSize(vLeaves) )
+                continue;
+        }
+        iCone = Vec_PtrFind( vCone, pFanin );
+        if ( iCone == -1 )
+        {
+            iCone = Vec_PtrSize( vCone );
+            Vec_PtrPush( vCone, pFanin );
+            Vec_IntPush( vRefs, Abc_ObjFanoutNum(pFanin) );
+        }
+        assert( Vec_IntEntry(vRefs, iCone) > 0 );
+        if ( Vec_IntAddToEntry(vRefs, iCone, -1) > 0 )
+            continue;
+        Vec_PtrPush( vMffc, pFanin );
+        Counter += Abc_NodeMffcCollectAig_rec( pFanin, vLeaves, vMffc, vCone, vRefs );
+    }
+    return Counter;
+}
+int Abc_NodeMffcCollectAig( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vMffc, Vec_Ptr_t * vCone, Vec_Int_t * vRefs )
+{
+    assert( Abc_NtkIsStrash(pNode->pNtk) );
+    assert( !Abc_ObjIsComplement( pNode ) );
+    assert( Abc_ObjIsNode( pNode ) );
+    Vec_PtrClear( vMffc );
+    Vec_PtrClear( vCone );
+    Vec_IntClear( vRefs );
+    if ( Abc_ObjFaninNum(pNode) == 0 )
+        return 0;
+    Vec_PtrPush( vMffc, pNode );
+    return Abc_NodeMffcCollectAig_rec( pNode, vLeaves, vMffc, vCone, vRefs );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects MFFC of the node if it is not too large.]
+
+  Description [The MFFC is not bounded by the leaves and does not include
+  the CIs. The nodes are collected in the DFS order starting from the root.
+  Returns the MFFC size or -1 if the MFFC has more than nLimit nodes.
+  The MFFCs bounded by the cuts of the node are then derived from this one
+  by Abc_NodeMffcLabelLeaves() without dereferencing the cone. The MFFC is
+  not cached across the nodes: it is recollected when the node is evaluated,
+  because each accepted replacement changes the fanout counts it depends on.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NodeMffcCollectLimit_rec( Abc_Obj_t * pNode, Vec_Ptr_t * vMffc, int nLimit )
+{
+    Abc_Obj_t * pFanin;
+    int i, RetValue = 1;
+    Vec_PtrPush( vMffc, pNode );
+    Abc_ObjForEachFanin( pNode, pFanin, i )
+    {
+        assert( pFanin->vFanouts.nSize > 0 );
+        if ( --pFanin->vFanouts.nSize > 0 || Abc_ObjIsCi(pFanin) )
+            continue;
+        if ( Vec_PtrSize(vMffc) >= nLimit || !Abc_NodeMffcCollectLimit_rec( pFanin, vMffc, nLimit ) )
+            RetValue = 0;
+    }
+    return RetValue;
+}
+int Abc_NodeMffcCollectLimit( Abc_Obj_t * pNode, Vec_Ptr_t * vMffc, int nLimit )
+{
+    Abc_Obj_t * pObj, * pFanin;
+    int i, k, RetValue;
+    assert( Abc_NtkIsStrash(pNode->pNtk) );
+    assert( !Abc_ObjIsComplement( pNode ) );
+    assert( Abc_ObjIsNode( pNode ) );
+    Vec_PtrClear( vMffc );
+    if ( Abc_ObjFaninNum(pNode) == 0 )
+        return 0;
+    RetValue = Abc_NodeMffcCollectLimit_rec( pNode, vMffc, nLimit );
+    // each collected node has dereferenced its fanins
+    Vec_PtrForEachEntry( Abc_Obj_t *, vMffc, pObj, i )
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            pFanin->vFanouts.nSize++;
+    return RetValue ? Vec_PtrSize(vMffc) : -1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Labels MFFC bounded by the leaves using the collected MFFC.]
+
+  Description [vMffc is the MFFC collected by Abc_NodeMffcCollectLimit().
+  A node of vMffc belongs to the MFFC bounded by the leaves unless it is 
+  a leaf or it is in the TFI of a leaf, in which case the leaf is in vMffc 
+  as well. The result is the same as that of Abc_NodeMffcLabelAig() with 
+  the fanout counters of the leaves incremented: the bounded MFFC is labeled 
+  with the current traversal ID and its size is returned. The flag pfLabeled 
+  tells whether all nodes of vMffc are labeled with the current traversal 
+  ID, which saves relabeling when the leaves do not cut the MFFC.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NodeMffcUnlabel_rec( Abc_Obj_t * pNode )
+{
+    Abc_Obj_t * pFanin;
+    int i, Counter = 1;
+    Abc_NodeSetTravIdPrevious( pNode );
+    Abc_ObjForEachFanin( pNode, pFanin, i )
+        if ( Abc_NodeIsTravIdCurrent(pFanin) )
+            Counter += Abc_NodeMffcUnlabel_rec( pFanin );
+    return Counter;
+}
+int Abc_NodeMffcLabelLeaves( Vec_Ptr_t * vMffc, Vec_Ptr_t * vLeaves, int * pfLabeled )
+{
+    Abc_Obj_t * pObj;
+    int i, nExcluded = 0;
+    if ( Vec_PtrSize(vMffc) == 0 )
+        return 0;
+    if ( !*pfLabeled )
+    {
+        Abc_NtkIncrementTravId( ((Abc_Obj_t *)Vec_PtrEntry(vMffc, 0))->pNtk );
+        Vec_PtrForEachEntry( Abc_Obj_t *, vMffc, pObj, i )
+            Abc_NodeSetTravIdCurrent( pObj );
+        *pfLabeled = 1;
+    }
+    Vec_PtrForEachEntry( Abc_Obj_t *, vLeaves, pObj, i )
+        if ( Abc_NodeIsTravIdCurrent(Abc_ObjRegular(pObj)) )
+            nExcluded += Abc_NodeMffcUnlabel_rec( Abc_ObjRegular(pObj) );
+    if ( nExcluded > 0 )
+        *pfLabeled = 0;
+    return Vec_PtrSize(vMffc) - nExcluded;
+}
+
 /**Function*************************************************************
 
   Synopsis    [References/references the node and returns MFFC size.]
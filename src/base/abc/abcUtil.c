@@ -1794,6 +1794,112 @@ Vec_Int_t * Abc_NtkGetCiIds( Abc_Ntk_t * pNtk )
     return vCiIds;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Moves the entries of the array into the compacted positions.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_NtkCompactIdsInt( Vec_Int_t * p, Vec_Int_t * vMap, int nObjs )
+{
+    int i, iNew;
+    Vec_IntForEachEntry( vMap, iNew, i )
+        if ( iNew >= 0 && i < Vec_IntSize(p) )
+            Vec_IntWriteEntry( p, iNew, Vec_IntEntry(p, i) );
+    Vec_IntShrink( p, Abc_MinInt(Vec_IntSize(p), nObjs) );
+}
+static void Abc_NtkCompactIdsFlt( Vec_Flt_t * p, Vec_Int_t * vMap, int nObjs )
+{
+    int i, iNew;
+    Vec_IntForEachEntry( vMap, iNew, i )
+        if ( iNew >= 0 && i < Vec_FltSize(p) )
+            Vec_FltWriteEntry( p, iNew, Vec_FltEntry(p, i) );
+    Vec_FltShrink( p, Abc_MinInt(Vec_FltSize(p), nObjs) );
+}
+static void Abc_NtkCompactIdsBit( Vec_Bit_t * p, Vec_Int_t * vMap, int nObjs )
+{
+    int i, iNew;
+    Vec_IntForEachEntry( vMap, iNew, i )
+        if ( iNew >= 0 && i < Vec_BitSize(p) )
+            Vec_BitWriteEntry( p, iNew, Vec_BitEntry(p, i) );
+    Vec_BitShrink( p, Abc_MinInt(Vec_BitSize(p), nObjs) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Removes the holes left by the deleted objects.]
+
+  Description [Unlike Abc_NtkReassignIds(), this procedure can be called 
+  in the middle of a pass of the incremental rewriting. The objects keep 
+  their relative order, so comparing the IDs (for example, with the largest 
+  ID before the pass) gives the same result as before. Only the AND nodes 
+  are moved, so the names of the CIs and the COs remain valid. Remaps the 
+  fanins, the fanouts, the trav IDs, the reverse levels, the PageRank scores, 
+  the kept cuts and the structural hashing table. Returns the map of the old 
+  IDs into the new ones (-1 for the deleted objects), or NULL if nothing 
+  was done.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Abc_NtkCompactIds( Abc_Ntk_t * pNtk )
+{
+    Vec_Int_t * vMap;
+    Abc_Obj_t * pObj;
+    int i, k, nObjs = 0;
+    assert( Abc_NtkIsStrash(pNtk) );
+    if ( Abc_NtkObjNum(pNtk) == Abc_NtkObjNumMax(pNtk) )
+        return NULL;
+    // the other arrays indexed by the object IDs are not remapped
+    if ( pNtk->vTopo || pNtk->vObjPerm || pNtk->vNameIds || pNtk->vOrigNodeIds )
+        return NULL;
+    vMap = Vec_IntStartFull( Abc_NtkObjNumMax(pNtk) );
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        if ( !Abc_ObjIsNode(pObj) && nObjs != i )
+        {
+            Vec_IntFree( vMap );
+            return NULL;
+        }
+        Vec_IntWriteEntry( vMap, i, nObjs++ );
+    }
+    assert( nObjs == Abc_NtkObjNum(pNtk) );
+    // move the objects (the new ID never exceeds the old one)
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        pObj->Id = Vec_IntEntry( vMap, i );
+        Vec_PtrWriteEntry( pNtk->vObjs, pObj->Id, pObj );
+    }
+    Vec_PtrShrink( pNtk->vObjs, nObjs );
+    // update the fanin/fanout arrays
+    Abc_NtkForEachObj( pNtk, pObj, i )
+    {
+        for ( k = 0; k < pObj->vFanins.nSize; k++ )
+            pObj->vFanins.pArray[k] = Vec_IntEntry( vMap, pObj->vFanins.pArray[k] );
+        for ( k = 0; k < pObj->vFanouts.nSize; k++ )
+            pObj->vFanouts.pArray[k] = Vec_IntEntry( vMap, pObj->vFanouts.pArray[k] );
+    }
+    // remap the arrays indexed by the object IDs
+    Abc_NtkCompactIdsInt( &pNtk->vTravIds, vMap, nObjs );
+    if ( pNtk->vLevelsR )
+        Abc_NtkCompactIdsInt( pNtk->vLevelsR, vMap, nObjs );
+    if ( pNtk->vPageRank )
+        Abc_NtkCompactIdsFlt( pNtk->vPageRank, vMap, nObjs );
+    if ( pNtk->vHandled )
+        Abc_NtkCompactIdsBit( pNtk->vHandled, vMap, nObjs );
+    Abc_NtkRemapCuts( pNtk, vMap );
+    // rehash the AIG
+    Abc_AigRemapIds( (Abc_Aig_t *)pNtk->pManFunc, vMap );
+    return vMap;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Puts the nodes into the DFS order and reassign their IDs.]
@@ -1809,7 +1915,9 @@ void Abc_NtkReassignIds( Abc_Ntk_t * pNtk )
 {
     Vec_Ptr_t * vNodes;
     Vec_Ptr_t * vObjsNew;
+    Vec_Int_t * vMap;
     Abc_Obj_t * pNode, * pTemp, * pConst1;
+    float Score;
     int i, k;
     assert( Abc_NtkIsStrash(pNtk) );
 //printf( "Total = %d. Current = %d.\n", Abc_NtkObjNumMax(pNtk), Abc_NtkObjNum(pNtk) );
@@ -1868,6 +1976,35 @@ void Abc_NtkReassignIds( Abc_Ntk_t * pNtk )
             pNode->vFanouts.pArray[k] = pTemp->Id;
     }
 
+    // map the old IDs into the new ones (the old array of objs is indexed by the old IDs)
+    vMap = Vec_IntStartFull( Vec_PtrSize(pNtk->vObjs) );
+    Vec_PtrForEachEntry( Abc_Obj_t *, pNtk->vObjs, pNode, i )
+        if ( pNode )
+            Vec_IntWriteEntry( vMap, i, pNode->Id );
+    // remap the PageRank scores
+    if ( pNtk->vPageRank )
+    {
+        Vec_Flt_t * vPageRank = Vec_FltStart( Vec_PtrSize(vObjsNew) );
+        Vec_FltForEachEntry( pNtk->vPageRank, Score, i )
+            if ( i < Vec_IntSize(vMap) && Vec_IntEntry(vMap, i) >= 0 )
+                Vec_FltWriteEntry( vPageRank, Vec_IntEntry(vMap, i), Score );
+        Vec_FltFree( pNtk->vPageRank );
+        pNtk->vPageRank = vPageRank;
+    }
+    // remap the handled flags
+    if ( pNtk->vHandled )
+    {
+        Vec_Bit_t * vHandled = Vec_BitStart( Vec_PtrSize(vObjsNew) );
+        for ( i = 0; i < Vec_BitSize(pNtk->vHandled); i++ )
+            if ( i < Vec_IntSize(vMap) && Vec_IntEntry(vMap, i) >= 0 )
+                Vec_BitWriteEntry( vHandled, Vec_IntEntry(vMap, i), Vec_BitEntry(pNtk->vHandled, i) );
+        Vec_BitFree( pNtk->vHandled );
+        pNtk->vHandled = vHandled;
+    }
+    // remap the cuts kept by the network
+    Abc_NtkRemapCuts( pNtk, vMap );
+    Vec_IntFree( vMap );
+
     // replace the array of objs
     Vec_PtrFree( pNtk->vObjs );
     pNtk->vObjs = vObjsNew;
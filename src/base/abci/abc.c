@@ -103,6 +103,7 @@ static int Abc_CommandPrintCone              ( Abc_Frame_t * pAbc, int argc, cha
 static int Abc_CommandPrintMiter             ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandPrintStatus            ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandPrintDelay             ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandStats                  ( Abc_Frame_t * pAbc, int argc, char ** argv );
 
 static int Abc_CommandShow                   ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandShowBdd                ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -900,6 +901,7 @@ void Abc_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "Printing",     "print_miter",   Abc_CommandPrintMiter,       0 );
     Cmd_CommandAdd( pAbc, "Printing",     "print_status",  Abc_CommandPrintStatus,      0 );
     Cmd_CommandAdd( pAbc, "Printing",     "print_delay",   Abc_CommandPrintDelay,       0 );
+    Cmd_CommandAdd( pAbc, "Printing",     "stats",         Abc_CommandStats,            0 );
 
     Cmd_CommandAdd( pAbc, "Printing",     "show",          Abc_CommandShow,             0 );
     Cmd_CommandAdd( pAbc, "Printing",     "show_bdd",      Abc_CommandShowBdd,          0 );
@@ -1495,6 +1497,7 @@ void Abc_End( Abc_Frame_t * pAbc )
     Gia_ManStopP( &pAbc->pGiaSaved );
     if ( Abc_NtkRecIsRunning3() )
         Abc_NtkRecStop3();
+    Util_StatStop();
 }
 
 /**Function*************************************************************
@@ -3227,6 +3230,106 @@ usage:
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    []
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_CommandStats( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    FILE * pFile = stdout;
+    char * pFileName = NULL, * pExitName = NULL;
+    int c, fCsv = 0, fToggle = 0, fReset = 0;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "OEjcerh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'O':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-O\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pFileName = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'E':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-E\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pExitName = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'j':
+            fCsv = 0;
+            break;
+        case 'c':
+            fCsv = 1;
+            break;
+        case 'e':
+            fToggle ^= 1;
+            break;
+        case 'r':
+            fReset ^= 1;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( argc != globalUtilOptind )
+        goto usage;
+    if ( fToggle )
+    {
+        Util_StatSetEnabled( !Util_StatIsOn() );
+        Abc_Print( 1, "Collecting the metrics is %s.\n", Util_StatIsOn() ? "enabled" : "disabled" );
+        return 0;
+    }
+    if ( fReset )
+    {
+        Util_StatReset();
+        return 0;
+    }
+    if ( pExitName )
+    {
+        Util_StatSetExitFile( pExitName, fCsv );
+        return 0;
+    }
+    if ( pFileName && (pFile = fopen( pFileName, "wb" )) == NULL )
+    {
+        Abc_Print( -1, "Cannot open file \"%s\" for writing.\n", pFileName );
+        return 1;
+    }
+    Util_StatPrint( pFile, fCsv );
+    if ( pFile != stdout )
+        fclose( pFile );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: stats [-OE file] [-jcerh]\n" );
+    Abc_Print( -2, "\t           prints the metrics collected by the previous commands\n" );
+    Abc_Print( -2, "\t           (counters, timers and histograms of each command that updated them;\n" );
+    Abc_Print( -2, "\t           only the last %d such commands are kept)\n", UTIL_STAT_RECORDS );
+    Abc_Print( -2, "\t-O file  : the file to write the metrics into [default = stdout]\n" );
+    Abc_Print( -2, "\t-E file  : the file to write the metrics into when ABC exits\n" );
+    Abc_Print( -2, "\t-j       : write the metrics in JSON format [default = %s]\n", fCsv? "no": "yes" );
+    Abc_Print( -2, "\t-c       : write the metrics in CSV format [default = %s]\n", fCsv? "yes": "no" );
+    Abc_Print( -2, "\t-e       : toggle collecting the metrics [default = %s]\n", Util_StatIsOn()? "yes": "no" );
+    Abc_Print( -2, "\t-r       : forget the metrics collected so far\n" );
+    Abc_Print( -2, "\t-h       : print the command usage\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -7606,14 +7709,18 @@ int Abc_CommandOrchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
 
     int fPrecompute; //rewrite option (not enabled)
     int fPlaceEnable; //rewrite option (not enabled)
+    int fParallel; //rewrite evaluated in a separate thread
 
     int fVerbose; //rewrite/rs/rf verbose
     int fVeryVerbose; //very verbose option for all 
+    char * pCacheFile = NULL; //gain cache shared between runs
+    char * pReplayFile = NULL; //recorded decisions to replay
     //size_t NtkSize;
     extern void Rwr_Precompute();
 
     //local greedy
-    extern int Abc_NtkOrchLocal( Abc_Ntk_t * pNtk, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutsMax, int nNodesMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs );
+    extern int Abc_NtkOrchReplay( Abc_Ntk_t * pNtk, char * pDecFile, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutsMax, int nNodesMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs );
+    extern int Abc_NtkOrchLocal( Abc_Ntk_t * pNtk, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutsMax, int nNodesMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs, char * pCacheFile, int fParallel );
     //priority orch
     extern int Abc_NtkOchestration( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, int sOpsOrder, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutsMax, int nNodesMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs );
     // set defaults
@@ -7626,13 +7733,14 @@ int Abc_CommandOrchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
     fVerbose     =  0;
     fVeryVerbose = 0;
     fPlaceEnable = 0;
+    fParallel    = 0;
     fPrecompute  = 0;
     nCutsMax     =  8;
     nNodesMax    =  1;
     nLevelsOdc   =  0;
 
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "KNFZzlvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KNFCRZzlpvwh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -7669,6 +7777,24 @@ int Abc_CommandOrchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nLevelsOdc < 0 )
                 goto usage;
             break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-C\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pCacheFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'R':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-R\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pReplayFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
         case 'l':
             fUpdateLevel ^= 1;
             break;
@@ -7678,6 +7804,9 @@ int Abc_CommandOrchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
         case 'Z':
             fUseZeros_ref ^= 1;
             break;
+        case 'p':
+            fParallel ^= 1;
+            break;
         case 'v':
             fVerbose ^= 1;
             break;
@@ -7728,7 +7857,10 @@ int Abc_CommandOrchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
 
     // modify the current network
     pDup = Abc_NtkDup( pNtk );
-    RetValue = Abc_NtkOrchLocal( pNtk, fUseZeros_rwr, fUseZeros_ref, fPlaceEnable, nCutsMax, nNodesMax, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose, nNodeSizeMax, nConeSizeMax, fUseDcs );
+    if ( pReplayFile )
+        RetValue = Abc_NtkOrchReplay( pNtk, pReplayFile, fUseZeros_rwr, fUseZeros_ref, fPlaceEnable, nCutsMax, nNodesMax, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose, nNodeSizeMax, nConeSizeMax, fUseDcs );
+    else
+        RetValue = Abc_NtkOrchLocal( pNtk, fUseZeros_rwr, fUseZeros_ref, fPlaceEnable, nCutsMax, nNodesMax, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose, nNodeSizeMax, nConeSizeMax, fUseDcs, pCacheFile, fParallel );
     if ( RetValue == -1 )
     {
         Abc_FrameReplaceCurrentNetwork( pAbc, pDup );
@@ -7746,14 +7878,19 @@ int Abc_CommandOrchestrate( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: orchestrate [-KNFZzlvwh]\n" );
+    Abc_Print( -2, "usage: orchestrate [-KNFCRZzlpvwh]\n" );
     Abc_Print( -2, "\t           performs technology-independent AIG synthesis using orchestration method (currently orchestrating rw/rf/rs)\n" );
     Abc_Print( -2, "\t-K <num> : (resub)the max cut size (%d <= num <= %d) [default = %d]\n", RS_CUT_MIN, RS_CUT_MAX, nCutsMax );
     Abc_Print( -2, "\t-N <num> : (resub)the max number of nodes to add (0 <= num <= 3) [default = %d]\n", nNodesMax );
     Abc_Print( -2, "\t-F <num> : (resub)the number of fanout levels for ODC computation [default = %d]\n", nLevelsOdc );
+    Abc_Print( -2, "\t-C file  : the file caching the gains of node cones between runs [default = %s]\n", pCacheFile ? pCacheFile : "none" );
+    Abc_Print( -2, "\t           (lossy: the nodes whose cones, up to 4 levels, had no valid operation are skipped, which may change QoR)\n" );
+    Abc_Print( -2, "\t-R file  : replay the decisions recorded by \"aigaug -d\" instead of choosing the operators [default = %s]\n", pReplayFile ? pReplayFile : "none" );
+    Abc_Print( -2, "\t           (text files are replayed with the -z/-Z settings above; .dec files carry the settings of the recording)\n" );
     Abc_Print( -2, "\t-l       : (resub/rw/refactor)toggle preserving the number of levels [default = %s]\n", fUpdateLevel? "yes": "no" );
     Abc_Print( -2, "\t-z       : (rw)toggle using zero-cost replacements [default = %s]\n", fUseZeros_rwr? "yes": "no" );
     Abc_Print( -2, "\t-Z       : (refactor)toggle using zero-cost replacements [default = %s]\n", fUseZeros_ref? "yes": "no" );
+    Abc_Print( -2, "\t-p       : (rw)toggle evaluating rewriting in a separate thread [default = %s]\n", fParallel? "yes": "no" );
     Abc_Print( -2, "\t-v       : (resub/rw/refactor)toggle verbose printout [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-w       : (resub/rw/refactor)toggle detailed verbose printout [default = %s]\n", fVeryVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h       : print the command usage\n");
@@ -7796,13 +7933,14 @@ int Abc_CommandAIGAugmentation( Abc_Frame_t * pAbc, int argc, char ** argv )
     //int sOpsOrder;
     size_t NtkSize;
     char *DecisionFile = NULL;
+    char *pCacheFile = NULL;
     Vec_Int_t *DecisionMask;
     Vec_Int_t *pGain_rwr;
     Vec_Int_t *pGain_res;
     Vec_Int_t *pGain_ref;    
     //FILE *maskFile;
     extern void Rwr_Precompute();
-    extern int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, Vec_Int_t **DecisionMask, char *DecisionFile, int Rand_Seed, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutsMax, int nNodesMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs );
+    extern int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, Vec_Int_t **DecisionMask, char *DecisionFile, int Rand_Seed, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutsMax, int nNodesMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs, char * pCacheFile );
     // set defaults
     nNodeSizeMax = 10;
     nConeSizeMax = 16;
@@ -7819,7 +7957,7 @@ int Abc_CommandAIGAugmentation( Abc_Frame_t * pAbc, int argc, char ** argv )
     nLevelsOdc   =  0;
     Rand_Seed = 1;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "zZdsh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "zZdsCh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -7848,6 +7986,14 @@ int Abc_CommandAIGAugmentation( Abc_Frame_t * pAbc, int argc, char ** argv )
             Rand_Seed = atoi(argv[globalUtilOptind]);
             globalUtilOptind++;
             break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                goto usage;
+            }
+            pCacheFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
         }
     }
     if ( fPrecompute )
@@ -7893,7 +8039,7 @@ int Abc_CommandAIGAugmentation( Abc_Frame_t * pAbc, int argc, char ** argv )
            Vec_IntPush(DecisionMask, atoi("-1"));}
     // modify the current network
     pDup = Abc_NtkDup( pNtk );
-    RetValue = Abc_NtkOrchRand( pNtk, &pGain_rwr, &pGain_res, &pGain_ref, &DecisionMask, DecisionFile, Rand_Seed, fUseZeros_rwr, fUseZeros_ref, fPlaceEnable, nCutsMax, nNodesMax, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose, nNodeSizeMax, nConeSizeMax, fUseDcs );
+    RetValue = Abc_NtkOrchRand( pNtk, &pGain_rwr, &pGain_res, &pGain_ref, &DecisionMask, DecisionFile, Rand_Seed, fUseZeros_rwr, fUseZeros_ref, fPlaceEnable, nCutsMax, nNodesMax, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose, nNodeSizeMax, nConeSizeMax, fUseDcs, pCacheFile );
     //printf("Vector check: %d %d\n", DecisionList->nSize, DecisionList->pArray[0]); 
     if ( RetValue == -1 )
     {
@@ -7913,12 +8059,16 @@ int Abc_CommandAIGAugmentation( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: aigaug [-s <num>] [-d <file>][-zZdsh]\n" );
+    Abc_Print( -2, "usage: aigaug [-s <num>] [-d <file>] [-C <file>][-zZdsCh]\n" );
     Abc_Print( -2, "\t           performs technology-independent AIG random synthesis (node level) for RTL augmentation\n" );
     Abc_Print( -2, "\t-z       : toggle using zero-cost replacements for rwr for aigaug [default = %s]\n", fUseZeros_rwr? "yes": "no" );
     Abc_Print( -2, "\t-Z       : toggle using zero-cost replacements for ref for aigaug [default = %s]\n", fUseZeros_ref? "yes": "no" );
     Abc_Print( -2, "\t-d       : record random synthesis decision made during augmentation [required filename; e.g., test.csv]\n");
+    Abc_Print( -2, "\t           (files with extension .dec are written in a compact binary format that \"orchestrate -R\" maps into memory)\n");
     Abc_Print( -2, "\t-s       : set the random seed for random augmentation\n");
+    Abc_Print( -2, "\t-C       : the file caching the gains of node cones between runs; nodes known to have no valid operation are skipped\n");
+    Abc_Print( -2, "\t           (lossy: the cones are compared up to 4 levels, so a skipped node may have had a valid operation;\n" );
+    Abc_Print( -2, "\t           the gains of the skipped nodes are reported as -99, like those of the other nodes that are not evaluated)\n");
     Abc_Print( -2, "\t-v       : toggle verbose printout [default = %s]\n", fVerbose? "yes": "no" );
     Abc_Print( -2, "\t-h       : print the command usage\n");
     Abc_Print( -2, "\tExample       : read i10.aig;st;aigaug -s 1 -d test.csv;write i10_arg_1.aig;cec i10.aig i10_arg_1.aig\n");
@@ -7943,6 +8093,9 @@ usage:
 int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
 {
     Abc_Ntk_t * pNtk = Abc_FrameReadNtk(pAbc), * pDup;
+    Abc_Ckp_t * pCkp = NULL;
+    char * pCkpFile = NULL;
+    char * pResFile = NULL;
     int c, RetValue;
     int fUpdateLevel;
     int fPrecompute;
@@ -7950,6 +8103,11 @@ int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fVerbose;
     int fVeryVerbose;
     int fPlaceEnable;
+    int nThreads;
+    int nParThreads;
+    int nNodeBudget;
+    int nTimeLimit;
+    int nCkpSecs;
     // external functions
     extern void Rwr_Precompute();
 
@@ -7960,11 +8118,95 @@ int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
     fVerbose     = 0;
     fVeryVerbose = 0;
     fPlaceEnable = 0;
+    nThreads     = 0;
+    nParThreads  = 0;
+    nNodeBudget  = 0;
+    nTimeLimit   = 0;
+    nCkpSecs     = 300;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "lxzvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NPBTICRlxzvwh" ) ) != EOF )
     {
         switch ( c )
         {
+        case 'N':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-N\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nThreads = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nThreads < 0 || nThreads > ABC_RESYN_THREADS_MAX )
+            {
+                Abc_Print( -1, "The number of threads (switch \"-N\") should be from 0 to %d.\n", ABC_RESYN_THREADS_MAX );
+                goto usage;
+            }
+            break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nParThreads = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nParThreads < 0 || nParThreads > ABC_RESYN_THREADS_MAX )
+            {
+                Abc_Print( -1, "The number of threads (switch \"-P\") should be from 0 to %d.\n", ABC_RESYN_THREADS_MAX );
+                goto usage;
+            }
+            break;
+        case 'B':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-B\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nNodeBudget = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nNodeBudget < 0 )
+                goto usage;
+            break;
+        case 'T':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-T\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nTimeLimit = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nTimeLimit < 0 )
+                goto usage;
+            break;
+        case 'I':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-I\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nCkpSecs = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nCkpSecs < 0 )
+                goto usage;
+            break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-C\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pCkpFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
+        case 'R':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-R\" should be followed by a file name.\n" );
+                goto usage;
+            }
+            pResFile = argv[globalUtilOptind];
+            globalUtilOptind++;
+            break;
         case 'l':
             fUpdateLevel ^= 1;
             break;
@@ -8012,9 +8254,50 @@ int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
         return 1;
     }
 
+    if ( nParThreads > 0 && (pCkpFile || pResFile) )
+    {
+        Abc_Print( -1, "Checkpoints are not supported for the partitioned rewriting (switch \"-P\").\n" );
+        return 1;
+    }
+    if ( nParThreads > 0 )
+    {
+        Abc_ResynPars_t Pars, * pPars = &Pars;
+        memset( pPars, 0, sizeof(Abc_ResynPars_t) );
+        pPars->Engine       = 0;
+        pPars->nThreads     = nParThreads;
+        pPars->fUpdateLevel = fUpdateLevel;
+        pPars->fUseZeros    = fUseZeros;
+        pPars->fVerbose     = fVerbose;
+        pDup = Abc_NtkResynPartitioned( pNtk, pPars );
+        if ( pDup == NULL )
+        {
+            Abc_Print( 0, "Rewriting has failed.\n" );
+            return 1;
+        }
+        Abc_FrameReplaceCurrentNetwork( pAbc, pDup );
+        return 0;
+    }
+
+    // restore the network from the checkpoint
+    if ( pCkpFile || pResFile )
+        pCkp = Abc_NtkCkpStart( pCkpFile, nCkpSecs, fVerbose );
+    if ( pResFile )
+    {
+        pDup = Abc_NtkCkpResume( pCkp, pNtk, pResFile );
+        if ( pDup == NULL )
+        {
+            Abc_NtkCkpStop( pCkp );
+            return 1;
+        }
+        Abc_FrameReplaceCurrentNetwork( pAbc, pDup );
+        pNtk = pDup;
+    }
+
     // modify the current network
     pDup = Abc_NtkDup( pNtk );
-    RetValue = Abc_NtkRewrite( pNtk, fUpdateLevel, fUseZeros, fVerbose, fVeryVerbose, fPlaceEnable );
+    RetValue = Abc_NtkRewrite( pNtk, fUpdateLevel, fUseZeros, nThreads, nNodeBudget, nTimeLimit, fVerbose, fVeryVerbose, fPlaceEnable, pCkp );
+    if ( pCkp )
+        Abc_NtkCkpStop( pCkp );
     if ( RetValue == -1 )
     {
         Abc_FrameReplaceCurrentNetwork( pAbc, pDup );
@@ -8032,8 +8315,16 @@ int Abc_CommandRewrite( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: rewrite [-lzvwh]\n" );
+    Abc_Print( -2, "usage: rewrite [-NPBTI num] [-CR file] [-lzvwh]\n" );
     Abc_Print( -2, "\t         performs technology-independent rewriting of the AIG\n" );
+    Abc_Print( -2, "\t-N num : the number of threads evaluating the nodes in advance (0 = none) [default = %d]\n", nThreads );
+    Abc_Print( -2, "\t-P num : the number of threads rewriting disjoint partitions (0 = none) [default = %d]\n", nParThreads );
+    Abc_Print( -2, "\t-B num : the max number of nodes to evaluate (0 = no limit) [default = %d]\n", nNodeBudget );
+    Abc_Print( -2, "\t-T num : the runtime limit in seconds (0 = no limit) [default = %d]\n", nTimeLimit );
+    Abc_Print( -2, "\t         (with -B or -T, the nodes with more fanout-free nodes within 2 levels below them are preferred)\n" );
+    Abc_Print( -2, "\t-I num : the interval between the checkpoints in seconds [default = %d]\n", nCkpSecs );
+    Abc_Print( -2, "\t-C file: the file to periodically save the checkpoints of the pass [default = %s]\n", pCkpFile ? pCkpFile : "none" );
+    Abc_Print( -2, "\t-R file: the checkpoint to resume the interrupted pass from [default = %s]\n", pResFile ? pResFile : "none" );
     Abc_Print( -2, "\t-l     : toggle preserving the number of levels [default = %s]\n", fUpdateLevel? "yes": "no" );
     Abc_Print( -2, "\t-z     : toggle using zero-cost replacements [default = %s]\n", fUseZeros? "yes": "no" );
     Abc_Print( -2, "\t-v     : toggle verbose printout [default = %s]\n", fVerbose? "yes": "no" );
@@ -8065,6 +8356,7 @@ int Abc_CommandRefactor( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fUseZeros;
     int fUseDcs;
     int fVerbose;
+    int nParThreads;
     extern int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nConeSizeMax, int fUpdateLevel, int fUseZeros, int fUseDcs, int fVerbose );
 
     // set defaults
@@ -8075,8 +8367,9 @@ int Abc_CommandRefactor( Abc_Frame_t * pAbc, int argc, char ** argv )
     fUseZeros    =  0;
     fUseDcs      =  0;
     fVerbose     =  0;
+    nParThreads  =  0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "NMClzvh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "NMCPlzvh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -8113,6 +8406,20 @@ int Abc_CommandRefactor( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nConeSizeMax < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nParThreads = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nParThreads < 0 || nParThreads > ABC_RESYN_THREADS_MAX )
+            {
+                Abc_Print( -1, "The number of threads (switch \"-P\") should be from 0 to %d.\n", ABC_RESYN_THREADS_MAX );
+                goto usage;
+            }
+            break;
         case 'l':
             fUpdateLevel ^= 1;
             break;
@@ -8163,6 +8470,29 @@ int Abc_CommandRefactor( Abc_Frame_t * pAbc, int argc, char ** argv )
         return 1;
     }
 
+    if ( nParThreads > 0 )
+    {
+        Abc_ResynPars_t Pars, * pPars = &Pars;
+        memset( pPars, 0, sizeof(Abc_ResynPars_t) );
+        pPars->Engine       = 1;
+        pPars->nThreads     = nParThreads;
+        pPars->nNodeSizeMax = nNodeSizeMax;
+        pPars->nConeSizeMax = nConeSizeMax;
+        pPars->nMinSaved    = nMinSaved;
+        pPars->fUpdateLevel = fUpdateLevel;
+        pPars->fUseZeros    = fUseZeros;
+        pPars->fUseDcs      = fUseDcs;
+        pPars->fVerbose     = fVerbose;
+        pDup = Abc_NtkResynPartitioned( pNtk, pPars );
+        if ( pDup == NULL )
+        {
+            Abc_Print( 0, "Refactoring has failed.\n" );
+            return 1;
+        }
+        Abc_FrameReplaceCurrentNetwork( pAbc, pDup );
+        return 0;
+    }
+
     // modify the current network
     pDup = Abc_NtkDup( pNtk );
     RetValue = Abc_NtkRefactor( pNtk, nNodeSizeMax, nMinSaved, nConeSizeMax, fUpdateLevel, fUseZeros, fUseDcs, fVerbose );
@@ -8183,11 +8513,12 @@ int Abc_CommandRefactor( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: refactor [-NM <num>] [-lzvh]\n" );
+    Abc_Print( -2, "usage: refactor [-NMP <num>] [-lzvh]\n" );
     Abc_Print( -2, "\t           performs technology-independent refactoring of the AIG\n" );
     Abc_Print( -2, "\t-N <num> : the max support of the collapsed node [default = %d]\n", nNodeSizeMax );
     Abc_Print( -2, "\t-M <num> : the min number of nodes saved after one step (0 <= num) [default = %d]\n", nMinSaved );
 //    Abc_Print( -2, "\t-C <num> : the max support of the containing cone [default = %d]\n", nConeSizeMax );
+    Abc_Print( -2, "\t-P <num> : the number of threads refactoring disjoint partitions (0 = none) [default = %d]\n", nParThreads );
     Abc_Print( -2, "\t-l       : toggle preserving the number of levels [default = %s]\n", fUpdateLevel? "yes": "no" );
     Abc_Print( -2, "\t-z       : toggle using zero-cost replacements [default = %s]\n", fUseZeros? "yes": "no" );
 //    Abc_Print( -2, "\t-d       : toggle using don't-cares [default = %s]\n", fUseDcs? "yes": "no" );
@@ -8319,6 +8650,7 @@ int Abc_CommandResubstitute( Abc_Frame_t * pAbc, int argc, char ** argv )
     int fUseZeros;
     int fVerbose;
     int fVeryVerbose;
+    int nParThreads;
     extern int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutsMax, int nNodesMax, int nMinSaved, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose );
 
     // set defaults
@@ -8330,8 +8662,9 @@ int Abc_CommandResubstitute( Abc_Frame_t * pAbc, int argc, char ** argv )
     fUseZeros    =  0;
     fVerbose     =  0;
     fVeryVerbose =  0;
+    nParThreads  =  0;
     Extra_UtilGetoptReset();
-    while ( ( c = Extra_UtilGetopt( argc, argv, "KNMFlzvwh" ) ) != EOF )
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KNMFPlzvwh" ) ) != EOF )
     {
         switch ( c )
         {
@@ -8379,6 +8712,20 @@ int Abc_CommandResubstitute( Abc_Frame_t * pAbc, int argc, char ** argv )
             if ( nLevelsOdc < 0 )
                 goto usage;
             break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nParThreads = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nParThreads < 0 || nParThreads > ABC_RESYN_THREADS_MAX )
+            {
+                Abc_Print( -1, "The number of threads (switch \"-P\") should be from 0 to %d.\n", ABC_RESYN_THREADS_MAX );
+                goto usage;
+            }
+            break;
         case 'l':
             fUpdateLevel ^= 1;
             break;
@@ -8428,6 +8775,30 @@ int Abc_CommandResubstitute( Abc_Frame_t * pAbc, int argc, char ** argv )
         return 1;
     }
 
+    if ( nParThreads > 0 )
+    {
+        Abc_ResynPars_t Pars, * pPars = &Pars;
+        Abc_Ntk_t * pNtkRes;
+        memset( pPars, 0, sizeof(Abc_ResynPars_t) );
+        pPars->Engine       = 2;
+        pPars->nThreads     = nParThreads;
+        pPars->nCutsMax     = nCutsMax;
+        pPars->nNodesMax    = nNodesMax;
+        pPars->nLevelsOdc   = nLevelsOdc;
+        pPars->nMinSaved    = nMinSaved;
+        pPars->fUpdateLevel = fUpdateLevel;
+        pPars->fUseZeros    = fUseZeros;
+        pPars->fVerbose     = fVerbose;
+        pNtkRes = Abc_NtkResynPartitioned( pNtk, pPars );
+        if ( pNtkRes == NULL )
+        {
+            Abc_Print( -1, "Resubstitution has failed.\n" );
+            return 1;
+        }
+        Abc_FrameReplaceCurrentNetwork( pAbc, pNtkRes );
+        return 0;
+    }
+
     // modify the current network
     if ( !Abc_NtkResubstitute( pNtk, nCutsMax, nNodesMax, nMinSaved, nLevelsOdc, fUpdateLevel, fVerbose, fVeryVerbose ) )
     {
@@ -8437,12 +8808,13 @@ int Abc_CommandResubstitute( Abc_Frame_t * pAbc, int argc, char ** argv )
     return 0;
 
 usage:
-    Abc_Print( -2, "usage: resub [-KNMF <num>] [-lzvwh]\n" );
+    Abc_Print( -2, "usage: resub [-KNMFP <num>] [-lzvwh]\n" );
     Abc_Print( -2, "\t           performs technology-independent restructuring of the AIG\n" );
     Abc_Print( -2, "\t-K <num> : the max cut size (%d <= num <= %d) [default = %d]\n", RS_CUT_MIN, RS_CUT_MAX, nCutsMax );
     Abc_Print( -2, "\t-N <num> : the max number of nodes to add (0 <= num <= 3) [default = %d]\n", nNodesMax );
     Abc_Print( -2, "\t-M <num> : the min number of nodes saved after one step (0 <= num) [default = %d]\n", nMinSaved );
     Abc_Print( -2, "\t-F <num> : the number of fanout levels for ODC computation [default = %d]\n", nLevelsOdc );
+    Abc_Print( -2, "\t-P <num> : the number of threads resubstituting disjoint partitions (0 = none) [default = %d]\n", nParThreads );
     Abc_Print( -2, "\t-l       : toggle preserving the number of levels [default = %s]\n", fUpdateLevel? "yes": "no" );
     Abc_Print( -2, "\t-z       : toggle using zero-cost replacements [default = %s]\n", fUseZeros? "yes": "no" );
     Abc_Print( -2, "\t-v       : toggle verbose printout [default = %s]\n", fVerbose? "yes": "no" );
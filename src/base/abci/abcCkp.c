@@ -0,0 +1,580 @@
+/**CFile****************************************************************
+
+  FileName    [abcCkp.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Network and node package.]
+
+  Synopsis    [Checkpoints of the incremental rewriting.]
+
+  Author      [ABC contributors]
+
+  Affiliation [ABC open-source project]
+
+  Date        [Ver. 1.0. Started - October 17, 2026.]
+
+  Revision    [$Id: abcCkp.c,v 1.00 2026/10/17 00:00:00 abc Exp $]
+
+***********************************************************************/
+
+#include "base/abc/abc.h"
+#include "aig/gia/gia.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+/*
+    The checkpoint is a snapshot of the AIG and of the order list taken
+    between two node evaluations of the incremental rewriting. It records:
+    - the AND nodes in a topological order (AIGER-like delta encoding),
+      each node with a flag telling whether it was created in this pass,
+    - the drivers of the COs,
+    - the order list as the sequence of the recorded nodes, and the position
+      of the current iterator in this sequence (the nodes before it have
+      been handled),
+    - the counters of the pass.
+    The CIs and the COs are not recorded: they are taken from the network
+    given to the resumed command, which should be the same as the one given
+    to the interrupted command.
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define ABC_CKP_MAGIC    "ABCCKP01"
+
+struct Abc_Ckp_t_
+{
+    // writing the checkpoints
+    char *           pFileName;     // the checkpoint file
+    int              nSecs;         // the interval between the checkpoints in seconds
+    abctime          clkNext;       // the time when the next checkpoint is due
+    int              nSaved;        // the number of checkpoints written
+    int              fVerbose;      // verbose printout
+    Vec_Str_t *      vBuffer;       // the snapshot being written
+    Vec_Int_t *      vMap;          // maps object IDs into snapshot literals
+    int              fWriting;      // the writer thread is running
+#ifdef ABC_USE_PTHREADS
+    pthread_t        Thread;        // the writer thread
+#endif
+    // the state restored from a checkpoint
+    Vec_Int_t *      vFresh;        // the nodes created in the interrupted pass (by ID)
+    Vec_Int_t *      vList;         // the order list (node IDs)
+    int              iCur;          // the position of the current iterator in the list
+    int              iNode;         // the number of the list entries visited
+    int              nNodes;        // the limit on the number of the list entries visited
+    int              nRewritten;    // the number of accepted rewrites
+    int              nNodesBeg;     // the number of nodes before the pass
+};
+
+static void          Abc_NtkCkpSerialize( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, int iNode, int nNodes, int nNodeIdMax, int nRewritten, int nNodesBeg );
+static int           Abc_NtkCkpFlush( Abc_Ckp_t * p );
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the checkpoint manager.]
+
+  Description [If the file name is given, the checkpoints are written
+  into this file every nSecs seconds.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ckp_t * Abc_NtkCkpStart( char * pFileName, int nSecs, int fVerbose )
+{
+    Abc_Ckp_t * p = ABC_CALLOC( Abc_Ckp_t, 1 );
+    p->pFileName = pFileName ? Abc_UtilStrsav( pFileName ) : NULL;
+    p->nSecs     = nSecs;
+    p->fVerbose  = fVerbose;
+    p->clkNext   = Abc_Clock() + (abctime)nSecs * CLOCKS_PER_SEC;
+    p->vBuffer   = Vec_StrAlloc( 0 );
+    p->vMap      = Vec_IntAlloc( 0 );
+    return p;
+}
+void Abc_NtkCkpStop( Abc_Ckp_t * p )
+{
+    Abc_NtkCkpFlush( p );
+    if ( p->fVerbose && p->nSaved )
+        printf( "Checkpoints: Written %d snapshots into file \"%s\".\n", p->nSaved, p->pFileName );
+    Vec_StrFree( p->vBuffer );
+    Vec_IntFree( p->vMap );
+    Vec_IntFreeP( &p->vFresh );
+    Vec_IntFreeP( &p->vList );
+    ABC_FREE( p->pFileName );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the snapshot into the file.]
+
+  Description [The snapshot is first written into a temporary file, which
+  then replaces the checkpoint, so that the checkpoint is never left
+  incomplete.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkCkpWriteFile( Abc_Ckp_t * p )
+{
+    char * pFileTemp = ABC_ALLOC( char, strlen(p->pFileName) + 5 );
+    FILE * pFile;
+    int RetValue = 0;
+    sprintf( pFileTemp, "%s.tmp", p->pFileName );
+    pFile = fopen( pFileTemp, "wb" );
+    if ( pFile != NULL )
+    {
+        RetValue = (int)fwrite( Vec_StrArray(p->vBuffer), 1, Vec_StrSize(p->vBuffer), pFile ) == Vec_StrSize(p->vBuffer);
+        RetValue &= fclose( pFile ) == 0;
+        if ( RetValue )
+        {
+#ifdef _WIN32
+            remove( p->pFileName );
+#endif
+            RetValue = rename( pFileTemp, p->pFileName ) == 0;
+        }
+    }
+    ABC_FREE( pFileTemp );
+    return RetValue;
+}
+#ifdef ABC_USE_PTHREADS
+void * Abc_NtkCkpWriteThread( void * pArg )
+{
+    Abc_Ckp_t * p = (Abc_Ckp_t *)pArg;
+    return Abc_NtkCkpWriteFile( p ) ? p : NULL;
+}
+#endif
+
+/**Function*************************************************************
+
+  Synopsis    [Waits until the previous snapshot is written.]
+
+  Description [Returns 0 if writing the snapshot has failed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkCkpFlush( Abc_Ckp_t * p )
+{
+    int RetValue = 1;
+#ifdef ABC_USE_PTHREADS
+    if ( p->fWriting )
+    {
+        void * pResult = NULL;
+        pthread_join( p->Thread, &pResult );
+        RetValue = pResult != NULL;
+        p->fWriting = 0;
+    }
+#endif
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Takes the checkpoint if it is due.]
+
+  Description [Should be called before the node pointed to by the current
+  iterator of the order list is evaluated. The network is serialized by
+  the calling thread, which takes time linear in the network size, while
+  the file is written by a separate thread.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkCkpUpdate( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, int iNode, int nNodes, int nNodeIdMax, int nRewritten, int nNodesBeg )
+{
+    abctime clk;
+    if ( p == NULL || p->pFileName == NULL || (iNode & 0xFF) )
+        return;
+    if ( Abc_Clock() < p->clkNext )
+        return;
+    clk = Abc_Clock();
+    if ( !Abc_NtkCkpFlush( p ) )
+        printf( "Abc_NtkCkpUpdate: Cannot write checkpoint file \"%s\".\n", p->pFileName );
+    Abc_NtkCkpSerialize( p, pNtk, iNode, nNodes, nNodeIdMax, nRewritten, nNodesBeg );
+#ifdef ABC_USE_PTHREADS
+    p->fWriting = pthread_create( &p->Thread, NULL, Abc_NtkCkpWriteThread, (void *)p ) == 0;
+    if ( !p->fWriting )
+#endif
+    if ( !Abc_NtkCkpWriteFile( p ) )
+        printf( "Abc_NtkCkpUpdate: Cannot write checkpoint file \"%s\".\n", p->pFileName );
+    p->nSaved++;
+    p->clkNext = Abc_Clock() + (abctime)p->nSecs * CLOCKS_PER_SEC;
+    if ( p->fVerbose )
+    {
+        printf( "Checkpoint %d: Visited = %d. Nodes = %d. Bytes = %d. ", p->nSaved, iNode, Abc_NtkNodeNum(pNtk), Vec_StrSize(p->vBuffer) );
+        ABC_PRT( "Time", Abc_Clock() - clk );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Serializes the network and the order list.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Abc_NtkCkpLit( Vec_Int_t * vMap, Abc_Obj_t * pFanin, int fCompl )
+{
+    return Abc_Var2Lit( Vec_IntEntry(vMap, Abc_ObjId(pFanin)), fCompl );
+}
+static inline int Abc_NtkCkpIsListed( Abc_Ntk_t * pNtk, Abc_Obj_t * pNode )
+{
+    return pNode != NULL && Abc_ObjIsNode(pNode) && Abc_NtkObj(pNtk, pNode->Id) == pNode;
+}
+void Abc_NtkCkpSerialize_rec( Abc_Ckp_t * p, Abc_Obj_t * pNode, Vec_Int_t * vNodes )
+{
+    if ( Vec_IntEntry(p->vMap, Abc_ObjId(pNode)) >= 0 )
+        return;
+    assert( Abc_ObjIsNode(pNode) );
+    Abc_NtkCkpSerialize_rec( p, Abc_ObjFanin0(pNode), vNodes );
+    Abc_NtkCkpSerialize_rec( p, Abc_ObjFanin1(pNode), vNodes );
+    Vec_IntWriteEntry( p->vMap, Abc_ObjId(pNode), 1 + Abc_NtkCiNum(pNode->pNtk) + Vec_IntSize(vNodes) );
+    Vec_IntPush( vNodes, Abc_ObjId(pNode) );
+}
+void Abc_NtkCkpSerialize( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, int iNode, int nNodes, int nNodeIdMax, int nRewritten, int nNodesBeg )
+{
+    List_Ptr_t * oList = Abc_AigGetOList( (Abc_Aig_t *)pNtk->pManFunc );
+    List_Ptr_Node_t * oLNode;
+    Vec_Int_t * vNodes = Vec_IntAlloc( Abc_NtkNodeNum(pNtk) );
+    Vec_Int_t * vList  = Vec_IntAlloc( Abc_NtkNodeNum(pNtk) );
+    Abc_Obj_t * pObj;
+    int i, iCur = -1, Lit0, Lit1, fFresh;
+    // assign the literals in the order of the list
+    Vec_IntFill( p->vMap, Abc_NtkObjNumMax(pNtk), -1 );
+    Vec_IntWriteEntry( p->vMap, Abc_ObjId(Abc_AigConst1(pNtk)), 0 );
+    Abc_NtkForEachCi( pNtk, pObj, i )
+        Vec_IntWriteEntry( p->vMap, Abc_ObjId(pObj), 1 + i );
+    for ( oLNode = List_PtrFirstNode(oList); oLNode; oLNode = oLNode->pNext )
+    {
+        if ( oLNode == oList->pCurItera )
+            iCur = Vec_IntSize(vList);
+        pObj = (Abc_Obj_t *)oLNode->pData;
+        if ( !Abc_NtkCkpIsListed(pNtk, pObj) )
+            continue;
+        Abc_NtkCkpSerialize_rec( p, pObj, vNodes );
+        Vec_IntPush( vList, Vec_IntEntry(p->vMap, Abc_ObjId(pObj)) );
+    }
+    if ( iCur == -1 )
+        iCur = Vec_IntSize(vList);
+    // add the nodes that are not in the list
+    Abc_NtkForEachNode( pNtk, pObj, i )
+        Abc_NtkCkpSerialize_rec( p, pObj, vNodes );
+    // write the header
+    Vec_StrClear( p->vBuffer );
+    Vec_StrPushBuffer( p->vBuffer, (char *)ABC_CKP_MAGIC, strlen(ABC_CKP_MAGIC) );
+    Gia_AigerWriteUnsigned( p->vBuffer, Abc_NtkCiNum(pNtk) );
+    Gia_AigerWriteUnsigned( p->vBuffer, Abc_NtkCoNum(pNtk) );
+    Gia_AigerWriteUnsigned( p->vBuffer, Vec_IntSize(vNodes) );
+    Gia_AigerWriteUnsigned( p->vBuffer, Vec_IntSize(vList) );
+    Gia_AigerWriteUnsigned( p->vBuffer, iCur );
+    Gia_AigerWriteUnsigned( p->vBuffer, iNode );
+    Gia_AigerWriteUnsigned( p->vBuffer, nNodes );
+    Gia_AigerWriteUnsigned( p->vBuffer, nRewritten );
+    Gia_AigerWriteUnsigned( p->vBuffer, nNodesBeg );
+    // write the nodes
+    Abc_NtkForEachObjVec( vNodes, pNtk, pObj, i )
+    {
+        int iVar = 1 + Abc_NtkCiNum(pNtk) + i;
+        Lit0   = Abc_NtkCkpLit( p->vMap, Abc_ObjFanin0(pObj), Abc_ObjFaninC0(pObj) );
+        Lit1   = Abc_NtkCkpLit( p->vMap, Abc_ObjFanin1(pObj), Abc_ObjFaninC1(pObj) );
+        fFresh = Abc_ObjId(pObj) > nNodeIdMax || Abc_NtkCkpNodeIsFresh( p, pObj );
+        assert( Abc_MaxInt(Lit0, Lit1) < 2 * iVar );
+        Gia_AigerWriteUnsigned( p->vBuffer, ((2 * iVar - Abc_MaxInt(Lit0, Lit1)) << 1) | fFresh );
+        Gia_AigerWriteUnsigned( p->vBuffer, Abc_MaxInt(Lit0, Lit1) - Abc_MinInt(Lit0, Lit1) );
+    }
+    // write the COs
+    Abc_NtkForEachCo( pNtk, pObj, i )
+        Gia_AigerWriteUnsigned( p->vBuffer, Abc_NtkCkpLit( p->vMap, Abc_ObjFanin0(pObj), Abc_ObjFaninC0(pObj) ) );
+    // write the order list
+    Vec_IntForEachEntry( vList, Lit0, i )
+        Gia_AigerWriteUnsigned( p->vBuffer, Lit0 );
+    Vec_IntFree( vNodes );
+    Vec_IntFree( vList );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads one number of the checkpoint.]
+
+  Description [Same as Gia_AigerReadUnsigned() but does not read past
+  the end of the buffer. Sets *pfBad and returns 0 if the number does
+  not fit into the buffer or into a non-negative integer.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Abc_NtkCkpReadInt( unsigned char ** ppPos, unsigned char * pStop, int * pfBad )
+{
+    word x = 0;
+    int i;
+    unsigned char ch;
+    for ( i = 0; i < 5; i++ )
+    {
+        if ( *ppPos >= pStop )
+            break;
+        ch = *(*ppPos)++;
+        x |= (word)(ch & 0x7f) << (7 * i);
+        if ( ch & 0x80 )
+            continue;
+        if ( x > (word)ABC_INFINITY )
+            break;
+        return (int)x;
+    }
+    *pfBad = 1;
+    return 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Restores the network from the checkpoint.]
+
+  Description [The CIs and the COs are taken from the given network.
+  Returns the new network, or NULL if the file cannot be read or does not
+  match the network. The order list and the counters are kept in the
+  manager until the rewriting is started.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ntk_t * Abc_NtkCkpResume( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, char * pFileName )
+{
+    Abc_Ntk_t * pNtkNew;
+    Abc_Obj_t * pObj, * pFanin0, * pFanin1;
+    Vec_Ptr_t * vObjs;
+    Vec_Str_t * vBuffer;
+    unsigned char * pPos, * pStop;
+    char * pContents;
+    int i, nCis, nCos, nObjs, nList, iVar, Lit0, Lit1, Delta, Diff, fFresh, fBad = 0;
+    assert( Abc_NtkIsStrash(pNtk) );
+    pContents = Extra_FileReadContents( pFileName );
+    if ( pContents == NULL )
+    {
+        printf( "Abc_NtkCkpResume: Cannot open checkpoint file \"%s\".\n", pFileName );
+        return NULL;
+    }
+    vBuffer = Vec_StrAllocArray( pContents, Extra_FileSize(pFileName) );
+    if ( Vec_StrSize(vBuffer) < (int)strlen(ABC_CKP_MAGIC) || strncmp(Vec_StrArray(vBuffer), ABC_CKP_MAGIC, strlen(ABC_CKP_MAGIC)) )
+    {
+        printf( "Abc_NtkCkpResume: File \"%s\" is not a checkpoint.\n", pFileName );
+        Vec_StrFree( vBuffer );
+        return NULL;
+    }
+    pPos  = (unsigned char *)Vec_StrArray(vBuffer) + strlen(ABC_CKP_MAGIC);
+    pStop = (unsigned char *)Vec_StrLimit(vBuffer);
+    nCis  = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    nCos  = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    nObjs = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    nList = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    p->iCur       = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    p->iNode      = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    p->nNodes     = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    p->nRewritten = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    p->nNodesBeg  = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+    // each node takes at least two bytes, each CO and each list entry at least one byte
+    if ( fBad || p->iCur > nList || 2 * (word)nObjs + nCos + nList > (word)(pStop - pPos) )
+    {
+        printf( "Abc_NtkCkpResume: Checkpoint file \"%s\" is corrupted.\n", pFileName );
+        Vec_StrFree( vBuffer );
+        return NULL;
+    }
+    if ( nCis != Abc_NtkCiNum(pNtk) || nCos != Abc_NtkCoNum(pNtk) )
+    {
+        printf( "Abc_NtkCkpResume: The checkpoint has %d CIs and %d COs while the network has %d CIs and %d COs.\n",
+            nCis, nCos, Abc_NtkCiNum(pNtk), Abc_NtkCoNum(pNtk) );
+        Vec_StrFree( vBuffer );
+        return NULL;
+    }
+    // start the network with the same CIs and COs
+    pNtkNew = Abc_NtkStartFrom( pNtk, ABC_NTK_STRASH, ABC_FUNC_AIG );
+    vObjs = Vec_PtrAlloc( 1 + nCis + nObjs );
+    Vec_PtrPush( vObjs, Abc_AigConst1(pNtkNew) );
+    Abc_NtkForEachCi( pNtkNew, pObj, i )
+        Vec_PtrPush( vObjs, pObj );
+    // restore the nodes (the fanin literals should precede the node)
+    Vec_IntFreeP( &p->vFresh );
+    p->vFresh = Vec_IntAlloc( 0 );
+    for ( i = 0; i < nObjs && !fBad; i++ )
+    {
+        iVar   = 1 + nCis + i;
+        Delta  = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+        Diff   = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+        fFresh = Delta & 1;
+        Lit0   = 2 * iVar - (Delta >> 1);
+        Lit1   = Lit0 - Diff;
+        if ( fBad || (Delta >> 1) == 0 || (Delta >> 1) > 2 * iVar || Lit1 < 0 )
+        {
+            fBad = 1;
+            break;
+        }
+        pFanin0 = Abc_ObjNotCond( (Abc_Obj_t *)Vec_PtrEntry(vObjs, Abc_Lit2Var(Lit0)), Abc_LitIsCompl(Lit0) );
+        pFanin1 = Abc_ObjNotCond( (Abc_Obj_t *)Vec_PtrEntry(vObjs, Abc_Lit2Var(Lit1)), Abc_LitIsCompl(Lit1) );
+        pObj = Abc_AigAnd( (Abc_Aig_t *)pNtkNew->pManFunc, pFanin0, pFanin1 );
+        Vec_PtrPush( vObjs, pObj );
+        if ( fFresh && !Abc_ObjIsComplement(pObj) && Abc_ObjIsNode(pObj) )
+            Vec_IntSetEntryFull( p->vFresh, Abc_ObjId(pObj), 1 );
+    }
+    // connect the COs
+    Abc_NtkForEachCo( pNtkNew, pObj, i )
+    {
+        Lit0 = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+        if ( fBad || Lit0 >= 2 * Vec_PtrSize(vObjs) )
+        {
+            fBad = 1;
+            break;
+        }
+        Abc_ObjAddFanin( pObj, Abc_ObjNotCond( (Abc_Obj_t *)Vec_PtrEntry(vObjs, Abc_Lit2Var(Lit0)), Abc_LitIsCompl(Lit0) ) );
+    }
+    // restore the order list
+    Vec_IntFreeP( &p->vList );
+    p->vList = Vec_IntAlloc( nList );
+    for ( i = 0; i < nList && !fBad; i++ )
+    {
+        iVar = Abc_NtkCkpReadInt( &pPos, pStop, &fBad );
+        if ( fBad || iVar >= Vec_PtrSize(vObjs) )
+        {
+            fBad = 1;
+            break;
+        }
+        pObj = Abc_ObjRegular( (Abc_Obj_t *)Vec_PtrEntry(vObjs, iVar) );
+        if ( Abc_ObjIsNode(pObj) )
+            Vec_IntPush( p->vList, Abc_ObjId(pObj) );
+        else if ( i < p->iCur )
+            p->iCur--;
+    }
+    Vec_PtrFree( vObjs );
+    Vec_StrFree( vBuffer );
+    if ( fBad || pPos != pStop || !Abc_NtkCheck(pNtkNew) )
+    {
+        printf( "Abc_NtkCkpResume: Checkpoint file \"%s\" is corrupted.\n", pFileName );
+        Vec_IntFreeP( &p->vList );
+        Vec_IntFreeP( &p->vFresh );
+        Abc_NtkDelete( pNtkNew );
+        return NULL;
+    }
+    if ( p->fVerbose )
+        printf( "Resumed from checkpoint \"%s\": Nodes = %d. Handled = %d. Pending = %d.\n",
+            pFileName, Abc_NtkNodeNum(pNtkNew), p->iCur, Vec_IntSize(p->vList) - p->iCur );
+    return pNtkNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Restores the order list of the network.]
+
+  Description [Returns 0 if there is no checkpoint to resume from.
+  Otherwise, fills the list, marks the nodes before the current iterator
+  as handled (if the levels are updated), points the current iterator
+  to the first pending node, and restores the counters.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkCkpRestoreList( Abc_Ckp_t * p, Abc_Ntk_t * pNtk, int fUpdateLevel, int * piNode, int * pnNodes, int * pnRewritten, int * pnNodesBeg )
+{
+    List_Ptr_t * oList = Abc_AigGetOList( (Abc_Aig_t *)pNtk->pManFunc );
+    Abc_Obj_t * pObj;
+    int i;
+    if ( p == NULL || p->vList == NULL )
+        return 0;
+    oList->pCurItera = NULL;
+    Abc_NtkForEachObjVec( p->vList, pNtk, pObj, i )
+    {
+        if ( pObj->oLNode != NULL )
+            continue;
+        pObj->oLNode = List_PtrPushBack( oList, pObj );
+        if ( i < p->iCur )
+            Abc_ObjSetHandled( pObj, fUpdateLevel );
+        else if ( i == p->iCur )
+            oList->pCurItera = pObj->oLNode;
+    }
+    *piNode      = p->iNode;
+    *pnNodes     = p->nNodes;
+    *pnRewritten = p->nRewritten;
+    *pnNodesBeg  = p->nNodesBeg;
+    Vec_IntFreeP( &p->vList );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the node was created in the interrupted pass.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkCkpNodeIsFresh( Abc_Ckp_t * p, Abc_Obj_t * pNode )
+{
+    return p && p->vFresh && Abc_ObjId(pNode) < Vec_IntSize(p->vFresh) && Vec_IntEntry(p->vFresh, Abc_ObjId(pNode)) == 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Updates the manager after the objects are renumbered.]
+
+  Description [vMap maps the old IDs into the new ones (-1 for the deleted
+  objects).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkCkpRemapIds( Abc_Ckp_t * p, Vec_Int_t * vMap )
+{
+    Vec_Int_t * vFresh;
+    int i, fFresh;
+    if ( p == NULL || p->vFresh == NULL )
+        return;
+    vFresh = Vec_IntAlloc( Vec_IntSize(p->vFresh) );
+    Vec_IntForEachEntry( p->vFresh, fFresh, i )
+        if ( fFresh == 1 && i < Vec_IntSize(vMap) && Vec_IntEntry(vMap, i) >= 0 )
+            Vec_IntSetEntryFull( vFresh, Vec_IntEntry(vMap, i), 1 );
+    Vec_IntFree( p->vFresh );
+    p->vFresh = vFresh;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
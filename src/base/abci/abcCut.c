@@ -33,6 +33,9 @@ static void Abc_NtkPrintCuts_( void * p, Abc_Ntk_t * pNtk, int fSeq );
 
 extern int nTotal, nGood, nEqual;
 
+// the memory (in bytes per object) that the kept cuts may take
+#define ABC_CUT_KEEP_MEM  512
+
 static Vec_Int_t * Abc_NtkGetNodeAttributes( Abc_Ntk_t * pNtk );
 static int Abc_NtkComputeArea( Abc_Ntk_t * pNtk, Cut_Man_t * p );
 
@@ -529,6 +532,115 @@ void Abc_NodeFreeCuts( void * p, Abc_Obj_t * pObj )
     Cut_NodeFreeCuts( (Cut_Man_t *)p, pObj->Id );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Frees the cuts of the node and its transitive fanout.]
+
+  Description [Called when the node changes structurally, which makes
+  the cuts computed through it out of date. A cut computed through the
+  node is merged from one of its cuts, so only the fanouts whose cuts
+  contain the node or a leaf of its cuts are visited. The traversal
+  stops at the nodes without cuts, whose fanouts did not get their cuts
+  from them.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NodeFreeCutsTfo( void * p, Abc_Obj_t * pObj )
+{
+    Vec_Ptr_t * vStack;
+    Vec_Int_t * vLeaves;
+    Abc_Obj_t * pNode, * pFanout;
+    unsigned uSign;
+    int i;
+    if ( Abc_NodeReadCuts(p, pObj) == NULL )
+        return;
+    if ( Abc_ObjFanoutNum(pObj) == 0 )
+    {
+        Abc_NodeFreeCuts( p, pObj );
+        return;
+    }
+    // collect the leaves of the cuts before they are freed
+    vLeaves = Vec_IntAlloc( 16 );
+    uSign = Cut_NodeCollectLeaves( (Cut_Man_t *)p, pObj->Id, vLeaves );
+    Abc_NodeFreeCuts( p, pObj );
+    // the nodes on the stack have their cuts freed, which marks them as visited
+    vStack = Vec_PtrAlloc( 16 );
+    Vec_PtrPush( vStack, pObj );
+    while ( Vec_PtrSize(vStack) > 0 )
+    {
+        pNode = (Abc_Obj_t *)Vec_PtrPop( vStack );
+        Abc_ObjForEachFanout( pNode, pFanout, i )
+        {
+            if ( !Abc_ObjIsNode(pFanout) )
+                continue;
+            if ( !Cut_NodeCutsHaveLeaf( (Cut_Man_t *)p, pFanout->Id, vLeaves, uSign ) )
+                continue;
+            Abc_NodeFreeCuts( p, pFanout );
+            Vec_PtrPush( vStack, pFanout );
+        }
+    }
+    Vec_PtrFree( vStack );
+    Vec_IntFree( vLeaves );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Renumbers the cuts kept by the network.]
+
+  Description [vMap maps the old object IDs into the new ones.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkRemapCuts( Abc_Ntk_t * pNtk, Vec_Int_t * vMap )
+{
+    if ( pNtk->pManCut )
+        Cut_ManRemapIds( (Cut_Man_t *)pNtk->pManCut, vMap );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Frees the cuts kept by the network.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkFreeCuts( Abc_Ntk_t * pNtk )
+{
+    if ( pNtk->pManCut == NULL )
+        return;
+    Cut_ManStop( (Cut_Man_t *)pNtk->pManCut );
+    pNtk->pManCut = NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Frees the cuts kept by the network if they take too much memory.]
+
+  Description [Called at the end of the pass that keeps the cuts.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkLimitCuts( Abc_Ntk_t * pNtk )
+{
+    if ( pNtk->pManCut == NULL )
+        return;
+    if ( (double)Cut_ManReadMemUsage((Cut_Man_t *)pNtk->pManCut) > (double)ABC_CUT_KEEP_MEM * Abc_NtkObjNumMax(pNtk) )
+        Abc_NtkFreeCuts( pNtk );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes the cuts for the network.]
@@ -20,18 +20,31 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 #include "base/abc/abc.h"
 #include "bool/dec/dec.h"
 #include "opt/rwr/rwr.h"
 #include "bool/kit/kit.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
  
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
-static Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk );
 extern void        Abc_NodePrintCuts( Abc_Obj_t * pNode );
 extern void        Abc_ManShowCutCone( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
 
@@ -72,8 +85,21 @@ struct Abc_ManRes_t_
     Vec_Ptr_t        * vDivs2UP1;  // the double-node unate divisors
     Vec_Ptr_t        * vDivs2UN0;  // the double-node unate divisors
     Vec_Ptr_t        * vDivs2UN1;  // the double-node unate divisors
+    // signatures (the first 64 simulation bits) of the divisors in the above arrays
+    Vec_Wrd_t        * vSigs1UP;   // the single-node unate divisors (with complement)
+    Vec_Wrd_t        * vSigs1UN;   // the single-node unate divisors (with complement)
+    Vec_Wrd_t        * vSigs1B;    // the single-node binate divisors
+    Vec_Wrd_t        * vSigs2UP;   // the functions of the double-node unate divisors
+    Vec_Wrd_t        * vSigs2UN;   // the functions of the double-node unate divisors
+    Vec_Wec_t        * vIndex2UP;  // the double-node unate divisors by signature bits
+    Vec_Wec_t        * vIndex2UN;  // the double-node unate divisors by signature bits
+    word               uIndex2UP;  // the signature bits indexed so far
+    word               uIndex2UN;  // the signature bits indexed so far
     // other data
     Vec_Ptr_t        * vTemp;      // temporary array of nodes
+    Vec_Ptr_t        * vMffc;      // temporary array of nodes
+    Vec_Ptr_t        * vCone;      // temporary array of nodes
+    Vec_Int_t        * vRefs;      // temporary array of fanout counters
     // runtime statistics
     abctime            timeCut;
     abctime            timeTruth;
@@ -112,12 +138,16 @@ static void          Abc_ManResubStop( Abc_ManRes_t * p );
 static Dec_Graph_t * Abc_ManResubEval( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves, int nSteps, int fUpdateLevel, int fVerbose );
 static void          Abc_ManResubCleanup( Abc_ManRes_t * p );
 static void          Abc_ManResubPrint( Abc_ManRes_t * p );
+static int           Abc_ManResubMffc( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves );
 
 // other procedures
 static int           Abc_ManResubCollectDivs( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves, int Required );
 static void          Abc_ManResubSimulate( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, int nLeavesMax, int nWords );
+static void          Abc_ManResubSimulateWord( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, int nLeavesMax, int nWords );
 static void          Abc_ManResubPrintDivs( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves );
 
+static void          Abc_ManResubSigIndex( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs );
+static Vec_Int_t *   Abc_ManResubSigLookup( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs, int fCompl, word uMissing );
 static void          Abc_ManResubDivsS( Abc_ManRes_t * p, int Required );
 static void          Abc_ManResubDivsD( Abc_ManRes_t * p, int Required );
 static Dec_Graph_t * Abc_ManResubQuit( Abc_ManRes_t * p );
@@ -127,6 +157,10 @@ static Dec_Graph_t * Abc_ManResubDivs12( Abc_ManRes_t * p, int Required );
 static Dec_Graph_t * Abc_ManResubDivs2( Abc_ManRes_t * p, int Required );
 static Dec_Graph_t * Abc_ManResubDivs3( Abc_ManRes_t * p, int Required );
 
+// signatures are the first 64 bits of simulation info (32 bits if the window has 5 or less leaves);
+// a candidate whose signature does not match the root is skipped without looking at the full info
+static inline word   Abc_ManResubSig( Abc_ManRes_t * p, unsigned * pInfo ) { return p->nWords == 1 ? (word)pInfo[0] : *(word *)pInfo; }
+
 static Vec_Ptr_t *   Abc_CutFactorLarge( Abc_Obj_t * pNode, int nLeavesMax );
 static int           Abc_CutVolumeCheck( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
 
@@ -141,10 +175,14 @@ struct Abc_ManRef_t_
     Vec_Ptr_t *      vVars;             // truth tables
     Vec_Ptr_t *      vFuncs;            // functions
     Vec_Int_t *      vMemory;           // memory
+    Kit_GraphCache_t * pCache;          // factored forms of the computed functions
     Vec_Str_t *      vCube;             // temporary
     Vec_Int_t *      vForm;             // temporary
     Vec_Ptr_t *      vVisited;          // temporary
     Vec_Ptr_t *      vLeaves;           // temporary
+    Vec_Ptr_t *      vMffc;             // temporary
+    Vec_Ptr_t *      vCone;             // temporary
+    Vec_Int_t *      vRefs;             // temporary
     int              nLastGain;
     int              nNodesConsidered;
     int              nNodesRefactored;
@@ -161,6 +199,57 @@ struct Abc_ManRef_t_
     abctime          timeNtk;
     abctime          timeTotal;
 };   
+
+#define ABC_ORCH_CACHE_LEVELS  4   // the depth of the cone hashed into the cache key
+#define ABC_ORCH_CACHE_PARS   10   // the number of parameters saved with the cache
+
+typedef struct Abc_OrchCache_t_ Abc_OrchCache_t;
+struct Abc_OrchCache_t_
+{
+    int              Params[ABC_ORCH_CACHE_PARS]; // the parameters the gains were computed with
+    Vec_Mem_t *      vKeys;             // structural hashes of the node cones
+    Vec_Int_t *      vGains;            // rewrite/resub/refactor gains of each cone
+    Vec_Int_t *      vCone;             // temporary
+    Vec_Ptr_t *      vVisited;          // temporary
+    int              nLoaded;
+    int              nLookups;
+    int              nHits;
+    int              nSkips;
+};
+
+#define ABC_ORCH_DEC_RAND      0   // decision codes: -1 = none, 0 = rewrite, 1 = resub, 2 = refactor
+#define ABC_ORCH_DEC_SA        1   // decision codes: -1 = none, 0 = rewrite, 2 = resub, 3 = refactor
+
+typedef struct Abc_OrchDec_t_ Abc_OrchDec_t;
+struct Abc_OrchDec_t_
+{
+    int              nDecs;             // the number of decisions (one per object ID)
+    int              Encoding;          // the decision codes used by the recording
+    int              fUseZeros_rwr;     // the zero-cost setting of rewriting in the recording
+    int              fUseZeros_ref;     // the zero-cost setting of refactoring in the recording
+    signed char *    pDecs;             // the decisions
+    void *           pMap;              // the mapped file
+    size_t           nMapSize;          // the size of the mapped file
+};
+
+// the rewriting candidate of the node is evaluated by a helper thread while
+// the main thread evaluates refactoring and resubstitution of the same node;
+// neither evaluation modifies the network (see Rwr_NodeRewriteSpec())
+typedef struct Abc_OrchRwr_t_ Abc_OrchRwr_t;
+struct Abc_OrchRwr_t_
+{
+    Rwr_Man_t *      pManRwr;           // the rewriting manager of the helper thread
+    Rwr_Spec_t       Spec;              // the node being evaluated
+#ifdef ABC_USE_PTHREADS
+    pthread_t        Thread;            // the helper thread
+    pthread_mutex_t  Mutex;             // the barrier of the two threads
+    pthread_cond_t   Cond;
+    int              nWaiting;          // the number of threads at the barrier
+    int              Phase;             // the number of passed barriers
+    int              fStop;             // the helper thread should exit
+#endif
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -188,7 +277,7 @@ int Abc_NtkRewrite3( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rw, int fUpdateLevel, i
     if ( fUpdateLevel )
         Abc_NtkStartReverseLevels( pNtk, 0 );
 clk = Abc_Clock();
-    pManCut = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCut = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCut;
 
@@ -255,10 +344,10 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
     if ( fVeryVerbose )
         Rwr_ScoresReport( pManRwr );
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCut );
-    pNtk->pManCut = NULL;
+    // keep the cuts for the next pass unless they are too large (they are renumbered with the nodes)
 
     {
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
     }
     if ( fUpdateLevel )
@@ -274,30 +363,6 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
     return 1;
 }
 
-Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk )
-{
-    static Cut_Params_t Params, * pParams = &Params;
-    Cut_Man_t * pManCut;
-    Abc_Obj_t * pObj;
-    int i;
-    memset( pParams, 0, sizeof(Cut_Params_t) );
-    pParams->nVarsMax  = 4;     // the max cut size ("k" of the k-feasible cuts)
-    pParams->nKeepMax  = 250;   // the max number of cuts kept at a node
-    pParams->fTruth    = 1;     // compute truth tables
-    pParams->fFilter   = 1;     // filter dominated cuts
-    pParams->fSeq      = 0;     // compute sequential cuts
-    pParams->fDrop     = 0;     // drop cuts on the fly
-    pParams->fVerbose  = 0;     // the verbosiness flag
-    pParams->nIdsMax   = Abc_NtkObjNumMax( pNtk );
-    pManCut = Cut_ManStart( pParams );
-    if ( pParams->fDrop )
-        Cut_ManSetFanoutCounts( pManCut, Abc_NtkFanoutCounts(pNtk) );
-    Abc_NtkForEachCi( pNtk, pObj, i )
-        if ( Abc_ObjFanoutNum(pObj) > 0 )
-            Cut_NodeSetTriv( pManCut, pObj->Id );
-    return pManCut;
-}
-
 /******Function******************************************
  Refactor
 ********************************************************/
@@ -380,23 +445,22 @@ p->timeTru += Abc_Clock() - clk;
         return NULL;
     if ( Abc_NodeConeIsConst0_1(pTruth, nVars) || Abc_NodeConeIsConst1_1(pTruth, nVars) )
     {
-        p->nLastGain = Abc_NodeMffcSize( pNode );
+        p->nLastGain = Abc_NodeMffcCollectAig( pNode, NULL, p->vMffc, p->vCone, p->vRefs );
         p->nNodesGained += p->nLastGain;
         p->nNodesRefactored++;
         return Abc_NodeConeIsConst0_1(pTruth, nVars) ? Dec_GraphCreateConst0() : Dec_GraphCreateConst1();
     }
 clk = Abc_Clock();
-    pFForm = (Dec_Graph_t *)Kit_TruthToGraph( (unsigned *)pTruth, nVars, p->vMemory );
+    pFForm = (Dec_Graph_t *)Kit_TruthToGraphCache( p->pCache, (unsigned *)pTruth, nVars, p->vMemory );
 p->timeFact += Abc_Clock() - clk;
-    Vec_PtrForEachEntry( Abc_Obj_t *, vFanins, pFanin, i )
-        pFanin->vFanouts.nSize++;
+    // label MFFC with current ID (the fanout counters are not modified because
+    // the rewriting candidate of the node may be evaluated at the same time)
+    nNodesSaved = Abc_NodeMffcCollectAig( pNode, vFanins, p->vMffc, p->vCone, p->vRefs );
     Abc_NtkIncrementTravId( pNode->pNtk );
-    nNodesSaved = Abc_NodeMffcLabelAig( pNode );
+    Vec_PtrForEachEntry( Abc_Obj_t *, p->vMffc, pFanin, i )
+        Abc_NodeSetTravIdCurrent( pFanin );
     Vec_PtrForEachEntry( Abc_Obj_t *, vFanins, pFanin, i )
-    {
-        pFanin->vFanouts.nSize--;
         Dec_GraphNode(pFForm, i)->pFunc = pFanin;
-    }
 clk = Abc_Clock();
     nNodesAdded = Dec_GraphToNetworkCount( pNode, pFForm, nNodesSaved, Required );
 p->timeEval += Abc_Clock() - clk;
@@ -432,12 +496,16 @@ Abc_ManRef_t * Abc_NtkManRefStart_1( int nNodeSizeMax, int nConeSizeMax, int fUs
     memset( p, 0, sizeof(Abc_ManRef_t) );
     p->vCube        = Vec_StrAlloc( 100 );
     p->vVisited     = Vec_PtrAlloc( 100 );
+    p->vMffc        = Vec_PtrAlloc( 100 );
+    p->vCone        = Vec_PtrAlloc( 100 );
+    p->vRefs        = Vec_IntAlloc( 100 );
     p->nNodeSizeMax = nNodeSizeMax;
     p->nConeSizeMax = nConeSizeMax;
     p->fVerbose     = fVerbose;
     p->vVars        = Vec_PtrAllocTruthTables( Abc_MaxInt(nNodeSizeMax, 6) );
     p->vFuncs       = Vec_PtrAlloc( 100 );
     p->vMemory      = Vec_IntAlloc( 1 << 16 );
+    p->pCache       = Kit_GraphCacheStart( nNodeSizeMax, 1 << 22 );
     return p;
 }
 
@@ -445,8 +513,12 @@ void Abc_NtkManRefStop_1( Abc_ManRef_t * p )
 {   
     Vec_PtrFreeFree( p->vFuncs );
     Vec_PtrFree( p->vVars );
+    Kit_GraphCacheStop( p->pCache );
     Vec_IntFree( p->vMemory );
     Vec_PtrFree( p->vVisited );
+    Vec_PtrFree( p->vMffc );
+    Vec_PtrFree( p->vCone );
+    Vec_IntFree( p->vRefs );
     Vec_StrFree( p->vCube );
     ABC_FREE( p );
 }
@@ -457,6 +529,7 @@ void Abc_NtkManRefPrintStats_1( Abc_ManRef_t * p )
     printf( "Nodes considered  = %8d.\n", p->nNodesConsidered );
     printf( "Nodes refactored  = %8d.\n", p->nNodesRefactored );
     printf( "Gain              = %8d. (%6.2f %%).\n", p->nNodesBeg-p->nNodesEnd, 100.0*(p->nNodesBeg-p->nNodesEnd)/p->nNodesBeg );
+    Kit_GraphCachePrintStats( p->pCache );
     ABC_PRT( "Cuts       ", p->timeCut );
     ABC_PRT( "Resynthesis", p->timeRes );
     ABC_PRT( "    BDD    ", p->timeTru );
@@ -779,7 +852,17 @@ Abc_ManRes_t * Abc_ManResubStart( int nLeavesMax, int nDivsMax )
     p->vDivs2UP1 = Vec_PtrAlloc( p->nDivsMax );
     p->vDivs2UN0 = Vec_PtrAlloc( p->nDivsMax );
     p->vDivs2UN1 = Vec_PtrAlloc( p->nDivsMax );
+    p->vSigs1UP  = Vec_WrdAlloc( p->nDivsMax );
+    p->vSigs1UN  = Vec_WrdAlloc( p->nDivsMax );
+    p->vSigs1B   = Vec_WrdAlloc( p->nDivsMax );
+    p->vSigs2UP  = Vec_WrdAlloc( ABC_RS_DIV2_MAX + 4 );
+    p->vSigs2UN  = Vec_WrdAlloc( ABC_RS_DIV2_MAX + 4 );
+    p->vIndex2UP = Vec_WecStart( 65 );
+    p->vIndex2UN = Vec_WecStart( 65 );
     p->vTemp     = Vec_PtrAlloc( p->nDivsMax );
+    p->vMffc     = Vec_PtrAlloc( p->nDivsMax );
+    p->vCone     = Vec_PtrAlloc( p->nDivsMax );
+    p->vRefs     = Vec_IntAlloc( p->nDivsMax );
     return p;
 }
 
@@ -805,7 +888,17 @@ void Abc_ManResubStop( Abc_ManRes_t * p )
     Vec_PtrFree( p->vDivs2UP1 );
     Vec_PtrFree( p->vDivs2UN0 );
     Vec_PtrFree( p->vDivs2UN1 );
+    Vec_WrdFree( p->vSigs1UP );
+    Vec_WrdFree( p->vSigs1UN );
+    Vec_WrdFree( p->vSigs1B );
+    Vec_WrdFree( p->vSigs2UP );
+    Vec_WrdFree( p->vSigs2UN );
+    Vec_WecFree( p->vIndex2UP );
+    Vec_WecFree( p->vIndex2UN );
     Vec_PtrFree( p->vTemp );
+    Vec_PtrFree( p->vMffc );
+    Vec_PtrFree( p->vCone );
+    Vec_IntFree( p->vRefs );
     ABC_FREE( p->pInfo );
     ABC_FREE( p );
 }
@@ -1013,11 +1106,56 @@ void Abc_ManResubPrintDivs( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLe
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Performs simulation 64 bits at a time.]
+
+  Description [Normalizes the info of each node right after computing it.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ManResubSimulateWord( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, int nLeavesMax, int nWords )
+{
+    Abc_Obj_t * pObj, * pFanin0, * pFanin1;
+    word * pData0, * pData1, * pData, Mask0, Mask1, MaskR;
+    int i, k, Phase0, Phase1;
+    Vec_PtrForEachEntry( Abc_Obj_t *, vDivs, pObj, i )
+    {
+        if ( i < nLeaves )
+        { // initialize the leaf (elementary info is zero in the first minterm)
+            pObj->pData  = Vec_PtrEntry( vSims, i );
+            pObj->fPhase = 0;
+            continue;
+        }
+        // set storage for the node's simulation info
+        pObj->pData = Vec_PtrEntry( vSims, i - nLeaves + nLeavesMax );
+        pFanin0 = Abc_ObjFanin0(pObj);
+        pFanin1 = Abc_ObjFanin1(pObj);
+        pData   = (word *)pObj->pData;
+        pData0  = (word *)pFanin0->pData;
+        pData1  = (word *)pFanin1->pData;
+        // the fanin info is already normalized, so its phase is added to the edge complement
+        Phase0  = Abc_ObjFaninC0(pObj) ^ pFanin0->fPhase;
+        Phase1  = Abc_ObjFaninC1(pObj) ^ pFanin1->fPhase;
+        // the node is normalized as soon as it is simulated
+        pObj->fPhase = (Phase0 ^ (int)(pData0[0] & 1)) & (Phase1 ^ (int)(pData1[0] & 1));
+        Mask0   = Phase0 ? ~(word)0 : 0;
+        Mask1   = Phase1 ? ~(word)0 : 0;
+        MaskR   = pObj->fPhase ? ~(word)0 : 0;
+        for ( k = 0; k < nWords; k++ )
+            pData[k] = ((pData0[k] ^ Mask0) & (pData1[k] ^ Mask1)) ^ MaskR;
+    }
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs simulation.]
 
-  Description []
+  Description [Simulates the divisors and normalizes their info so that
+  it is zero in the first minterm, recording the phase in fPhase.]
                
   SideEffects []
 
@@ -1030,6 +1168,13 @@ void Abc_ManResubSimulate( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, in
     unsigned * puData0, * puData1, * puData;
     int i, k;
     assert( Vec_PtrSize(vDivs) - nLeaves <= Vec_PtrSize(vSims) - nLeavesMax );
+    // the info of windows with more than 5 leaves is simulated 64 bits at a time
+    if ( nWords > 1 )
+    {
+        assert( nWords % 2 == 0 );
+        Abc_ManResubSimulateWord( vDivs, nLeaves, vSims, nLeavesMax, nWords / 2 );
+        return;
+    }
     // simulate
     Vec_PtrForEachEntry( Abc_Obj_t *, vDivs, pObj, i )
     {
@@ -1289,6 +1434,73 @@ Dec_Graph_t * Abc_ManResubQuit3_1( Abc_Obj_t * pRoot, Abc_Obj_t * pObj0, Abc_Obj
 
 
 
+/**Function*************************************************************
+
+  Synopsis    [Starts indexing the divisors by the bits of their signatures.]
+
+  Description [Level b < 64 of the index lists the divisors whose signature 
+  has bit b set (or clear, for the complemented lookups). These levels are 
+  filled on demand, when the bit is looked up for the first time, and the 
+  bits filled so far are recorded in puIndexed. Level 64 lists all divisors.
+  The lists are in the order of the divisors.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ManResubSigIndex( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs )
+{
+    int b;
+    for ( b = 0; *puIndexed; b++, *puIndexed >>= 1 )
+        if ( *puIndexed & 1 )
+            Vec_IntClear( Vec_WecEntry(vIndex, b) );
+    Vec_IntClear( Vec_WecEntry(vIndex, 64) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the shortest list of candidates having the missing bits.]
+
+  Description [A divisor completes the function only if its signature has 
+  all bits of uMissing, so it is enough to look at the divisors indexed by 
+  any one of them.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Abc_ManResubSigLookup( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs, int fCompl, word uMissing )
+{
+    Vec_Int_t * vBest = NULL;
+    word uSig, uBits = uMissing & *puIndexed;
+    int b, i;
+    // all divisors are candidates if nothing is missing
+    if ( uMissing == 0 )
+    {
+        vBest = Vec_WecEntry( vIndex, 64 );
+        if ( Vec_IntSize(vBest) < Vec_WrdSize(vSigs) )
+            Vec_IntFillNatural( vBest, Vec_WrdSize(vSigs) );
+        return vBest;
+    }
+    // index one more bit if none of the missing bits is indexed yet
+    if ( uBits == 0 )
+    {
+        for ( b = 0; !((uMissing >> b) & 1); b++ );
+        Vec_WrdForEachEntry( vSigs, uSig, i )
+            if ( ((fCompl ? ~uSig : uSig) >> b) & 1 )
+                Vec_WecPush( vIndex, b, i );
+        *puIndexed |= ((word)1 << b);
+        return Vec_WecEntry( vIndex, b );
+    }
+    // otherwise, take the shortest list among the indexed ones
+    for ( b = 0; uBits; b++, uBits >>= 1 )
+        if ( (uBits & 1) && (vBest == NULL || Vec_WecLevelSize(vIndex, b) < Vec_IntSize(vBest)) )
+            vBest = Vec_WecEntry( vIndex, b );
+    return vBest;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Derives single-node unate/binate divisors.]
@@ -1305,10 +1517,14 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
     int fMoreDivs = 1; // bug fix by Siang-Yun Lee
     Abc_Obj_t * pObj;
     unsigned * puData, * puDataR;
+    word uSig;
     int i, w;
     Vec_PtrClear( p->vDivs1UP );
     Vec_PtrClear( p->vDivs1UN );
     Vec_PtrClear( p->vDivs1B );
+    Vec_WrdClear( p->vSigs1UP );
+    Vec_WrdClear( p->vSigs1UN );
+    Vec_WrdClear( p->vSigs1B );
     puDataR = (unsigned *)p->pRoot->pData;
     Vec_PtrForEachEntryStop( Abc_Obj_t *, p->vDivs, pObj, i, p->nDivs )
     {
@@ -1316,6 +1532,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
             continue;
 
         puData = (unsigned *)pObj->pData;
+        uSig   = Abc_ManResubSig( p, puData );
         // check positive containment
         for ( w = 0; w < p->nWords; w++ )
 //            if ( puData[w] & ~puDataR[w] )
@@ -1324,6 +1541,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
         if ( w == p->nWords )
         {
             Vec_PtrPush( p->vDivs1UP, pObj );
+            Vec_WrdPush( p->vSigs1UP, uSig );
             continue;
         }
         if ( fMoreDivs )
@@ -1335,6 +1553,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
             if ( w == p->nWords )
             {
                 Vec_PtrPush( p->vDivs1UP, Abc_ObjNot(pObj) );
+                Vec_WrdPush( p->vSigs1UP, ~uSig );
                 continue;
             }
         }
@@ -1346,6 +1565,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
         if ( w == p->nWords )
         {
             Vec_PtrPush( p->vDivs1UN, pObj );
+            Vec_WrdPush( p->vSigs1UN, uSig );
             continue;
         }
         if ( fMoreDivs )
@@ -1357,11 +1577,13 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
             if ( w == p->nWords )
             {
                 Vec_PtrPush( p->vDivs1UN, Abc_ObjNot(pObj) );
+                Vec_WrdPush( p->vSigs1UN, ~uSig );
                 continue;
             }
         }
         // add the node to binates
         Vec_PtrPush( p->vDivs1B, pObj );
+        Vec_WrdPush( p->vSigs1B, uSig );
     }
 }
 
@@ -1380,109 +1602,152 @@ void Abc_ManResubDivsD( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1;
     unsigned * puData0, * puData1, * puDataR;
+    word uSig0, uSig1, uSigR, uSigC;
     int i, k, w;
     Vec_PtrClear( p->vDivs2UP0 );
     Vec_PtrClear( p->vDivs2UP1 );
     Vec_PtrClear( p->vDivs2UN0 );
     Vec_PtrClear( p->vDivs2UN1 );
+    Vec_WrdClear( p->vSigs2UP );
+    Vec_WrdClear( p->vSigs2UN );
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1B, pObj0, i )
     {
         if ( (int)pObj0->Level > Required - 2 )
             continue;
 
         puData0 = (unsigned *)pObj0->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1B, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1B, pObj1, k, i + 1 )
         {
             if ( (int)pObj1->Level > Required - 2 )
                 continue;
 
             puData1 = (unsigned *)pObj1->pData;
+            uSig1   = Vec_WrdEntry( p->vSigs1B, k );
 
+            // each check below is skipped if it already fails on the signatures
             if ( Vec_PtrSize(p->vDivs2UP0) < ABC_RS_DIV2_MAX )
             {
                 // get positive unate divisors
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (puData0[w] & puData1[w]) & ~puDataR[w] )
-                    if ( (puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (uSig0 & uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (puData0[w] & puData1[w]) & ~puDataR[w] )
+                        if ( (puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UP, uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (~puData0[w] & puData1[w]) & ~puDataR[w] )
-                    if ( (~puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (~uSig0 & uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (~puData0[w] & puData1[w]) & ~puDataR[w] )
+                        if ( (~puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UP, ~uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] )
-                    if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (uSig0 & ~uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] )
+                        if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UP, uSig0 & ~uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (puData0[w] | puData1[w]) & ~puDataR[w] )
-                    if ( (puData0[w] | puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (uSig0 | uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (puData0[w] | puData1[w]) & ~puDataR[w] )
+                        if ( (puData0[w] | puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UP, uSig0 | uSig1 );
+                    }
                 }
             }
 
             if ( Vec_PtrSize(p->vDivs2UN0) < ABC_RS_DIV2_MAX )
             {
                 // get negative unate divisors
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(puData0[w] & puData1[w]) & puDataR[w] )
-                    if ( ~(puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(uSig0 & uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(puData0[w] & puData1[w]) & puDataR[w] )
+                        if ( ~(puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UN, uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(~puData0[w] & puData1[w]) & puDataR[w] )
-                    if ( ~(~puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(~uSig0 & uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(~puData0[w] & puData1[w]) & puDataR[w] )
+                        if ( ~(~puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UN, ~uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] )
-                    if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(uSig0 & ~uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] )
+                        if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UN, uSig0 & ~uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(puData0[w] | puData1[w]) & puDataR[w] )
-                    if ( ~(puData0[w] | puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(uSig0 | uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(puData0[w] | puData1[w]) & puDataR[w] )
+                        if ( ~(puData0[w] | puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UN, uSig0 | uSig1 );
+                    }
                 }
             }
         }
     }
 //    printf( "%d %d  ", Vec_PtrSize(p->vDivs2UP0), Vec_PtrSize(p->vDivs2UN0) );
+    // start indexing the pairs by the minterms they cover (or leave out)
+    Abc_ManResubSigIndex( p->vIndex2UP, &p->uIndex2UP, p->vSigs2UP );
+    Abc_ManResubSigIndex( p->vIndex2UN, &p->uIndex2UN, p->vSigs2UN );
 }
 
 
@@ -1563,14 +1828,20 @@ Dec_Graph_t * Abc_ManResubDivs1( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1;
     unsigned * puData0, * puData1, * puDataR;
+    word uSig0, uSigR, uSigC;
     int i, k, w;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UP, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1UP, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UP, pObj1, k, i + 1 )
         {
+            if ( ((uSig0 | Vec_WrdEntry(p->vSigs1UP, k)) ^ uSigR) & uSigC )
+                continue;
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
             if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) )
             {
@@ -1611,8 +1882,12 @@ Dec_Graph_t * Abc_ManResubDivs1( Abc_ManRes_t * p, int Required )
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UN, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        // the checks below end up using the first divisor without its complement
+        uSig0   = Abc_ManResubSig( p, puData0 );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UN, pObj1, k, i + 1 )
         {
+            if ( ((uSig0 & Vec_WrdEntry(p->vSigs1UN, k)) ^ uSigR) & uSigC )
+                continue;
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
             if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) )
             {
@@ -1667,17 +1942,24 @@ Dec_Graph_t * Abc_ManResubDivs12( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1, * pObj2, * pObjMax, * pObjMin0 = NULL, * pObjMin1 = NULL;
     unsigned * puData0, * puData1, * puData2, * puDataR;
+    word uSig0, uSig1, uSigR, uSigC;
     int i, k, j, w, LevelMax;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UP, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1UP, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UP, pObj1, k, i + 1 )
         {
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
+            uSig1   = uSig0 | Vec_WrdEntry( p->vSigs1UP, k );
             Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UP, pObj2, j, k + 1 )
             {
+                if ( ((uSig1 | Vec_WrdEntry(p->vSigs1UP, j)) ^ uSigR) & uSigC )
+                    continue;
                 puData2 = (unsigned *)Abc_ObjRegular(pObj2)->pData;
                 if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) && Abc_ObjIsComplement(pObj2) )
                 {
@@ -1767,11 +2049,15 @@ Dec_Graph_t * Abc_ManResubDivs12( Abc_ManRes_t * p, int Required )
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UN, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1UN, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UN, pObj1, k, i + 1 )
         {
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
+            uSig1   = uSig0 & Vec_WrdEntry( p->vSigs1UN, k );
             Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UN, pObj2, j, k + 1 )
             {
+                if ( ((uSig1 & Vec_WrdEntry(p->vSigs1UN, j)) ^ uSigR) & uSigC )
+                    continue;
                 puData2 = (unsigned *)Abc_ObjRegular(pObj2)->pData;
                 if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) && Abc_ObjIsComplement(pObj2) )
                 {
@@ -1875,14 +2161,25 @@ Dec_Graph_t * Abc_ManResubDivs2( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1, * pObj2;
     unsigned * puData0, * puData1, * puData2, * puDataR;
-    int i, k, w;
+    Vec_Int_t * vCands;
+    word * pSigs, uSig0, uSigR, uSigC;
+    int i, k, j, w;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UP, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
-        Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs2UP0, pObj1, k )
+        uSig0   = Vec_WrdEntry( p->vSigs1UP, i );
+        // only the pairs covering the minterms missing in the divisor are considered
+        vCands  = Abc_ManResubSigLookup( p->vIndex2UP, &p->uIndex2UP, p->vSigs2UP, 0, uSigR & uSigC & ~uSig0 );
+        pSigs   = Vec_WrdArray( p->vSigs2UP );
+        Vec_IntForEachEntry( vCands, k, j )
         {
+            if ( ((uSig0 | pSigs[k]) ^ uSigR) & uSigC )
+                continue;
+            pObj1 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP0, k );
             pObj2 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP1, k );
 
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
@@ -1960,8 +2257,15 @@ Dec_Graph_t * Abc_ManResubDivs2( Abc_ManRes_t * p, int Required )
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UN, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
-        Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs2UN0, pObj1, k )
+        uSig0   = Vec_WrdEntry( p->vSigs1UN, i );
+        // only the pairs leaving out the minterms extra in the divisor are considered
+        vCands  = Abc_ManResubSigLookup( p->vIndex2UN, &p->uIndex2UN, p->vSigs2UN, 1, ~uSigR & uSigC & uSig0 );
+        pSigs   = Vec_WrdArray( p->vSigs2UN );
+        Vec_IntForEachEntry( vCands, k, j )
         {
+            if ( ((uSig0 & pSigs[k]) ^ uSigR) & uSigC )
+                continue;
+            pObj1 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UN0, k );
             pObj2 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UN1, k );
 
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
@@ -2053,8 +2357,12 @@ Dec_Graph_t * Abc_ManResubDivs3( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1, * pObj2, * pObj3;
     unsigned * puData0, * puData1, * puData2, * puData3, * puDataR;
-    int i, k, w = 0, Flag;
+    Vec_Int_t * vCands;
+    word * pSigs, uSig0, uSigR, uSigC;
+    int i, k, j, w = 0, Flag;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs2UP0, pObj0, i )
     {
@@ -2062,9 +2370,16 @@ Dec_Graph_t * Abc_ManResubDivs3( Abc_ManRes_t * p, int Required )
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
         puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
         Flag = (Abc_ObjIsComplement(pObj0) << 3) | (Abc_ObjIsComplement(pObj1) << 2);
+        uSig0 = Vec_WrdEntry( p->vSigs2UP, i );
 
-        Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs2UP0, pObj2, k, i + 1 )
+        // only the pairs covering the minterms missing in this pair are considered
+        vCands = Abc_ManResubSigLookup( p->vIndex2UP, &p->uIndex2UP, p->vSigs2UP, 0, uSigR & uSigC & ~uSig0 );
+        pSigs  = Vec_WrdArray( p->vSigs2UP );
+        Vec_IntForEachEntry( vCands, k, j )
         {
+            if ( k <= i || (((uSig0 | pSigs[k]) ^ uSigR) & uSigC) )
+                continue;
+            pObj2 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP0, k );
             pObj3 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP1, k );
             puData2 = (unsigned *)Abc_ObjRegular(pObj2)->pData;
             puData3 = (unsigned *)Abc_ObjRegular(pObj3)->pData;
@@ -2318,6 +2633,44 @@ void Abc_ManResubCleanup( Abc_ManRes_t * p )
     p->pRoot = NULL;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects the internal nodes of the MFFC limited by the cut.]
+
+  Description [Same as Abc_NodeMffcInside() but does not dereference the 
+  network, so that the rewriting candidate of the node can be evaluated 
+  by another thread at the same time. The nodes are collected into 
+  p->vTemp in the same order, ending with the root.]
+               
+  SideEffects [Increments the trav ID.]
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ManResubMffc_rec( Abc_Obj_t * pNode, Vec_Ptr_t * vInside )
+{
+    Abc_Obj_t * pFanin;
+    int i;
+    Abc_NodeSetTravIdPrevious( pNode );
+    Abc_ObjForEachFanin( pNode, pFanin, i )
+        if ( Abc_NodeIsTravIdCurrent(pFanin) && !Abc_ObjIsCi(pFanin) )
+            Abc_ManResubMffc_rec( pFanin, vInside );
+    Vec_PtrPush( vInside, pNode );
+}
+int Abc_ManResubMffc( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves )
+{
+    Abc_Obj_t * pObj;
+    int i, nMffc;
+    nMffc = Abc_NodeMffcCollectAig( pRoot, vLeaves, p->vMffc, p->vCone, p->vRefs );
+    Abc_NtkIncrementTravId( pRoot->pNtk );
+    Vec_PtrForEachEntry( Abc_Obj_t *, p->vMffc, pObj, i )
+        Abc_NodeSetTravIdCurrent( pObj );
+    Vec_PtrClear( p->vTemp );
+    Abc_ManResubMffc_rec( pRoot, p->vTemp );
+    assert( Vec_PtrSize(p->vTemp) == nMffc );
+    return nMffc;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Evaluates resubstution of one cut.]
@@ -2331,7 +2684,6 @@ void Abc_ManResubCleanup( Abc_ManRes_t * p )
 ***********************************************************************/
 Dec_Graph_t * Abc_ManResubEval( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves, int nSteps, int fUpdateLevel, int fVerbose )
 {
-    extern int Abc_NodeMffcInside( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves, Vec_Ptr_t * vInside );
     Dec_Graph_t * pGraph;
     int Required;
     abctime clk;
@@ -2346,7 +2698,7 @@ Dec_Graph_t * Abc_ManResubEval( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t *
 
     // collect the MFFC
 clk = Abc_Clock();
-    p->nMffc = Abc_NodeMffcInside( pRoot, vLeaves, p->vTemp );
+    p->nMffc = Abc_ManResubMffc( p, pRoot, vLeaves );
 p->timeMffc += Abc_Clock() - clk;
     assert( p->nMffc > 0 );
 
@@ -2663,28 +3015,547 @@ Vec_Ptr_t * Abc_CutFactorLarge( Abc_Obj_t * pNode, int nLeavesMax )
 }
 
 
-int Abc_NtkOrchSA( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, Vec_Int_t **PolicyList, char * DecisionFile, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs )
+/**Function*************************************************************
+
+  Synopsis    [Starts the cache of operator gains.]
+
+  Description [The cache maps the structural hash of the bounded cone of 
+  a node into the gains of rewriting, resubstitution and refactoring of 
+  this node (-1 if the operator does not apply). The parameters are saved 
+  to make sure that the gains loaded from a file are computed the same way.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_OrchCache_t * Abc_OrchCacheStart( int * pParams )
+{
+    Abc_OrchCache_t * p;
+    p = ABC_CALLOC( Abc_OrchCache_t, 1 );
+    memcpy( p->Params, pParams, sizeof(int) * ABC_ORCH_CACHE_PARS );
+    p->vKeys    = Vec_MemAlloc( 1, 12 );
+    Vec_MemHashAlloc( p->vKeys, 1 << 12 );
+    p->vGains   = Vec_IntAlloc( 3 * (1 << 12) );
+    p->vCone    = Vec_IntAlloc( 100 );
+    p->vVisited = Vec_PtrAlloc( 100 );
+    return p;
+}
+void Abc_OrchCacheStop( Abc_OrchCache_t * p )
+{
+    Vec_MemHashFree( p->vKeys );
+    Vec_MemFree( p->vKeys );
+    Vec_IntFree( p->vGains );
+    Vec_IntFree( p->vCone );
+    Vec_PtrFree( p->vVisited );
+    ABC_FREE( p );
+}
+void Abc_OrchCachePrint( Abc_OrchCache_t * p )
+{
+    printf( "Gain cache: Loaded = %d. Entries = %d. Lookups = %d. Hits = %d. Skipped = %d. Memory = %.2f MB.\n", 
+        p->nLoaded, Vec_MemEntryNum(p->vKeys), p->nLookups, p->nHits, p->nSkips, 
+        (Vec_MemMemory(p->vKeys) + 4.0 * Vec_IntCap(p->vGains)) / (1<<20) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the cache from file.]
+
+  Description [Starts an empty cache if the file does not exist or if it 
+  was computed with different parameters.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_OrchCache_t * Abc_OrchCacheRead( char * pFileName, int * pParams )
+{
+    Abc_OrchCache_t * p = Abc_OrchCacheStart( pParams );
+    int Params[ABC_ORCH_CACHE_PARS];
+    char Buffer[8];
+    int i, nEntries = 0, RetValue = 1;
+    word * pKeys;
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+        return p;
+    RetValue &= fread( Buffer, 1, 8, pFile ) == 8 && !strncmp( Buffer, "ABCGAIN1", 8 );
+    RetValue &= fread( Params, sizeof(int), ABC_ORCH_CACHE_PARS, pFile ) == ABC_ORCH_CACHE_PARS;
+    RetValue &= fread( &nEntries, sizeof(int), 1, pFile ) == 1 && nEntries >= 0;
+    if ( !RetValue )
+    {
+        printf( "Abc_OrchCacheRead: File \"%s\" is not a gain cache. The cache is not used.\n", pFileName );
+        fclose( pFile );
+        return p;
+    }
+    if ( memcmp( Params, pParams, sizeof(int) * ABC_ORCH_CACHE_PARS ) )
+    {
+        printf( "Abc_OrchCacheRead: File \"%s\" was computed with different parameters and will be overwritten.\n", pFileName );
+        fclose( pFile );
+        return p;
+    }
+    pKeys = ABC_ALLOC( word, nEntries );
+    Vec_IntFill( p->vGains, 3 * nEntries, -1 );
+    RetValue &= (int)fread( pKeys, sizeof(word), nEntries, pFile ) == nEntries;
+    RetValue &= (int)fread( Vec_IntArray(p->vGains), sizeof(int), 3 * nEntries, pFile ) == 3 * nEntries;
+    fclose( pFile );
+    if ( !RetValue )
+    {
+        printf( "Abc_OrchCacheRead: File \"%s\" is truncated. The cache is not used.\n", pFileName );
+        Vec_IntClear( p->vGains );
+        ABC_FREE( pKeys );
+        return p;
+    }
+    for ( i = 0; i < nEntries; i++ )
+        Vec_MemHashInsert( p->vKeys, pKeys + i );
+    assert( Vec_MemEntryNum(p->vKeys) == nEntries );
+    p->nLoaded = nEntries;
+    ABC_FREE( pKeys );
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the cache into file.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_OrchCacheWrite( Abc_OrchCache_t * p, char * pFileName )
+{
+    word * pKey;
+    int i, nEntries = Vec_MemEntryNum(p->vKeys);
+    FILE * pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+    {
+        printf( "Abc_OrchCacheWrite: Cannot open file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    assert( Vec_IntSize(p->vGains) == 3 * nEntries );
+    fwrite( "ABCGAIN1", 1, 8, pFile );
+    fwrite( p->Params, sizeof(int), ABC_ORCH_CACHE_PARS, pFile );
+    fwrite( &nEntries, sizeof(int), 1, pFile );
+    Vec_MemForEachEntry( p->vKeys, pKey, i )
+        fwrite( pKey, sizeof(word), 1, pFile );
+    fwrite( Vec_IntArray(p->vGains), sizeof(int), 3 * nEntries, pFile );
+    fclose( pFile );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the structural key of the node.]
+
+  Description [Serializes the cone of the node bounded by ABC_ORCH_CACHE_LEVELS 
+  levels. The leaves are identified by the order in which they are reached, 
+  so the key does not depend on the node IDs and matches the same structure 
+  in another network. All nodes record their (saturated) fanout counts, 
+  which decide the MFFC and approximate the divisors available to resub, 
+  and the root records its level slack when the levels are preserved.
+  The key is lossy: the windows of the three operators (the rewriting cuts,
+  the refactoring cone, and the resub divisors) may extend beyond these 
+  levels, so two nodes with the same key may have different gains. A skip 
+  based on the key may therefore miss a valid operation and change QoR.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_OrchCacheCone_rec( Abc_OrchCache_t * p, Abc_Obj_t * pObj, int nLevels )
+{
+    int iLit0, iLit1, Index = Vec_PtrFind( p->vVisited, pObj );
+    if ( Index >= 0 )
+        return Index;
+    if ( Abc_AigNodeIsConst(pObj) )
+        Vec_IntPush( p->vCone, -2 );
+    else if ( nLevels == 0 || !Abc_ObjIsNode(pObj) )
+        Vec_IntPush( p->vCone, -3 - Abc_MinInt(Abc_ObjFanoutNum(pObj), 7) );
+    else
+    {
+        iLit0 = Abc_Var2Lit( Abc_OrchCacheCone_rec( p, Abc_ObjFanin0(pObj), nLevels - 1 ), Abc_ObjFaninC0(pObj) );
+        iLit1 = Abc_Var2Lit( Abc_OrchCacheCone_rec( p, Abc_ObjFanin1(pObj), nLevels - 1 ), Abc_ObjFaninC1(pObj) );
+        Vec_IntPush( p->vCone, iLit0 );
+        Vec_IntPush( p->vCone, iLit1 );
+        Vec_IntPush( p->vCone, Abc_MinInt(Abc_ObjFanoutNum(pObj), 7) );
+    }
+    Vec_PtrPush( p->vVisited, pObj );
+    return Vec_PtrSize(p->vVisited) - 1;
+}
+word Abc_OrchCacheKey( Abc_OrchCache_t * p, Abc_Obj_t * pNode, int fUpdateLevel )
+{
+    word uHash = ABC_CONST(0xCBF29CE484222325);
+    int i, Entry;
+    Vec_IntClear( p->vCone );
+    Vec_PtrClear( p->vVisited );
+    Vec_IntPush( p->vCone, fUpdateLevel ? Abc_MinInt(Abc_ObjRequiredLevel(pNode) - (int)pNode->Level, 8) : 0 );
+    Abc_OrchCacheCone_rec( p, pNode, ABC_ORCH_CACHE_LEVELS );
+    Vec_IntForEachEntry( p->vCone, Entry, i )
+        uHash = (uHash ^ (unsigned)Entry) * ABC_CONST(0x100000001B3);
+    return uHash ^ (uHash >> 29);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Looks up and records the gains of the node.]
+
+  Description [The lookup returns the three gains or NULL if the key was 
+  not loaded from the file. The gains observed in the current run are only 
+  recorded, so that the run does not depend on the order of the nodes.
+  The gains of the same cone in different contexts are merged by taking 
+  the maximum, so a node is skipped only if all its gains are negative 
+  every time its cone was evaluated.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int * Abc_OrchCacheLookup( Abc_OrchCache_t * p, word uKey )
+{
+    int * pSpot = Vec_MemHashLookup( p->vKeys, &uKey );
+    p->nLookups++;
+    if ( *pSpot == -1 || *pSpot >= p->nLoaded )
+        return NULL;
+    p->nHits++;
+    return Vec_IntEntryP( p->vGains, 3 * *pSpot );
+}
+void Abc_OrchCacheInsert( Abc_OrchCache_t * p, word uKey, int GainRwr, int GainRes, int GainRef )
+{
+    int Index = Vec_MemHashInsert( p->vKeys, &uKey );
+    if ( 3 * Index == Vec_IntSize(p->vGains) )
+        Vec_IntFillExtra( p->vGains, 3 * Index + 3, -1 );
+    Vec_IntUpdateEntry( p->vGains, 3 * Index + 0, GainRwr );
+    Vec_IntUpdateEntry( p->vGains, 3 * Index + 1, GainRes );
+    Vec_IntUpdateEntry( p->vGains, 3 * Index + 2, GainRef );
+}
+
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the orchestration decisions into file.]
+
+  Description [If the file name has extension ".dec", the decisions are 
+  written in the binary format: the 8-byte signature "ABCDEC01", four 
+  integers (the number of decisions, the encoding of the decisions, and 
+  the zero-cost flags of rewriting and refactoring), followed by one 
+  signed byte per object ID. Otherwise, one decision per line is written 
+  as text.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_OrchDecWrite( char * pFileName, Vec_Int_t * vDecs, int nDecs, int Encoding, int fUseZeros_rwr, int fUseZeros_ref )
+{
+    FILE * pFile;
+    char * pExt;
+    int i;
+    if ( pFileName == NULL )
+        return;
+    pFile = fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+    {
+        printf( "Abc_OrchDecWrite: Cannot open file \"%s\" for writing.\n", pFileName );
+        return;
+    }
+    pExt = Extra_FileNameExtension( pFileName );
+    if ( pExt && !strcmp( pExt, "dec" ) )
+    {
+        int Header[4] = { nDecs, Encoding, fUseZeros_rwr, fUseZeros_ref };
+        signed char * pDecs = ABC_ALLOC( signed char, nDecs );
+        for ( i = 0; i < nDecs; i++ )
+            pDecs[i] = (signed char)Vec_IntEntry( vDecs, i );
+        fwrite( "ABCDEC01", 1, 8, pFile );
+        fwrite( Header, sizeof(int), 4, pFile );
+        fwrite( pDecs, 1, nDecs, pFile );
+        ABC_FREE( pDecs );
+    }
+    else
+    {
+        for ( i = 0; i < nDecs; i++ )
+            fprintf( pFile, "%d\n", Vec_IntEntry( vDecs, i ) );
+    }
+    fclose( pFile );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Loads the orchestration decisions from file.]
+
+  Description [The binary files are mapped into memory and used without 
+  copying. The text files (one decision per line, as written by "aigaug") 
+  are parsed into memory and use the zero-cost flags given by the caller.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_OrchDec_t * Abc_OrchDecLoad( char * pFileName, int fUseZeros_rwr, int fUseZeros_ref )
+{
+    Abc_OrchDec_t * p;
+    char Buffer[8];
+    int Header[4], Value, nSize = 0, fBinary;
+    FILE * pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+    {
+        printf( "Abc_OrchDecLoad: Cannot open file \"%s\" for reading.\n", pFileName );
+        return NULL;
+    }
+    fBinary = fread( Buffer, 1, 8, pFile ) == 8 && !strncmp( Buffer, "ABCDEC01", 8 );
+    if ( fBinary && (fread( Header, sizeof(int), 4, pFile ) != 4 || Header[0] < 0 || 
+         (Header[1] != ABC_ORCH_DEC_RAND && Header[1] != ABC_ORCH_DEC_SA) || Extra_FileSize(pFileName) < 24 + Header[0]) )
+    {
+        printf( "Abc_OrchDecLoad: The header of file \"%s\" is corrupted.\n", pFileName );
+        fclose( pFile );
+        return NULL;
+    }
+    p = ABC_CALLOC( Abc_OrchDec_t, 1 );
+    if ( fBinary )
+    {
+        p->nDecs         = Header[0];
+        p->Encoding      = Header[1];
+        p->fUseZeros_rwr = Header[2];
+        p->fUseZeros_ref = Header[3];
+#ifndef _WIN32
+        p->nMapSize = 24 + (size_t)p->nDecs;
+        p->pMap = mmap( NULL, p->nMapSize, PROT_READ, MAP_PRIVATE, fileno(pFile), 0 );
+        if ( p->pMap != MAP_FAILED )
+            p->pDecs = (signed char *)p->pMap + 24;
+        else
+            p->pMap = NULL;
+#endif
+        if ( p->pDecs == NULL )
+        {
+            p->pDecs = ABC_ALLOC( signed char, p->nDecs );
+            if ( (int)fread( p->pDecs, 1, p->nDecs, pFile ) != p->nDecs )
+            {
+                printf( "Abc_OrchDecLoad: Cannot read the decisions from file \"%s\".\n", pFileName );
+                ABC_FREE( p->pDecs );
+                ABC_FREE( p );
+            }
+        }
+        fclose( pFile );
+        return p;
+    }
+    // parse the text file
+    rewind( pFile );
+    p->Encoding      = ABC_ORCH_DEC_RAND;
+    p->fUseZeros_rwr = fUseZeros_rwr;
+    p->fUseZeros_ref = fUseZeros_ref;
+    while ( fscanf( pFile, "%d", &Value ) == 1 )
+    {
+        if ( p->nDecs == nSize )
+        {
+            nSize = Abc_MaxInt( 2 * nSize, 1 << 10 );
+            p->pDecs = ABC_REALLOC( signed char, p->pDecs, nSize );
+        }
+        p->pDecs[p->nDecs++] = (signed char)Value;
+    }
+    fclose( pFile );
+    return p;
+}
+void Abc_OrchDecFree( Abc_OrchDec_t * p )
+{
+#ifndef _WIN32
+    if ( p->pMap )
+    {
+        munmap( p->pMap, p->nMapSize );
+        p->pDecs = NULL;
+    }
+#endif
+    ABC_FREE( p->pDecs );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the helper thread evaluating the rewriting candidates.]
+
+  Description [The thread is started once for the pass. It waits at the 
+  barrier for the next node, evaluates it, and meets the main thread 
+  again at the barrier when it is done. The thread has its own rewriting 
+  manager because the evaluation writes the leaves into the subgraphs of 
+  the manager. Without pthreads, the node is evaluated by the main thread.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+#ifdef ABC_USE_PTHREADS
+static void Abc_OrchRwrBarrier( Abc_OrchRwr_t * p )
+{
+    int Phase;
+    pthread_mutex_lock( &p->Mutex );
+    Phase = p->Phase;
+    if ( ++p->nWaiting == 2 )
+    {
+        p->nWaiting = 0;
+        p->Phase++;
+        pthread_cond_broadcast( &p->Cond );
+    }
+    else while ( Phase == p->Phase )
+        pthread_cond_wait( &p->Cond, &p->Mutex );
+    pthread_mutex_unlock( &p->Mutex );
+}
+static void * Abc_OrchRwrWorker( void * pArg )
+{
+    Abc_OrchRwr_t * p = (Abc_OrchRwr_t *)pArg;
+    while ( 1 )
+    {
+        Abc_OrchRwrBarrier( p );
+        if ( p->fStop )
+            break;
+        Rwr_NodeRewriteSpec( p->pManRwr, &p->Spec );
+        Abc_OrchRwrBarrier( p );
+    }
+    return NULL;
+}
+#endif
+Abc_OrchRwr_t * Abc_OrchRwrStart()
+{
+    Abc_OrchRwr_t * p;
+    p = ABC_CALLOC( Abc_OrchRwr_t, 1 );
+    p->pManRwr = Rwr_ManStart( 0 );
+    p->Spec.vWindow = Vec_IntAlloc( 100 );
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_init( &p->Mutex, NULL );
+    pthread_cond_init( &p->Cond, NULL );
+    {
+        int status = pthread_create( &p->Thread, NULL, Abc_OrchRwrWorker, p );
+        assert( status == 0 );
+    }
+#endif
+    return p;
+}
+void Abc_OrchRwrStop( Abc_OrchRwr_t * p, Rwr_Man_t * pManRwr )
+{
+#ifdef ABC_USE_PTHREADS
+    int status;
+    p->fStop = 1;
+    Abc_OrchRwrBarrier( p );
+    status = pthread_join( p->Thread, NULL );
+    assert( status == 0 );
+    pthread_cond_destroy( &p->Cond );
+    pthread_mutex_destroy( &p->Mutex );
+#endif
+    pManRwr->nNodesConsidered += p->pManRwr->nNodesConsidered;
+    pManRwr->nCutsGood        += p->pManRwr->nCutsGood;
+    pManRwr->nCutsBad         += p->pManRwr->nCutsBad;
+    pManRwr->nSubgraphs       += p->pManRwr->nSubgraphs;
+    Rwr_ManStop( p->pManRwr );
+    Vec_IntFree( p->Spec.vWindow );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts evaluating the rewriting candidate of the node.]
+
+  Description [The cuts and the required level are computed by the main 
+  thread. The network should not change until Abc_OrchRwrCollect() is
+  called.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_OrchRwrLaunch( Abc_OrchRwr_t * p, Rwr_Man_t * pManRwr, Cut_Man_t * pManCut, Abc_Obj_t * pNode, int fUpdateLevel )
+{
+    abctime clk = Abc_Clock();
+    p->Spec.pNode    = pNode;
+    p->Spec.Id       = pNode->Id;
+    p->Spec.pCuts    = Abc_NodeGetCutsRecursive( pManCut, pNode, 0, 0 );
+    p->Spec.Required = fUpdateLevel? Abc_ObjRequiredLevel(pNode) : ABC_INFINITY;
+    assert( p->Spec.pCuts != NULL );
+    pManRwr->timeCut += Abc_Clock() - clk;
+#ifdef ABC_USE_PTHREADS
+    Abc_OrchRwrBarrier( p );
+#else
+    Rwr_NodeRewriteSpec( p->pManRwr, &p->Spec );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Waits for the rewriting candidate of the node.]
+
+  Description [Returns the gain like Rwr_NodeRewrite() and similarly sets 
+  the graph and its leaves in the main manager.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_OrchRwrCollect( Abc_OrchRwr_t * p, Rwr_Man_t * pManRwr, int fUseZeros )
+{
+    Rwr_Spec_t * pSpec = &p->Spec;
+    int i;
+#ifdef ABC_USE_PTHREADS
+    Abc_OrchRwrBarrier( p );
+#endif
+    if ( pSpec->Gain == -1 )
+        return -1;
+    pManRwr->pGraph = pSpec->pGraph;
+    pManRwr->fCompl = pSpec->fCompl;
+    for ( i = 0; i < 4; i++ )
+        Dec_GraphNode((Dec_Graph_t *)pSpec->pGraph, i)->pFunc = pSpec->pFanins[i];
+    if ( fUseZeros || pSpec->Gain > 0 )
+        pManRwr->nNodesRewritten++;
+    pManRwr->nNodesGained += pSpec->Gain;
+    return pSpec->Gain;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the decision for the node.]
+
+  Description [Returns -1 (no update), 0 (rewrite), 1 (resub), or 2 (refactor).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Abc_OrchDecEntry( Abc_OrchDec_t * p, int Id )
+{
+    int Value = Id < p->nDecs ? (int)p->pDecs[Id] : -1;
+    if ( p->Encoding == ABC_ORCH_DEC_SA && Value > 0 )
+        Value--;
+    return Value >= 0 && Value <= 2 ? Value : -1;
+}
+
+
+int Abc_NtkOrchSA( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, Vec_Int_t **PolicyList, char * DecisionFile, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs, int fParallel )
 {
     ProgressBar * pProgress;
     // For resub
     Abc_ManRes_t * pManRes;
     Abc_ManCut_t * pManCutRes;
     Odc_Man_t * pManOdc = NULL;
-    Dec_Graph_t * pFFormRes;
+    Dec_Graph_t * pFFormRes = NULL;
     Vec_Ptr_t * vLeaves;
     // For rewrite
     Cut_Man_t * pManCutRwr;
     Rwr_Man_t * pManRwr;
+    Abc_OrchRwr_t * pOrchRwr = NULL;
     Dec_Graph_t * pGraph;
     // For refactor
     Abc_ManRef_t * pManRef;
     Abc_ManCut_t * pManCutRef;
-    Dec_Graph_t * pFFormRef;
+    Dec_Graph_t * pFFormRef = NULL;
     Vec_Ptr_t * vFanins;
     Vec_Int_t * DecisionMask = Vec_IntAlloc(1);
 
     Abc_Obj_t * pNode;
-    FILE *fpt;
     abctime clk, clkStart = Abc_Clock();
     abctime s_ResubTime;
     int i, nNodes, nGain, fCompl, RetValue = 1;
@@ -2720,12 +3591,15 @@ int Abc_NtkOrchSA( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_re
             pNode->pNext = (Abc_Obj_t *)pNode->pData;
     }
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
     if ( fVeryVerbose )
         Rwr_ScoresClean( pManRwr );
+    // the helper thread does not support placement or collect the scores
+    if ( fParallel && !fPlaceEnable && !fVeryVerbose )
+        pOrchRwr = Abc_OrchRwrStart();
 
     pManRes->nNodesBeg = Abc_NtkNodeNum(pNtk);
     pManRwr->nNodesBeg = Abc_NtkNodeNum(pNtk);
@@ -2739,11 +3613,21 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     for(int i=0; i < nNodes; i++){Vec_IntPush(DecisionMask, atoi("-1"));}
 
     pProgress = Extra_ProgressBarStart( stdout, nNodes );
-    fpt = fopen(DecisionFile, "w");
 
     Abc_NtkForEachNode( pNtk, pNode, i )
     {
         int iterNode = pNode->Id;
+        // release the candidates of the previous node, which were not used
+        if ( pFFormRes )
+        {
+            Dec_GraphFree( pFFormRes );
+            pFFormRes = NULL;
+        }
+        if ( pFFormRef )
+        {
+            Dec_GraphFree( pFFormRef );
+            pFFormRef = NULL;
+        }
         Extra_ProgressBarUpdate( pProgress, i, NULL );
         if ( Abc_NodeIsPersistant(pNode) )
         {
@@ -2763,6 +3647,9 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
         }
         if ( i >= nNodes )
             break;
+        // start evaluating rewriting while refactoring and resub are evaluated
+        if ( pOrchRwr )
+            Abc_OrchRwrLaunch( pOrchRwr, pManRwr, pManCutRwr, pNode, fUpdateLevel );
 
 //refactor
 clk = Abc_Clock();
@@ -2787,7 +3674,10 @@ clk = Abc_Clock();
 pManRes->timeRes += Abc_Clock() - clk;
         Vec_IntPush((*pGain_res), pManRes->nLastGain);
 //rewrite
-        nGain = Rwr_NodeRewrite( pManRwr, pManCutRwr, pNode, fUpdateLevel, fUseZeros_rwr, fPlaceEnable );
+        if ( pOrchRwr )
+            nGain = Abc_OrchRwrCollect( pOrchRwr, pManRwr, fUseZeros_rwr );
+        else
+            nGain = Rwr_NodeRewrite( pManRwr, pManCutRwr, pNode, fUpdateLevel, fUseZeros_rwr, fPlaceEnable );
         Vec_IntPush( (*pGain_rwr), nGain);
         //fprintf(fpt, "%d, %s, %d, %s, %d, %s, %d\n", pNode->Id, "Oches_Res", pManRes->nLastGain, "Oches_Ref", pManRef->nLastGain, "Oches_Rwr", nGain);
 
@@ -2828,6 +3718,7 @@ clk = Abc_Clock();
         Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRes );
+        pFFormRes = NULL;
         ops_res++;
         //fprintf(fpt, "%d, %d\n", iterNode, 1);
         (DecisionMask)->pArray[iterNode] = 2;
@@ -2842,11 +3733,13 @@ clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRef );
+        pFFormRef = NULL;
         ops_ref++;
         //fprintf(fpt, "%d, %d\n", iterNode, 2);
         (DecisionMask)->pArray[iterNode] = 3;
@@ -2888,11 +3781,13 @@ clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRef );
+        pFFormRef = NULL;
         ops_ref++;
         //fprintf(fpt, "%d, %d\n", iterNode, 2);
         (DecisionMask)->pArray[iterNode] = 3;
@@ -2908,6 +3803,7 @@ clk = Abc_Clock();
         Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk; 
         Dec_GraphFree( pFFormRes );
+        pFFormRes = NULL;
         ops_res++;
         //fprintf(fpt, "%d, %d\n", iterNode, 1);
         (DecisionMask)->pArray[iterNode] = 2;
@@ -2933,6 +3829,7 @@ clk = Abc_Clock();
         Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRes );
+        pFFormRes = NULL;
         ops_res++;
         //fprintf(fpt, "%d, %d\n", iterNode, 1);
         (DecisionMask)->pArray[iterNode] = 2;
@@ -2964,11 +3861,13 @@ clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRef );
+        pFFormRef = NULL;
         ops_ref++;
         //fprintf(fpt, "%d, %d\n", iterNode, 2);
         (DecisionMask)->pArray[iterNode] = 3;
@@ -2994,6 +3893,7 @@ clk = Abc_Clock();
         Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRes );
+        pFFormRes = NULL;
         ops_res++;
         //fprintf(fpt, "%d, %d\n", iterNode, 1);
         (DecisionMask)->pArray[iterNode] = 2;
@@ -3008,11 +3908,13 @@ clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRef );
+        pFFormRef = NULL;
         ops_ref++;
         //fprintf(fpt, "%d, %d\n", iterNode, 2);
         (DecisionMask)->pArray[iterNode] = 3;
@@ -3055,11 +3957,13 @@ clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRef );
+        pFFormRef = NULL;
         ops_ref++;
         //fprintf(fpt, "%d, %d\n", iterNode, 2);
         (DecisionMask)->pArray[iterNode] = 3;
@@ -3092,6 +3996,7 @@ clk = Abc_Clock();
         Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRes );
+        pFFormRes = NULL;
         ops_res++;
         //fprintf(fpt, "%d, %d\n", iterNode, 1);
         (DecisionMask)->pArray[iterNode] = 2;
@@ -3116,11 +4021,13 @@ clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRef );
+        pFFormRef = NULL;
         ops_ref++;
         //fprintf(fpt, "%d, %d\n", iterNode, 2);
         (DecisionMask)->pArray[iterNode] = 3;
@@ -3136,6 +4043,7 @@ clk = Abc_Clock();
         Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFFormRes );
+        pFFormRes = NULL;
         ops_res++;
         //fprintf(fpt, "%d, %d\n", iterNode, 1);
         (DecisionMask)->pArray[iterNode] = 2;
@@ -3167,8 +4075,10 @@ Rwr_ManAddTimeUpdate( pManRwr, Abc_Clock() - clk );
       }
 
     }
-    for (int i=0; i<nNodes; i++){fprintf(fpt, "%d\n", (DecisionMask)->pArray[i]);}
-    fclose(fpt);
+    if ( pFFormRes ) Dec_GraphFree( pFFormRes );
+    if ( pFFormRef ) Dec_GraphFree( pFFormRef );
+    if ( pOrchRwr ) Abc_OrchRwrStop( pOrchRwr, pManRwr );
+    Abc_OrchDecWrite( DecisionFile, DecisionMask, nNodes, ABC_ORCH_DEC_SA, fUseZeros_rwr, fUseZeros_ref );
     /*
     printf("size of vector %d\n", (**pGain_res).nSize);
     printf("Nodes with rewrite: %d\n", ops_rwr);
@@ -3198,8 +4108,6 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
 
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
 
    Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
@@ -3213,6 +4121,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
         Abc_NtkForEachLatch(pNtk, pNode, i)
             pNode->pData = pNode->pNext, pNode->pNext = NULL;
     }
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
     if ( fUpdateLevel )
         Abc_NtkStopReverseLevels( pNtk );
@@ -3228,25 +4138,31 @@ s_ResubTime = Abc_Clock() - clkStart;
 }
 
 // local greedy orchestration
-int Abc_NtkOrchLocal( Abc_Ntk_t * pNtk, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs )
+int Abc_NtkOrchLocal( Abc_Ntk_t * pNtk, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs, char * pCacheFile, int fParallel )
 {
     ProgressBar * pProgress;
     // For resub
     Abc_ManRes_t * pManRes;
     Abc_ManCut_t * pManCutRes;
     Odc_Man_t * pManOdc = NULL;
-    Dec_Graph_t * pFFormRes;
+    Dec_Graph_t * pFFormRes = NULL;
     //Dec_Graph_t * pFFormRef_zeros;
     Vec_Ptr_t * vLeaves;
     // For rewrite
     Cut_Man_t * pManCutRwr;
     Rwr_Man_t * pManRwr;
+    Abc_OrchRwr_t * pOrchRwr = NULL;
     Dec_Graph_t * pGraph;
     // For refactor
     Abc_ManRef_t * pManRef;
     Abc_ManCut_t * pManCutRef;
-    Dec_Graph_t * pFFormRef;
+    Dec_Graph_t * pFFormRef = NULL;
     Vec_Ptr_t * vFanins;
+    // For the gain cache
+    Abc_OrchCache_t * pCache = NULL;
+    int pCachePars[ABC_ORCH_CACHE_PARS] = { nCutMax, nStepsMax, nLevelsOdc, fUpdateLevel, fUseZeros_rwr, fUseZeros_ref, nNodeSizeMax, nConeSizeMax, fUseDcs, ABC_ORCH_CACHE_LEVELS };
+    int * pGains;
+    word uKey = 0;
 
     Abc_Obj_t * pNode;//, * pFanin;
     //int fanin_i;
@@ -3280,7 +4196,10 @@ int Abc_NtkOrchLocal( Abc_Ntk_t * pNtk, int fUseZeros_rwr, int fUseZeros_ref, in
 
     // compute the reverse levels if level update is requested
     if ( fUpdateLevel )
+    {
         Abc_NtkStartReverseLevels( pNtk, 0 );
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 1 );
+    }
 
     // 'Resub only'
     if ( Abc_NtkLatchNum(pNtk) ) {
@@ -3289,12 +4208,17 @@ int Abc_NtkOrchLocal( Abc_Ntk_t * pNtk, int fUseZeros_rwr, int fUseZeros_ref, in
     }
     // cut manager for rewrite
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
     if ( fVeryVerbose )
         Rwr_ScoresClean( pManRwr );
+    // the helper thread does not support placement or collect the scores
+    if ( fParallel && !fPlaceEnable && !fVeryVerbose )
+        pOrchRwr = Abc_OrchRwrStart();
+    if ( pCacheFile )
+        pCache = Abc_OrchCacheRead( pCacheFile, pCachePars );
 
   // resynthesize each node once
   // resub
@@ -3314,6 +4238,17 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
 
     Abc_NtkForEachNode( pNtk, pNode, i )
     {
+        // release the candidates of the previous node, which were not used
+        if ( pFFormRes )
+        {
+            Dec_GraphFree( pFFormRes );
+            pFFormRes = NULL;
+        }
+        if ( pFFormRef )
+        {
+            Dec_GraphFree( pFFormRef );
+            pFFormRef = NULL;
+        }
         //int iterNode = pNode->Id;
         //printf("Nodes ID: %d\n", pNode->Id);
         Extra_ProgressBarUpdate( pProgress, i, NULL );
@@ -3334,6 +4269,25 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
         // stop if all nodes have been tried once
         if ( i >= nNodes )
             break;
+        // flush the batched level updates if this node or its divisors may depend on them
+        if ( fUpdateLevel )
+            Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, 
+                Abc_MaxInt( Abc_ObjRequiredLevel(pNode), (int)pNode->Level + nLevelsOdc ), 0 );
+        // skip the nodes whose cone is known to have no useful transformation
+        if ( pCache )
+        {
+            uKey = Abc_OrchCacheKey( pCache, pNode, fUpdateLevel );
+            pGains = Abc_OrchCacheLookup( pCache, uKey );
+            if ( pGains && pGains[0] < 0 && pGains[1] < 0 && pGains[2] < 0 )
+            {
+                pCache->nSkips++;
+                ops_null++;
+                continue;
+            }
+        }
+        // start evaluating rewriting while refactoring and resub are evaluated
+        if ( pOrchRwr )
+            Abc_OrchRwrLaunch( pOrchRwr, pManRwr, pManCutRwr, pNode, fUpdateLevel );
         
 clk = Abc_Clock();
 
@@ -3367,7 +4321,12 @@ pManRes->timeRes += Abc_Clock() - clk;
 
 // Rewrite
         //nGain = Rwr_NodeRewrite( pManRwr, pManCutRwr, pNode, fUpdateLevel, fUseZeros, fPlaceEnable );
-        nGain = Rwr_NodeRewrite( pManRwr, pManCutRwr, pNode, fUpdateLevel, fUseZeros_rwr, fPlaceEnable );
+        if ( pOrchRwr )
+            nGain = Abc_OrchRwrCollect( pOrchRwr, pManRwr, fUseZeros_rwr );
+        else
+            nGain = Rwr_NodeRewrite( pManRwr, pManCutRwr, pNode, fUpdateLevel, fUseZeros_rwr, fPlaceEnable );
+        if ( pCache )
+            Abc_OrchCacheInsert( pCache, uKey, nGain, pFFormRes ? pManRes->nLastGain : -1, pFFormRef ? pManRef->nLastGain : -1 );
 
      // compare local reward and update
         // if (((! (nGain < 0)) && (! (nGain < pManRes->nLastGain)) && (! (pManRes->nLastGain < pManRef->nLastGain))) || ((! (nGain < 0)) && (! (nGain < pManRef->nLastGain)) && (! (pManRef->nLastGain < pManRes->nLastGain)))){
@@ -3395,6 +4354,7 @@ clk = Abc_Clock();
             Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
             Dec_GraphFree( pFFormRes );
+            pFFormRes = NULL;
             ops_res++;
             continue;
         }
@@ -3407,16 +4367,21 @@ clk = Abc_Clock();
             if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
                  {
                      Dec_GraphFree( pFFormRef );
+                     pFFormRef = NULL;
                      RetValue = -1;
                      break;
                  }
 pManRef->timeNtk += Abc_Clock() - clk;
             Dec_GraphFree( pFFormRef );
+            pFFormRef = NULL;
             ops_ref++;
             continue;
         }
         else{ops_null++; continue;}
     }
+    if ( pFFormRes ) Dec_GraphFree( pFFormRes );
+    if ( pFFormRef ) Dec_GraphFree( pFFormRef );
+    if ( pOrchRwr ) Abc_OrchRwrStop( pOrchRwr, pManRwr );
 
     /*
     printf("Nodes with rewrite: %d\n", ops_rwr);
@@ -3443,6 +4408,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
         Abc_ManResubPrint( pManRes );
         Rwr_ManPrintStats( pManRwr );
         Abc_NtkManRefPrintStats_1( pManRef );
+        if ( pCache )
+            Abc_OrchCachePrint( pCache );
     }
     if ( fVeryVerbose )
         Rwr_ScoresReport( pManRwr );
@@ -3452,13 +4419,17 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
     // rewrite
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
     // refactor
     Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
 
     if ( pManOdc ) Abc_NtkDontCareFree( pManOdc );
+    // save the gains for the later runs
+    if ( pCache )
+    {
+        Abc_OrchCacheWrite( pCache, pCacheFile );
+        Abc_OrchCacheStop( pCache );
+    }
 
     // clean the data field
     Abc_NtkForEachObj( pNtk, pNode, i )
@@ -3469,7 +4440,12 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
             pNode->pData = pNode->pNext, pNode->pNext = NULL;
     }
 
+    // flush the remaining batched level updates
+    if ( fUpdateLevel )
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 0 );
     // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
 //    Abc_AigCheckFaninOrder( pNtk->pManFunc );
 
@@ -3554,7 +4530,7 @@ int Abc_NtkOchestration( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pG
     
     // cut manager for rewrite
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
@@ -4279,8 +5255,6 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
     // rewrite
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
     // refactor
     Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
@@ -4297,6 +5271,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     }
 
     // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
 //    Abc_AigCheckFaninOrder( pNtk->pManFunc );
 
@@ -4380,7 +5356,7 @@ int Abc_NtkOchestration3( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **p
     }
     // cut manager for rewrite
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
@@ -4644,8 +5620,6 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
     // rewrite
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
     // refactor
     Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
@@ -4662,6 +5636,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     }
 
     // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
 //    Abc_AigCheckFaninOrder( pNtk->pManFunc );
 
@@ -4744,7 +5720,7 @@ int Abc_NtkOchestration2( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **p
     }
     // cut manager for rewrite
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
@@ -5041,8 +6017,6 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
     // rewrite
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
     // refactor
     Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
@@ -5059,6 +6033,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     }
 
     // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
 //    Abc_AigCheckFaninOrder( pNtk->pManFunc );
 
@@ -5140,7 +6116,7 @@ int Abc_NtkOrchGNN( Abc_Ntk_t * pNtk,  char * edgelistFile, char * featFile, int
     }
     // cut manager for rewrite
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
@@ -5282,8 +6258,6 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
     // rewrite
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
     // refactor
     Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
@@ -5300,6 +6274,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     }
 
     // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
 //    Abc_AigCheckFaninOrder( pNtk->pManFunc );
 
@@ -5319,7 +6295,7 @@ s_ResubTime = Abc_Clock() - clkStart;
 }
 
 // orchestration with sudo random decision list
-int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, Vec_Int_t **DecisionMask, char * DecisionFile, int Rand_Seed, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs )
+int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_res,Vec_Int_t **pGain_ref, Vec_Int_t **DecisionMask, char * DecisionFile, int Rand_Seed, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs, char * pCacheFile )
 {
     extern int           Dec_GraphUpdateNetwork( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain );
     ProgressBar * pProgress;
@@ -5338,9 +6314,13 @@ int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_
     Abc_ManCut_t * pManCutRef;
     Dec_Graph_t * pFFormRef;
     Vec_Ptr_t * vFanins;
+    // For the gain cache
+    Abc_OrchCache_t * pCache = NULL;
+    int pCachePars[ABC_ORCH_CACHE_PARS] = { nCutMax, nStepsMax, nLevelsOdc, fUpdateLevel, fUseZeros_rwr, fUseZeros_ref, nNodeSizeMax, nConeSizeMax, fUseDcs, ABC_ORCH_CACHE_LEVELS };
+    int * pGains;
+    word uKey = 0;
 
     Abc_Obj_t * pNode;
-    FILE *fpt;
     abctime clk, clkStart = Abc_Clock();
     int i, nNodes, nNodes_after, nGain, fCompl;
     int RetValue = 1;
@@ -5373,7 +6353,10 @@ int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_
 
     // compute the reverse levels if level update is requested
     if ( fUpdateLevel )
+    {
         Abc_NtkStartReverseLevels( pNtk, 0 );
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 1 );
+    }
 
     // 'Resub only'
     
@@ -5384,12 +6367,14 @@ int Abc_NtkOrchRand( Abc_Ntk_t * pNtk, Vec_Int_t **pGain_rwr, Vec_Int_t **pGain_
     
     // cut manager for rewrite
 clk = Abc_Clock();
-    pManCutRwr = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCutRwr;
 
     if ( fVeryVerbose )
         Rwr_ScoresClean( pManRwr );
+    if ( pCacheFile )
+        pCache = Abc_OrchCacheRead( pCacheFile, pCachePars );
 
   // resynthesize each node once
   // resub
@@ -5412,7 +6397,6 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     Vec_Int_t  *Valid_Ops = Vec_IntAlloc(1);
 
     pProgress = Extra_ProgressBarStart( stdout, nNodes );
-    fpt = fopen(DecisionFile, "w");
 
     Abc_NtkForEachNode( pNtk, pNode, i )
     {
@@ -5443,6 +6427,28 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
             Vec_IntPush((*pGain_rwr), -99);
             continue;
         }
+        // flush the batched level updates if this node or its divisors may depend on them
+        if ( fUpdateLevel )
+            Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, 
+                Abc_MaxInt( Abc_ObjRequiredLevel(pNode), (int)pNode->Level + nLevelsOdc ), 0 );
+        // skip the nodes whose cone is known to have no valid operation
+        if ( pCache )
+        {
+            uKey = Abc_OrchCacheKey( pCache, pNode, fUpdateLevel );
+            pGains = Abc_OrchCacheLookup( pCache, uKey );
+            if ( pGains && pGains[0] < 0 && pGains[1] < 0 && pGains[2] < 0 )
+            {
+                // the cached gains were measured on a node whose key matched,
+                // which does not make them the gains of this node
+                Vec_IntPush((*pGain_res), -99);
+                Vec_IntPush((*pGain_ref), -99);
+                Vec_IntPush((*pGain_rwr), -99);
+                (*DecisionMask)->pArray[iterNode] = -1;
+                pCache->nSkips++;
+                ops_null++;
+                continue;
+            }
+        }
 clk = Abc_Clock();
 
 // Generate random operation
@@ -5481,6 +6487,8 @@ clk = Abc_Clock();
 pManRef->timeRes += Abc_Clock() - clk;
 
     Vec_IntPush((*pGain_ref), pManRef->nLastGain);
+    if ( pCache )
+        Abc_OrchCacheInsert( pCache, uKey, nGain, pFFormRes ? pManRes->nLastGain : -1, pFFormRef ? pManRef->nLastGain : -1 );
     if (pManRef->nLastGain > 0 || (pManRef->nLastGain ==0 && fUseZeros_ref))
     {
          if ( pFFormRef != NULL ){
@@ -5552,10 +6560,7 @@ pManRef->timeNtk += Abc_Clock() - clk;
         continue;
       }
     }
-    //fwrite((**DecisionMask).pArray, sizeof(int), sizeof((**DecisionMask).pArray), fpt);
-    for (int i = 0; i < (nNodes); i++){
-        fprintf(fpt, "%d\n", (*DecisionMask)->pArray[i]);}
-    fclose(fpt);
+    Abc_OrchDecWrite( DecisionFile, *DecisionMask, nNodes, ABC_ORCH_DEC_RAND, fUseZeros_rwr, fUseZeros_ref );
 /*
     printf("size of vector %d\n", Valid_Len);
     printf("Nodes with rewrite: %d\n", ops_rwr);
@@ -5581,6 +6586,8 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
         Abc_ManResubPrint( pManRes );
         Rwr_ManPrintStats( pManRwr );
         Abc_NtkManRefPrintStats_1( pManRef );
+        if ( pCache )
+            Abc_OrchCachePrint( pCache );
     }
     if ( fVeryVerbose )
         Rwr_ScoresReport( pManRwr );
@@ -5590,13 +6597,17 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkManCutStop( pManCutRes );
     // rewrite
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCutRwr );
-    pNtk->pManCut = NULL;
     // refactor
     Abc_NtkManCutStop( pManCutRef );
     Abc_NtkManRefStop_1( pManRef );
 
     if ( pManOdc ) Abc_NtkDontCareFree( pManOdc );
+    // save the gains for the later runs
+    if ( pCache )
+    {
+        Abc_OrchCacheWrite( pCache, pCacheFile );
+        Abc_OrchCacheStop( pCache );
+    }
 
     // clean the data field
     Abc_NtkForEachObj( pNtk, pNode, i )
@@ -5607,7 +6618,12 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
             pNode->pData = pNode->pNext, pNode->pNext = NULL;
     }
 
+    // flush the remaining batched level updates
+    if ( fUpdateLevel )
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 0 );
     // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
     Abc_NtkReassignIds( pNtk );
 //    Abc_AigCheckFaninOrder( pNtk->pManFunc );
 
@@ -5632,6 +6648,259 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Replays the recorded orchestration decisions.]
+
+  Description [Visits the nodes in the same order as "aigaug" and applies 
+  the recorded operator to each node. Only the chosen operator is evaluated.
+  The decisions are indexed by the object IDs of the network they were 
+  recorded on, so the network should be the same.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkOrchReplay( Abc_Ntk_t * pNtk, char * pDecFile, int fUseZeros_rwr, int fUseZeros_ref, int fPlaceEnable, int nCutMax, int nStepsMax, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose, int nNodeSizeMax, int nConeSizeMax, int fUseDcs )
+{
+    ProgressBar * pProgress;
+    Abc_OrchDec_t * pDecs;
+    // For resub
+    Abc_ManRes_t * pManRes;
+    Abc_ManCut_t * pManCutRes;
+    Odc_Man_t * pManOdc = NULL;
+    Dec_Graph_t * pFFormRes;
+    Vec_Ptr_t * vLeaves;
+    // For rewrite
+    Cut_Man_t * pManCutRwr;
+    Rwr_Man_t * pManRwr;
+    Dec_Graph_t * pGraph;
+    // For refactor
+    Abc_ManRef_t * pManRef;
+    Abc_ManCut_t * pManCutRef;
+    Dec_Graph_t * pFFormRef;
+    Vec_Ptr_t * vFanins;
+
+    Abc_Obj_t * pNode;
+    abctime clk, clkStart = Abc_Clock();
+    int i, nNodes, nGain, fCompl, Decision;
+    int RetValue = 1;
+    int ops_rwr = 0;
+    int ops_res = 0;
+    int ops_ref = 0;
+    int ops_null = 0;
+    assert( Abc_NtkIsStrash(pNtk) );
+
+    // load the decisions
+    pDecs = Abc_OrchDecLoad( pDecFile, fUseZeros_rwr, fUseZeros_ref );
+    if ( pDecs == NULL )
+        return 0;
+    fUseZeros_rwr = pDecs->fUseZeros_rwr;
+    fUseZeros_ref = pDecs->fUseZeros_ref;
+
+    // cleanup the AIG
+    Abc_AigCleanup((Abc_Aig_t *)pNtk->pManFunc);
+    if ( pDecs->nDecs != Abc_NtkObjNumMax(pNtk) )
+        printf( "Warning: The decisions are recorded for %d objects while the network has %d objects.\n", pDecs->nDecs, Abc_NtkObjNumMax(pNtk) );
+
+    // start the managers resub
+    pManCutRes = Abc_NtkManCutStart( nCutMax, 100000, 100000, 100000 );
+    pManRes = Abc_ManResubStart( nCutMax, ABC_RS_DIV1_MAX );
+    if ( nLevelsOdc > 0 )
+    pManOdc = Abc_NtkDontCareAlloc( nCutMax, nLevelsOdc, fVerbose, fVeryVerbose );
+    // start the managers refactor
+    pManCutRef = Abc_NtkManCutStart( nNodeSizeMax, nConeSizeMax, 2, 1000 );
+    pManRef = Abc_NtkManRefStart_1( nNodeSizeMax, nConeSizeMax, fUseDcs, fVerbose );
+    pManRef->vLeaves   = Abc_NtkManCutReadCutLarge( pManCutRef );
+    // start the managers rewrite
+    pManRwr = Rwr_ManStart( 0 );
+    if ( pManRwr == NULL )
+    {
+        Abc_OrchDecFree( pDecs );
+        return 0;
+    }
+
+    // compute the reverse levels if level update is requested
+    if ( fUpdateLevel )
+    {
+        Abc_NtkStartReverseLevels( pNtk, 0 );
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 1 );
+    }
+
+    if ( Abc_NtkLatchNum(pNtk) ) {
+        Abc_NtkForEachLatch(pNtk, pNode, i)
+            pNode->pNext = (Abc_Obj_t *)pNode->pData;
+    }
+
+    // cut manager for rewrite
+clk = Abc_Clock();
+    pManCutRwr = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
+Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
+    pNtk->pManCut = pManCutRwr;
+
+    if ( fVeryVerbose )
+        Rwr_ScoresClean( pManRwr );
+
+    pManRes->nNodesBeg = Abc_NtkNodeNum(pNtk);
+    pManRwr->nNodesBeg = Abc_NtkNodeNum(pNtk);
+    pManRef->nNodesBeg = Abc_NtkNodeNum(pNtk);
+
+    nNodes = Abc_NtkObjNumMax(pNtk);
+    pProgress = Extra_ProgressBarStart( stdout, nNodes );
+    Abc_NtkForEachNode( pNtk, pNode, i )
+    {
+        Extra_ProgressBarUpdate( pProgress, i, NULL );
+        // stop if all nodes have been tried once
+        if ( i >= nNodes )
+            break;
+        // skip persistant nodes
+        if ( Abc_NodeIsPersistant(pNode) )
+            continue;
+        // skip the nodes with many fanouts
+        if ( Abc_ObjFanoutNum(pNode) > 1000 )
+            continue;
+        // flush the batched level updates if this node or its divisors may depend on them
+        if ( fUpdateLevel )
+            Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, 
+                Abc_MaxInt( Abc_ObjRequiredLevel(pNode), (int)pNode->Level + nLevelsOdc ), 0 );
+        Decision = Abc_OrchDecEntry( pDecs, pNode->Id );
+        if ( Decision == 0 )
+        {
+            // apply rewrite
+            nGain = Rwr_NodeRewrite( pManRwr, pManCutRwr, pNode, fUpdateLevel, fUseZeros_rwr, fPlaceEnable );
+            if ( !(nGain > 0 || (nGain == 0 && fUseZeros_rwr)) )
+            {
+                ops_null++;
+                continue;
+            }
+            pGraph = (Dec_Graph_t *)Rwr_ManReadDecs(pManRwr);
+            fCompl = Rwr_ManReadCompl(pManRwr);
+            if ( fPlaceEnable )
+                Abc_AigUpdateReset( (Abc_Aig_t *)pNtk->pManFunc );
+            if ( fCompl ) Dec_GraphComplement( pGraph );
+clk = Abc_Clock();
+            Dec_GraphUpdateNetwork( pNode, pGraph, fUpdateLevel, nGain );
+Rwr_ManAddTimeUpdate( pManRwr, Abc_Clock() - clk );
+            if ( fCompl ) Dec_GraphComplement( pGraph );
+            ops_rwr++;
+        }
+        else if ( Decision == 1 )
+        {
+            // apply resub
+clk = Abc_Clock();
+            vLeaves = Abc_NodeFindCut( pManCutRes, pNode, 0 );
+pManRes->timeCut += Abc_Clock() - clk;
+            if ( pManOdc )
+            {
+clk = Abc_Clock();
+                Abc_NtkDontCareClear( pManOdc );
+                Abc_NtkDontCareCompute( pManOdc, pNode, vLeaves, pManRes->pCareSet );
+pManRes->timeTruth += Abc_Clock() - clk;
+            }
+clk = Abc_Clock();
+            pFFormRes = Abc_ManResubEval( pManRes, pNode, vLeaves, nStepsMax, fUpdateLevel, fVerbose );
+pManRes->timeRes += Abc_Clock() - clk;
+            if ( pFFormRes == NULL || pManRes->nLastGain <= 0 )
+            {
+                if ( pFFormRes ) Dec_GraphFree( pFFormRes );
+                ops_null++;
+                continue;
+            }
+            pManRes->nTotalGain += pManRes->nLastGain;
+clk = Abc_Clock();
+            Dec_GraphUpdateNetwork( pNode, pFFormRes, fUpdateLevel, pManRes->nLastGain );
+pManRes->timeNtk += Abc_Clock() - clk;
+            Dec_GraphFree( pFFormRes );
+            ops_res++;
+        }
+        else if ( Decision == 2 )
+        {
+            // apply refactor
+clk = Abc_Clock();
+            vFanins = Abc_NodeFindCut( pManCutRef, pNode, fUseDcs );
+pManRef->timeCut += Abc_Clock() - clk;
+clk = Abc_Clock();
+            pFFormRef = Abc_NodeRefactor_1( pManRef, pNode, vFanins, fUpdateLevel, fUseZeros_ref, fUseDcs, fVerbose );
+pManRef->timeRes += Abc_Clock() - clk;
+            if ( pFFormRef == NULL )
+            {
+                ops_null++;
+                continue;
+            }
+clk = Abc_Clock();
+            if ( !Dec_GraphUpdateNetwork( pNode, pFFormRef, fUpdateLevel, pManRef->nLastGain ) )
+            {
+                Dec_GraphFree( pFFormRef );
+                RetValue = -1;
+                break;
+            }
+pManRef->timeNtk += Abc_Clock() - clk;
+            Dec_GraphFree( pFFormRef );
+            ops_ref++;
+        }
+        else
+            ops_null++;
+    }
+    Extra_ProgressBarStop( pProgress );
+    Abc_OrchDecFree( pDecs );
+
+Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
+    pManRwr->nNodesEnd = Abc_NtkNodeNum(pNtk);
+pManRes->timeTotal = Abc_Clock() - clkStart;
+    pManRes->nNodesEnd = Abc_NtkNodeNum(pNtk);
+pManRef->timeTotal = Abc_Clock() - clkStart;
+    pManRef->nNodesEnd = Abc_NtkNodeNum(pNtk);
+
+    // print statistics
+    if ( fVerbose )
+    {
+        printf( "Replayed decisions: Rewrite = %d. Resub = %d. Refactor = %d. None = %d.\n", ops_rwr, ops_res, ops_ref, ops_null );
+        Abc_ManResubPrint( pManRes );
+        Rwr_ManPrintStats( pManRwr );
+        Abc_NtkManRefPrintStats_1( pManRef );
+    }
+    if ( fVeryVerbose )
+        Rwr_ScoresReport( pManRwr );
+    // delete the managers
+    Abc_ManResubStop( pManRes );
+    Abc_NtkManCutStop( pManCutRes );
+    Rwr_ManStop( pManRwr );
+    Abc_NtkManCutStop( pManCutRef );
+    Abc_NtkManRefStop_1( pManRef );
+    if ( pManOdc ) Abc_NtkDontCareFree( pManOdc );
+
+    // clean the data field
+    Abc_NtkForEachObj( pNtk, pNode, i )
+        pNode->pData = NULL;
+
+    if ( Abc_NtkLatchNum(pNtk) ) {
+        Abc_NtkForEachLatch(pNtk, pNode, i)
+            pNode->pData = pNode->pNext, pNode->pNext = NULL;
+    }
+
+    // flush the remaining batched level updates
+    if ( fUpdateLevel )
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 0 );
+    // put the nodes into the DFS order and reassign their IDs
+    // do not keep the cuts if they are too large
+    Abc_NtkLimitCuts( pNtk );
+    Abc_NtkReassignIds( pNtk );
+
+    // fix the levels
+    if ( fUpdateLevel )
+        Abc_NtkStopReverseLevels( pNtk );
+    else
+        Abc_NtkLevel( pNtk );
+    // check
+    if ( !Abc_NtkCheck( pNtk ) )
+    {
+        printf( "Abc_NtkOrchReplay: The network check has failed.\n" );
+        return 0;
+    }
+    return RetValue;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -49,6 +49,16 @@ struct Supp_One_t_
     int              pOuts[0];      // the array of outputs
 };
 
+typedef struct Abc_ResynJob_t_ Abc_ResynJob_t;
+struct Abc_ResynJob_t_
+{
+    Abc_ResynPars_t *  pPars;         // the resynthesis parameters
+    Abc_Ntk_t *        pNtk;          // the network of the partition
+    Vec_Ptr_t *        vIns;          // the original objects feeding the partition
+    Vec_Ptr_t *        vOuts;         // the original nodes driving other partitions or COs
+    int                RetValue;      // the value returned by the engine
+};
+
 static inline int    Supp_SizeType( int nSize, int nStepSize )     { return nSize / nStepSize + ((nSize % nStepSize) > 0); }
 static inline char * Supp_OneNext( char * pPart )                  { return *((char **)pPart);                             }
 static inline void   Supp_OneSetNext( char * pPart, char * pNext ) { *((char **)pPart) = pNext;                            }
@@ -1197,6 +1207,289 @@ void Abc_NtkFraigPartitionedTime( Abc_Ntk_t * pNtk, void * pParams )
     ABC_PRT( "Partitioned fraiging time", Abc_Clock() - clk );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects the nodes in the DFS order.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkResynCollect_rec( Abc_Obj_t * pNode, Vec_Ptr_t * vNodes )
+{
+    if ( Abc_NodeIsTravIdCurrent(pNode) )
+        return;
+    Abc_NodeSetTravIdCurrent( pNode );
+    assert( Abc_ObjIsNode(pNode) );
+    Abc_NtkResynCollect_rec( Abc_ObjFanin0(pNode), vNodes );
+    Abc_NtkResynCollect_rec( Abc_ObjFanin1(pNode), vNodes );
+    Vec_PtrPush( vNodes, pNode );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Divides the AIG nodes into disjoint partitions.]
+
+  Description [The nodes are collected in the DFS order from the COs,
+  which are ordered by the smart partitioning to keep the outputs with
+  similar supports together. The DFS order is cut into chunks of nPartSize
+  nodes, so the fanins of a node belong to the same or to an earlier
+  partition. Returns the ptr-vector of ptr-vectors of nodes and records
+  the partition of each node in vPartIds.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Ptr_t * Abc_NtkResynPartition( Abc_Ntk_t * pNtk, int nPartSize, Vec_Int_t * vPartIds )
+{
+    Vec_Ptr_t * vParts, * vNodes;
+    Vec_Int_t * vOne;
+    Abc_Obj_t * pObj;
+    int i, k, iCo;
+    // the support computation relies on the topological order of IDs
+    vParts = Abc_NtkIsDfsOrdered(pNtk) ? Abc_NtkPartitionSmart( pNtk, 0, 0 ) : NULL;
+    vNodes = Vec_PtrAlloc( Abc_NtkNodeNum(pNtk) );
+    Abc_NtkIncrementTravId( pNtk );
+    Abc_NodeSetTravIdCurrent( Abc_AigConst1(pNtk) );
+    Abc_NtkForEachCi( pNtk, pObj, i )
+        Abc_NodeSetTravIdCurrent( pObj );
+    if ( vParts )
+    {
+        Vec_PtrForEachEntry( Vec_Int_t *, vParts, vOne, i )
+            Vec_IntForEachEntry( vOne, iCo, k )
+                Abc_NtkResynCollect_rec( Abc_ObjFanin0(Abc_NtkCo(pNtk, iCo)), vNodes );
+        Vec_VecFree( (Vec_Vec_t *)vParts );
+    }
+    // add the COs skipped by the smart partitioning
+    Abc_NtkForEachCo( pNtk, pObj, i )
+        Abc_NtkResynCollect_rec( Abc_ObjFanin0(pObj), vNodes );
+    // cut the order into partitions
+    vParts = Vec_PtrAlloc( Vec_PtrSize(vNodes) / nPartSize + 1 );
+    Vec_IntFill( vPartIds, Abc_NtkObjNumMax(pNtk), -1 );
+    Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
+    {
+        if ( i % nPartSize == 0 )
+            Vec_PtrPush( vParts, Vec_PtrAlloc(nPartSize) );
+        Vec_PtrPush( (Vec_Ptr_t *)Vec_PtrEntryLast(vParts), pObj );
+        Vec_IntWriteEntry( vPartIds, pObj->Id, Vec_PtrSize(vParts) - 1 );
+    }
+    Vec_PtrFree( vNodes );
+    return vParts;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the network of one partition.]
+
+  Description [The inputs of the partition are the objects outside of it
+  feeding its nodes. The outputs are the nodes having fanouts outside of
+  the partition.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_ResynJob_t * Abc_NtkResynJobStart( Abc_Ntk_t * pNtk, Vec_Ptr_t * vPart, Vec_Int_t * vPartIds, int iPart, Abc_ResynPars_t * pPars )
+{
+    Abc_ResynJob_t * pJob;
+    Abc_Obj_t * pObj, * pNext;
+    char Buffer[1000];
+    int i, k;
+    pJob = ABC_CALLOC( Abc_ResynJob_t, 1 );
+    pJob->pPars = pPars;
+    pJob->vIns  = Vec_PtrAlloc( 100 );
+    pJob->vOuts = Vec_PtrAlloc( 100 );
+    pJob->pNtk  = Abc_NtkAlloc( ABC_NTK_STRASH, ABC_FUNC_AIG, 1 );
+    sprintf( Buffer, "%s_part%d", pNtk->pName, iPart );
+    pJob->pNtk->pName = Extra_UtilStrsav( Buffer );
+    Abc_AigConst1(pNtk)->pCopy = Abc_AigConst1(pJob->pNtk);
+    // create the inputs
+    Abc_NtkIncrementTravId( pNtk );
+    Vec_PtrForEachEntry( Abc_Obj_t *, vPart, pObj, i )
+        Abc_ObjForEachFanin( pObj, pNext, k )
+        {
+            if ( Abc_AigNodeIsConst(pNext) || Vec_IntEntry(vPartIds, pNext->Id) == iPart || Abc_NodeIsTravIdCurrent(pNext) )
+                continue;
+            Abc_NodeSetTravIdCurrent( pNext );
+            pNext->pCopy = Abc_NtkCreatePi( pJob->pNtk );
+            Vec_PtrPush( pJob->vIns, pNext );
+        }
+    // create the outputs before the nodes, as in the strashed networks
+    Vec_PtrForEachEntry( Abc_Obj_t *, vPart, pObj, i )
+        Abc_ObjForEachFanout( pObj, pNext, k )
+            if ( Abc_ObjIsCo(pNext) || Vec_IntEntry(vPartIds, pNext->Id) != iPart )
+            {
+                Abc_NtkCreatePo( pJob->pNtk );
+                Vec_PtrPush( pJob->vOuts, pObj );
+                break;
+            }
+    // copy the nodes
+    Vec_PtrForEachEntry( Abc_Obj_t *, vPart, pObj, i )
+        pObj->pCopy = Abc_AigAnd( (Abc_Aig_t *)pJob->pNtk->pManFunc, Abc_ObjChild0Copy(pObj), Abc_ObjChild1Copy(pObj) );
+    Vec_PtrForEachEntry( Abc_Obj_t *, pJob->vOuts, pObj, i )
+        Abc_ObjAddFanin( Abc_NtkPo(pJob->pNtk, i), pObj->pCopy );
+    Abc_NtkAddDummyPiNames( pJob->pNtk );
+    Abc_NtkAddDummyPoNames( pJob->pNtk );
+    return pJob;
+}
+void Abc_NtkResynJobStop( Abc_ResynJob_t * pJob )
+{
+    Abc_NtkDelete( pJob->pNtk );
+    Vec_PtrFree( pJob->vIns );
+    Vec_PtrFree( pJob->vOuts );
+    ABC_FREE( pJob );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Resynthesizes one partition.]
+
+  Description [Called by the threads. The engines only modify the network
+  of the partition.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkResynJobRun( void * pArg )
+{
+    extern int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutsMax, int nNodesMax, int nMinSaved, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose );
+    Abc_ResynJob_t * pJob = (Abc_ResynJob_t *)pArg;
+    Abc_ResynPars_t * pPars = pJob->pPars;
+    if ( pPars->Engine == 0 )
+        pJob->RetValue = Abc_NtkRewrite( pJob->pNtk, pPars->fUpdateLevel, pPars->fUseZeros, 0, 0, 0, 0, 0, 0, NULL );
+    else if ( pPars->Engine == 1 )
+        pJob->RetValue = Abc_NtkRefactor( pJob->pNtk, pPars->nNodeSizeMax, pPars->nMinSaved, pPars->nConeSizeMax, pPars->fUpdateLevel, pPars->fUseZeros, pPars->fUseDcs, 0 );
+    else if ( pPars->Engine == 2 )
+        pJob->RetValue = Abc_NtkResubstitute( pJob->pNtk, pPars->nCutsMax, pPars->nNodesMax, pPars->nMinSaved, pPars->nLevelsOdc, pPars->fUpdateLevel, 0, 0 );
+    else assert( 0 );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stitches the resynthesized partitions into one AIG.]
+
+  Description [The partitions are added in the order of their derivation,
+  so the inputs of each partition are already constructed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ntk_t * Abc_NtkResynStitch( Abc_Ntk_t * pNtk, Vec_Ptr_t * vJobs )
+{
+    Abc_Ntk_t * pNtkNew;
+    Abc_ResynJob_t * pJob;
+    Vec_Ptr_t * vNodes;
+    Abc_Obj_t * pObj;
+    int i, k;
+    pNtkNew = Abc_NtkStartFrom( pNtk, ABC_NTK_STRASH, ABC_FUNC_AIG );
+    Vec_PtrForEachEntry( Abc_ResynJob_t *, vJobs, pJob, i )
+    {
+        Abc_AigConst1(pJob->pNtk)->pCopy = Abc_AigConst1(pNtkNew);
+        Abc_NtkForEachPi( pJob->pNtk, pObj, k )
+            pObj->pCopy = ((Abc_Obj_t *)Vec_PtrEntry(pJob->vIns, k))->pCopy;
+        vNodes = Abc_NtkDfs( pJob->pNtk, 0 );
+        Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, k )
+            pObj->pCopy = Abc_AigAnd( (Abc_Aig_t *)pNtkNew->pManFunc, Abc_ObjChild0Copy(pObj), Abc_ObjChild1Copy(pObj) );
+        Vec_PtrFree( vNodes );
+        Abc_NtkForEachPo( pJob->pNtk, pObj, k )
+            ((Abc_Obj_t *)Vec_PtrEntry(pJob->vOuts, k))->pCopy = Abc_ObjChild0Copy(pObj);
+    }
+    Abc_NtkFinalize( pNtk, pNtkNew );
+    Abc_AigCleanup( (Abc_Aig_t *)pNtkNew->pManFunc );
+    if ( pNtk->pExdc )
+        pNtkNew->pExdc = Abc_NtkDup( pNtk->pExdc );
+    if ( !Abc_NtkCheck( pNtkNew ) )
+    {
+        printf( "Abc_NtkResynStitch: The network check has failed.\n" );
+        Abc_NtkDelete( pNtkNew );
+        return NULL;
+    }
+    return pNtkNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs partitioned resynthesis of the AIG.]
+
+  Description [Divides the AIG into disjoint partitions with fixed
+  boundaries, applies rewriting, refactoring or resubstitution to each
+  partition in a separate thread, and stitches the results together.
+  When the levels are preserved, it is done for each partition, which
+  does not guarantee that the number of levels of the AIG is preserved.
+  Returns the new network or NULL if resynthesis has failed for some
+  partition. The original network is not modified.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ntk_t * Abc_NtkResynPartitioned( Abc_Ntk_t * pNtk, Abc_ResynPars_t * pPars )
+{
+    Abc_Frame_t * pAbc = Abc_FrameGetGlobalFrame();
+    Abc_Ntk_t * pNtkNew = NULL;
+    Abc_ResynJob_t * pJob;
+    Vec_Ptr_t * vParts, * vPart, * vJobs;
+    Vec_Int_t * vPartIds;
+    int i, nPartSize, nIns = 0, nOuts = 0, fProgress, fFailed = 0;
+    abctime clk = Abc_Clock();
+    assert( Abc_NtkIsStrash(pNtk) );
+    assert( pPars->nThreads > 0 && pPars->nThreads <= ABC_RESYN_THREADS_MAX );
+    nPartSize = pPars->nPartSize ? pPars->nPartSize : Abc_MaxInt( 1000, Abc_NtkNodeNum(pNtk) / (2 * pPars->nThreads) + 1 );
+    // derive the partitions
+    vPartIds = Vec_IntAlloc( 0 );
+    vParts = Abc_NtkResynPartition( pNtk, nPartSize, vPartIds );
+    vJobs = Vec_PtrAlloc( Vec_PtrSize(vParts) );
+    Vec_PtrForEachEntry( Vec_Ptr_t *, vParts, vPart, i )
+    {
+        pJob = Abc_NtkResynJobStart( pNtk, vPart, vPartIds, i, pPars );
+        nIns  += Vec_PtrSize(pJob->vIns);
+        nOuts += Vec_PtrSize(pJob->vOuts);
+        Vec_PtrPush( vJobs, pJob );
+    }
+    Vec_VecFree( (Vec_Vec_t *)vParts );
+    Vec_IntFree( vPartIds );
+    if ( pPars->fVerbose )
+        printf( "Partitions = %d. Nodes = %d. Part size = %d. Inputs = %d. Outputs = %d.\n",
+            Vec_PtrSize(vJobs), Abc_NtkNodeNum(pNtk), nPartSize, nIns, nOuts );
+    // the NPN tables are created on demand and shared by the threads
+    Abc_FrameReadManDec();
+    // resynthesize the partitions
+    fProgress = Abc_FrameShowProgress( pAbc );
+    if ( fProgress )
+        Cmd_CommandExecute( pAbc, "unset progressbar" );
+    Util_ProcessThreads( Abc_NtkResynJobRun, vJobs, pPars->nThreads + 1, 0, 0 );
+    if ( fProgress )
+        Cmd_CommandExecute( pAbc, "set progressbar" );
+    Vec_PtrForEachEntry( Abc_ResynJob_t *, vJobs, pJob, i )
+        if ( pJob->RetValue <= 0 )
+            fFailed = 1;
+    // put the partitions together
+    if ( !fFailed )
+        pNtkNew = Abc_NtkResynStitch( pNtk, vJobs );
+    Vec_PtrForEachEntry( Abc_ResynJob_t *, vJobs, pJob, i )
+        Abc_NtkResynJobStop( pJob );
+    Vec_PtrFree( vJobs );
+    if ( pPars->fVerbose && pNtkNew )
+    {
+        printf( "Nodes = %d -> %d. Levels = %d -> %d.  ",
+            Abc_NtkNodeNum(pNtk), Abc_NtkNodeNum(pNtkNew), Abc_AigLevel(pNtk), Abc_AigLevel(pNtkNew) );
+        ABC_PRT( "Time", Abc_Clock() - clk );
+    }
+    return pNtkNew;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
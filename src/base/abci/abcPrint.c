@@ -367,8 +367,9 @@ void Abc_NtkPrintStats( Abc_Ntk_t * pNtk, int fFactored, int fSaveBest, int fDum
     if ( Abc_NtkIsStrash(pNtk) )
     {
         extern int Abc_NtkGetMultiRefNum( Abc_Ntk_t * pNtk );
+        char * pThreads = Abc_FrameReadFlag( "prthreads" );
         Abc_Print( 1,"  lev =%3d", Abc_AigLevel(pNtk) );
-        Abc_Print( 1,"  wlev =%5.4f", Abc_NtkPathRank(pNtk) ); 
+        Abc_Print( 1,"  wlev =%5.4f", Abc_NtkPathRank(pNtk, pThreads ? atoi(pThreads) : 1) ); 
 //        Abc_Print( 1,"  ff = %5d", Abc_NtkNodeNum(pNtk) + 2 * (Abc_NtkCoNum(pNtk)+Abc_NtkGetMultiRefNum(pNtk)) );
 //        Abc_Print( 1,"  var = %5d", Abc_NtkCiNum(pNtk) + Abc_NtkCoNum(pNtk)+Abc_NtkGetMultiRefNum(pNtk) );
     }
@@ -24,15 +24,6 @@
 
 ABC_NAMESPACE_IMPL_START
 
-extern abctime global_time; 
-extern abctime global_resynthesis_time; 
-extern abctime global_cut_time; 
-extern abctime global_aig_update_time; 
-extern abctime global_aig_converter_time;  
-extern long int global_level_updates;
-extern long int global_reverse_updates;
-extern long int global_node_rewritten; 
-extern long int global_reorder_nodes;
 
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
@@ -49,6 +40,7 @@ struct Abc_ManRef_t_
     Vec_Ptr_t *      vVars;             // truth tables
     Vec_Ptr_t *      vFuncs;            // functions
     Vec_Int_t *      vMemory;           // memory
+    Kit_GraphCache_t * pCache;          // factored forms of the computed functions
     Vec_Str_t *      vCube;             // temporary
     Vec_Int_t *      vForm;             // temporary
     Vec_Ptr_t *      vVisited;          // temporary
@@ -194,7 +186,7 @@ p->timeTru += Abc_Clock() - clk;
 
     // get the factored form
 clk = Abc_Clock();
-    pFForm = (Dec_Graph_t *)Kit_TruthToGraph( (unsigned *)pTruth, nVars, p->vMemory );
+    pFForm = (Dec_Graph_t *)Kit_TruthToGraphCache( p->pCache, (unsigned *)pTruth, nVars, p->vMemory );
 p->timeFact += Abc_Clock() - clk;
 
     // mark the fanin boundary 
@@ -267,6 +259,7 @@ Abc_ManRef_t * Abc_NtkManRefStart( int nNodeSizeMax, int nConeSizeMax, int fUseD
     p->vVars        = Vec_PtrAllocTruthTables( Abc_MaxInt(nNodeSizeMax, 6) );
     p->vFuncs       = Vec_PtrAlloc( 100 );
     p->vMemory      = Vec_IntAlloc( 1 << 16 );
+    p->pCache       = Kit_GraphCacheStart( nNodeSizeMax, 1 << 22 );
     return p;
 }
 
@@ -285,6 +278,7 @@ void Abc_NtkManRefStop( Abc_ManRef_t * p )
 {
     Vec_PtrFreeFree( p->vFuncs );
     Vec_PtrFree( p->vVars );
+    Kit_GraphCacheStop( p->pCache );
     Vec_IntFree( p->vMemory );
     Vec_PtrFree( p->vVisited );
     Vec_StrFree( p->vCube );
@@ -308,6 +302,7 @@ void Abc_NtkManRefPrintStats( Abc_ManRef_t * p )
     printf( "Nodes considered  = %8d.\n", p->nNodesConsidered );
     printf( "Nodes refactored  = %8d.\n", p->nNodesRefactored );
     printf( "Gain              = %8d. (%6.2f %%).\n", p->nNodesBeg-p->nNodesEnd, 100.0*(p->nNodesBeg-p->nNodesEnd)/p->nNodesBeg );
+    Kit_GraphCachePrintStats( p->pCache );
     ABC_PRT( "Cuts       ", p->timeCut );
     ABC_PRT( "Resynthesis", p->timeRes );
     ABC_PRT( "    BDD    ", p->timeTru );
@@ -345,17 +340,8 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
     Vec_Ptr_t * vFanins;
     Abc_Obj_t * pNode;
     abctime clk, clkStart = Abc_Clock();
-    int i, nNodes, RetValue = 1;
-
-    global_time = 0; 
-    global_resynthesis_time = 0; 
-    global_cut_time = 0; 
-    global_aig_update_time = 0; 
-    global_aig_converter_time = 0;  
-    global_level_updates = 0;
-    global_reverse_updates = 0;
-    global_node_rewritten = 0;  
-    global_reorder_nodes = 0;
+    int i, nNodes, RetValue = 1, nRewritten = 0;
+
     assert( Abc_NtkIsStrash(pNtk) );
     // cleanup the AIG
     Abc_AigCleanup((Abc_Aig_t *)pNtk->pManFunc);
@@ -365,7 +351,10 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
     pManRef->vLeaves   = Abc_NtkManCutReadCutLarge( pManCut );
     // compute the reverse levels if level update is requested
     if ( fUpdateLevel )
+    {
         Abc_NtkStartReverseLevels( pNtk, 0 );
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 1 );
+    }
 
     // resynthesize each node once
     pManRef->nNodesBeg = Abc_NtkNodeNum(pNtk);
@@ -375,6 +364,8 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
     List_Ptr_Node_t * oLNode; 
     List_Ptr_t * oList = Abc_AigGetOList((Abc_Aig_t *)pNtk->pManFunc);
     oList->nSize = 0;
+    // lay out the list nodes in the initial order
+    List_PtrReserve( oList, Abc_NtkNodeNum(pNtk) );
     
     Abc_NtkForEachNode( pNtk, pNode, i ){
         oLNode = List_PtrPushBack( oList, pNode );
@@ -394,7 +385,7 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
         if (pNode == NULL || !Abc_ObjIsNode(pNode)) continue;
         Extra_ProgressBarUpdate( pProgress, i, NULL );
         
-        if (pNode->fHandled){
+        if (Abc_ObjIsHandled(pNode)){
             printf("Abc_NtkRerfactor: node %d has been handled.\n", pNode->Id); 
             continue;
         } 
@@ -405,7 +396,7 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
         // skip persistant nodes
         if ( Abc_NodeIsPersistant(pNode) ){
             if (fUpdateLevel) {
-                pNode->fHandled = 1;
+                Abc_ObjSetHandled( pNode, 1 );
                 Abc_AigUpdateLevel_Lazy( pNode);
             } 
             continue;
@@ -413,7 +404,7 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
         // skip the nodes with many fanouts
         if ( Abc_ObjFanoutNum(pNode) > 1000 ){
             if (fUpdateLevel) {
-                pNode->fHandled = 1;
+                Abc_ObjSetHandled( pNode, 1 );
                 Abc_AigUpdateLevel_Lazy( pNode);
             } 
             continue;
@@ -424,16 +415,18 @@ int Abc_NtkRefactor( Abc_Ntk_t * pNtk, int nNodeSizeMax, int nMinSaved, int nCon
             Abc_Obj_t * pFanin1 = Abc_ObjFanin1(pNode);         
             if (pFanin0 != NULL) 
             if (!Abc_ObjIsCi(pFanin0) && pFanin0->oLNode != NULL)
-                assert(pFanin0->fHandled);
+                assert(Abc_ObjIsHandled(pFanin0));
             if (pFanin1 != NULL)
             if (!Abc_ObjIsCi(pFanin1) && pFanin1->oLNode != NULL)
-                assert(pFanin1->fHandled); 
-            if ( !pNode->fHandled )  
+                assert(Abc_ObjIsHandled(pFanin1)); 
+            if ( !Abc_ObjIsHandled(pNode) )  
                 Abc_AigUpdateLevel_Lazy( pNode);
+            // flush the batched level updates if this node may depend on them
+            Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, pNode->Level, 0 );
         }
         // avoid persistently rewriting newly created nodes with zero gain
         if (pNode->Id > max_node_id) {
-            if (fUpdateLevel)  pNode->fHandled = 1;  
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );  
             i --;
             continue;
         }
@@ -450,24 +443,25 @@ clk = Abc_Clock();
         pFForm = Abc_NodeRefactor( pManRef, pNode, vFanins, nMinSaved, fUpdateLevel, fUseZeros, fUseDcs, fVerbose );
 pManRef->timeRes += Abc_Clock() - clk;
         if ( pFForm == NULL ){
-            pNode->fHandled = 1; 
+            Abc_ObjSetHandled( pNode, 1 ); 
                 continue;
             // acceptable replacement found, update the graph
         }
 clk = Abc_Clock();
         if ( !Dec_GraphUpdateNetwork( pNode, pFForm, fUpdateLevel, pManRef->nLastGain ) )
         {
-            if (fUpdateLevel)  pNode->fHandled = 1;
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );
             Dec_GraphFree( pFForm );
             RetValue = -1;
             break;
         }
-        global_node_rewritten ++; 
+        Util_StatAdd( UTIL_STAT_NODES_REWRITTEN, 1 );
+        nRewritten++;
 pManRef->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFForm );
 
         if ( fUpdateLevel ){
-           pNode->fHandled = 1;
+           Abc_ObjSetHandled( pNode, 1 );
            if (!Abc_AigReplaceUpdateAff( (Abc_Aig_t *)pNtk->pManFunc)){
                 RetValue = -1; 
                 break; 
@@ -476,20 +470,29 @@ pManRef->timeNtk += Abc_Clock() - clk;
     }
   
     Extra_ProgressBarStop( pProgress );
+    // the traversal is over, even if the loop was left early
+    oList->pCurItera = NULL;
+    // flush the remaining batched level updates
+    if ( fUpdateLevel )
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 0 );
 pManRef->timeTotal = Abc_Clock() - clkStart;
     pManRef->nNodesEnd = Abc_NtkNodeNum(pNtk);
     
 
-    ABC_PRT("###global_time ",                   pManRef->timeTotal);   
-    ABC_PRT("###global_cut ",                    pManRef->timeCut); 
-    ABC_PRT("###global_resynthesis_time",        pManRef->timeRes); 
-    ABC_PRT("###global_aig_update_time",         global_aig_update_time); 
-    ABC_PRT("###global_aig_converter_time ",     pManRef->timeNtk); 
-      
-    printf("###global_level_updates \t %ld\n",    global_level_updates);   
-    printf("###global_reverse_updates \t %ld\n",  global_reverse_updates);   
-    printf("###global_node_rewritten \t %ld\n",   global_node_rewritten);      
-    printf("###global_reorder_nodes \t %ld\n",    global_reorder_nodes);
+    // print the summary of the metrics
+    if ( fVerbose && Util_StatIsOn() )
+    {
+        ABC_PRT("###global_time ",                   pManRef->timeTotal);
+        ABC_PRT("###global_cut ",                    pManRef->timeCut);
+        ABC_PRT("###global_resynthesis_time",        pManRef->timeRes);
+        ABC_PRT("###global_aig_update_time",         (abctime)Util_StatRead(UTIL_STAT_AIG_UPDATE_TIME));
+        ABC_PRT("###global_aig_converter_time ",     pManRef->timeNtk);
+
+        printf("###global_level_updates \t %ld\n",    (long)Util_StatRead(UTIL_STAT_LEVEL_UPDATES));
+        printf("###global_reverse_updates \t %ld\n",  (long)Util_StatRead(UTIL_STAT_REVERSE_UPDATES));
+        printf("###global_node_rewritten \t %ld\n",   (long)nRewritten);
+        printf("###global_reorder_nodes \t %ld\n",    (long)Util_StatRead(UTIL_STAT_REORDER_NODES));
+    }
 
     // print statistics of the manager
     if ( fVerbose )
@@ -501,14 +504,17 @@ pManRef->timeTotal = Abc_Clock() - clkStart;
       // clear the mark of fHandled nodes
     List_Ptr_Iterator_t * oLIter = (List_Ptr_Iterator_t*)ABC_ALLOC(List_Ptr_Iterator_t, 1);
     List_PtrForEach(List_Ptr_t*, oList, pNode, oLIter ){ 
-        if (pNode == NULL || !Abc_ObjIsNode(pNode)) continue;
+        if (pNode == NULL) continue;
+        // the list entries are freed below
+        pNode->oLNode = NULL;
+        if (!Abc_ObjIsNode(pNode)) continue;
         if (pNode->Id > max_node_id) {
-            pNode->fHandled = 0;
+            Abc_ObjSetHandled( pNode, 0 );
             continue;
         } 
         if ( pNode->Level != 1 + (unsigned)Abc_MaxInt( Abc_ObjFanin0(pNode)->Level, Abc_ObjFanin1(pNode)->Level ) )
-            printf( "Abc_AigCheck immediately after refactor: Node \"%d\" (%d) handled has level that does not agree with the fanin levels.\n", pNode->fHandled, Abc_ObjId(pNode) );
-        pNode->fHandled = 0; 
+            printf( "Abc_AigCheck immediately after refactor: Node \"%d\" (%d) handled has level that does not agree with the fanin levels.\n", Abc_ObjIsHandled(pNode), Abc_ObjId(pNode) );
+        Abc_ObjSetHandled( pNode, 0 ); 
         
     }
     List_PtrClear(oList);
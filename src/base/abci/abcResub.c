@@ -23,15 +23,6 @@
 
 ABC_NAMESPACE_IMPL_START
 
-extern abctime global_time; 
-extern abctime global_resynthesis_time; 
-extern abctime global_cut_time; 
-extern abctime global_aig_update_time; 
-extern abctime global_aig_converter_time;  
-extern long int global_level_updates;
-extern long int global_reverse_updates;
-extern long int global_node_rewritten; 
-extern long int global_reorder_nodes;
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
@@ -67,6 +58,16 @@ struct Abc_ManRes_t_
     Vec_Ptr_t        * vDivs2UP1;  // the double-node unate divisors
     Vec_Ptr_t        * vDivs2UN0;  // the double-node unate divisors
     Vec_Ptr_t        * vDivs2UN1;  // the double-node unate divisors
+    // signatures (the first 64 simulation bits) of the divisors in the above arrays
+    Vec_Wrd_t        * vSigs1UP;   // the single-node unate divisors (with complement)
+    Vec_Wrd_t        * vSigs1UN;   // the single-node unate divisors (with complement)
+    Vec_Wrd_t        * vSigs1B;    // the single-node binate divisors
+    Vec_Wrd_t        * vSigs2UP;   // the functions of the double-node unate divisors
+    Vec_Wrd_t        * vSigs2UN;   // the functions of the double-node unate divisors
+    Vec_Wec_t        * vIndex2UP;  // the double-node unate divisors by signature bits
+    Vec_Wec_t        * vIndex2UN;  // the double-node unate divisors by signature bits
+    word               uIndex2UP;  // the signature bits indexed so far
+    word               uIndex2UN;  // the signature bits indexed so far
     // other data
     Vec_Ptr_t        * vTemp;      // temporary array of nodes
     // runtime statistics
@@ -111,8 +112,11 @@ static void          Abc_ManResubPrint( Abc_ManRes_t * p );
 // other procedures
 static int           Abc_ManResubCollectDivs( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves, int Required );
 static void          Abc_ManResubSimulate( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, int nLeavesMax, int nWords );
+static void          Abc_ManResubSimulateWord( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, int nLeavesMax, int nWords );
 static void          Abc_ManResubPrintDivs( Abc_ManRes_t * p, Abc_Obj_t * pRoot, Vec_Ptr_t * vLeaves );
 
+static void          Abc_ManResubSigIndex( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs );
+static Vec_Int_t *   Abc_ManResubSigLookup( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs, int fCompl, word uMissing );
 static void          Abc_ManResubDivsS( Abc_ManRes_t * p, int Required );
 static void          Abc_ManResubDivsD( Abc_ManRes_t * p, int Required );
 static Dec_Graph_t * Abc_ManResubQuit( Abc_ManRes_t * p );
@@ -125,6 +129,10 @@ static Dec_Graph_t * Abc_ManResubDivs3( Abc_ManRes_t * p, int Required );
 static Vec_Ptr_t *   Abc_CutFactorLarge( Abc_Obj_t * pNode, int nLeavesMax );
 static int           Abc_CutVolumeCheck( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
 
+// signatures are the first 64 bits of simulation info (32 bits if the window has 5 or less leaves);
+// a candidate whose signature does not match the root is skipped without looking at the full info
+static inline word   Abc_ManResubSig( Abc_ManRes_t * p, unsigned * pInfo ) { return p->nWords == 1 ? (word)pInfo[0] : *(word *)pInfo; }
+
 //extern abctime s_ResubTime;
 
 ////////////////////////////////////////////////////////////////////////
@@ -134,7 +142,6 @@ static int           Abc_CutVolumeCheck( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves
 int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinSaved, int nLevelsOdc, int fUpdateLevel, int fVerbose, int fVeryVerbose )
 {
     extern int           Dec_GraphUpdateNetwork( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain );
-    extern int           Dec_GraphUpdateNetworkLevelUpdate( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain );
     ProgressBar * pProgress;
     Abc_ManRes_t * pManRes;
     Abc_ManCut_t * pManCut;
@@ -143,20 +150,11 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
     Vec_Ptr_t * vLeaves;
     Abc_Obj_t * pNode;
     abctime clk, clkStart = Abc_Clock();
-    int i, nNodes;
+    int i, nNodes, nRewritten = 0;
     int max_node_id = Abc_NtkObjNumMax(pNtk);
 
     assert( Abc_NtkIsStrash(pNtk) );
 
-    global_time = 0; 
-    global_resynthesis_time = 0; 
-    global_cut_time = 0; 
-    global_aig_update_time = 0; 
-    global_aig_converter_time = 0;  
-    global_level_updates = 0;
-    global_reverse_updates = 0;
-    global_node_rewritten = 0; 
-    global_reorder_nodes = 0;
 
     // cleanup the AIG
     Abc_AigCleanup((Abc_Aig_t *)pNtk->pManFunc);
@@ -168,7 +166,10 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
 
     // compute the reverse levels if level update is requested
     if ( fUpdateLevel )
+    {
         Abc_NtkStartReverseLevels( pNtk, 0 );
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 1 );
+    }
 
     if ( Abc_NtkLatchNum(pNtk) ) {
         Abc_NtkForEachLatch(pNtk, pNode, i)
@@ -188,6 +189,8 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
     List_Ptr_Node_t * oLNode; 
     List_Ptr_t * oList = Abc_AigGetOList((Abc_Aig_t *)pNtk->pManFunc);
     oList->nSize = 0;
+    // lay out the list nodes in the initial order
+    List_PtrReserve( oList, Abc_NtkNodeNum(pNtk) );
 
       // with representation of order by List 
     Abc_NtkForEachNode( pNtk, pNode, i ){
@@ -206,7 +209,7 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
         // we delete the node from AIG but do not remove the order from the linked list 
         if (pNode == NULL || !Abc_ObjIsNode(pNode)) continue;
         Extra_ProgressBarUpdate( pProgress, i, NULL );
-        if (pNode->fHandled){
+        if (Abc_ObjIsHandled(pNode)){
             printf("Abc_NtkRewrite: node %d has been handled.\n", pNode->Id); 
             continue;
         }
@@ -219,7 +222,7 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
         // skip persistant nodes
         if ( Abc_NodeIsPersistant(pNode) ){
             if (fUpdateLevel) {
-                pNode->fHandled = 1;
+                Abc_ObjSetHandled( pNode, 1 );
                 Abc_AigUpdateLevel_Lazy( pNode);
             } 
             continue;
@@ -228,7 +231,7 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
         // skip the nodes with many fanouts
         if ( Abc_ObjFanoutNum(pNode) > 1000 ){
             if (fUpdateLevel) {
-                pNode->fHandled = 1;
+                Abc_ObjSetHandled( pNode, 1 );
                 Abc_AigUpdateLevel_Lazy( pNode);
             } 
             continue;
@@ -240,16 +243,20 @@ int Abc_NtkResubstitute( Abc_Ntk_t * pNtk, int nCutMax, int nStepsMax, int nMinS
             Abc_Obj_t * pFanin1 = Abc_ObjFanin1(pNode);         
             if (pFanin0 != NULL && pFanin0->oLNode != NULL)
             if (!Abc_ObjIsCi(pFanin0) ) 
-                assert(pFanin0->fHandled);
+                assert(Abc_ObjIsHandled(pFanin0));
             if (pFanin1 != NULL && pFanin1->oLNode != NULL)
             if (!Abc_ObjIsCi(pFanin1) )  
-                assert(pFanin1->fHandled); 
+                assert(Abc_ObjIsHandled(pFanin1)); 
             Abc_AigUpdateLevel_Lazy( pNode); 
+            // flush the batched level updates if this node or its divisors may depend on them
+            // (the divisors are limited by the required level and the ODC window by nLevelsOdc)
+            Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, 
+                Abc_MaxInt( Abc_ObjRequiredLevel(pNode), (int)pNode->Level + nLevelsOdc ), 0 );
         }
 
         // avoid persistently rewriting newly created nodes with zero gain 
         if (pNode->Id > max_node_id) {
-            if (fUpdateLevel)  pNode->fHandled = 1;  
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );  
             i --;
             continue;
         }
@@ -282,14 +289,14 @@ clk = Abc_Clock();
 //        Abc_ManResubCleanup( pManRes );
 pManRes->timeRes += Abc_Clock() - clk;
         if ( pFForm == NULL ){
-            if (fUpdateLevel)  pNode->fHandled = 1;
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );
             continue;
         }
             
         if ( pManRes->nLastGain < nMinSaved )
         {
             Dec_GraphFree( pFForm );
-            if (fUpdateLevel)  pNode->fHandled = 1;
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );
             continue;
         }
         pManRes->nTotalGain += pManRes->nLastGain;
@@ -304,12 +311,13 @@ pManRes->timeRes += Abc_Clock() - clk;
 */
         // acceptable replacement found, update the graph
 clk = Abc_Clock();
-        Dec_GraphUpdateNetworkLevelUpdate( pNode, pFForm, fUpdateLevel, pManRes->nLastGain );
+        Dec_GraphUpdateNetwork( pNode, pFForm, fUpdateLevel, pManRes->nLastGain );
 pManRes->timeNtk += Abc_Clock() - clk;
         Dec_GraphFree( pFForm );
-        global_node_rewritten ++;
+        Util_StatAdd( UTIL_STAT_NODES_REWRITTEN, 1 );
+        nRewritten++;
         if ( fUpdateLevel ){
-            pNode->fHandled = 1;
+            Abc_ObjSetHandled( pNode, 1 );
             if (!Abc_AigReplaceUpdateAff( (Abc_Aig_t *)pNtk->pManFunc)){
                 printf ("Abc_NtkRerfactor: Abc_AigReplaceUpdateAff.\n"); 
                 break; 
@@ -318,20 +326,29 @@ pManRes->timeNtk += Abc_Clock() - clk;
     }
 
     Extra_ProgressBarStop( pProgress );
+    // the traversal is over, even if the loop was left early
+    oList->pCurItera = NULL;
+    // flush the remaining batched level updates
+    if ( fUpdateLevel )
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 0 );
 pManRes->timeTotal = Abc_Clock() - clkStart;
     pManRes->nNodesEnd = Abc_NtkNodeNum(pNtk);
 
 
-    ABC_PRT("###global_time ",                   pManRes->timeTotal);   
-    ABC_PRT("###global_cut ",                    pManRes->timeCut); 
-    ABC_PRT("###global_resynthesis_time",        pManRes->timeRes); 
-    ABC_PRT("###global_aig_update_time",         global_aig_update_time); 
-    ABC_PRT("###global_aig_converter_time ",     pManRes->timeNtk); 
-      
-    printf("###global_level_updates \t %ld\n",    global_level_updates);   
-    printf("###global_reverse_updates \t %ld\n",  global_reverse_updates);   
-    printf("###global_node_rewritten \t %ld\n",   global_node_rewritten);      
-    printf("###global_reorder_nodes \t %ld\n",    global_reorder_nodes);
+    // print the summary of the metrics
+    if ( fVerbose && Util_StatIsOn() )
+    {
+        ABC_PRT("###global_time ",                   pManRes->timeTotal);
+        ABC_PRT("###global_cut ",                    pManRes->timeCut);
+        ABC_PRT("###global_resynthesis_time",        pManRes->timeRes);
+        ABC_PRT("###global_aig_update_time",         (abctime)Util_StatRead(UTIL_STAT_AIG_UPDATE_TIME));
+        ABC_PRT("###global_aig_converter_time ",     pManRes->timeNtk);
+
+        printf("###global_level_updates \t %ld\n",    (long)Util_StatRead(UTIL_STAT_LEVEL_UPDATES));
+        printf("###global_reverse_updates \t %ld\n",  (long)Util_StatRead(UTIL_STAT_REVERSE_UPDATES));
+        printf("###global_node_rewritten \t %ld\n",   (long)nRewritten);
+        printf("###global_reorder_nodes \t %ld\n",    (long)Util_StatRead(UTIL_STAT_REORDER_NODES));
+    }
 
     // print statistics
     if ( fVerbose )
@@ -346,11 +363,12 @@ pManRes->timeTotal = Abc_Clock() - clkStart;
     Abc_NtkForEachObj( pNtk, pNode, i ) {
         pNode->pData = NULL;  
 
-        if (Abc_ObjIsNode(pNode) && pNode->fHandled == 1 && pNode->Id < max_node_id) {
+        if (Abc_ObjIsNode(pNode) && Abc_ObjIsHandled(pNode) == 1 && pNode->Id < max_node_id) {
             if ( pNode->Level != 1 + (unsigned)Abc_MaxInt( Abc_ObjFanin0(pNode)->Level, Abc_ObjFanin1(pNode)->Level ) )
-                    printf( "Abc_AigCheck immediately after rewrite: Node \"%d\" (%d) handled has level that does not agree with the fanin levels.\n", pNode->fHandled, Abc_ObjId(pNode) );
+                    printf( "Abc_AigCheck immediately after rewrite: Node \"%d\" (%d) handled has level that does not agree with the fanin levels.\n", Abc_ObjIsHandled(pNode), Abc_ObjId(pNode) );
             }
-        pNode->fHandled = 0; 
+        Abc_ObjSetHandled( pNode, 0 ); 
+        pNode->oLNode = NULL;
     }    
     List_PtrClear(oList);
 
@@ -430,6 +448,13 @@ Abc_ManRes_t * Abc_ManResubStart( int nLeavesMax, int nDivsMax )
     p->vDivs2UP1 = Vec_PtrAlloc( p->nDivsMax );
     p->vDivs2UN0 = Vec_PtrAlloc( p->nDivsMax );
     p->vDivs2UN1 = Vec_PtrAlloc( p->nDivsMax );
+    p->vSigs1UP  = Vec_WrdAlloc( p->nDivsMax );
+    p->vSigs1UN  = Vec_WrdAlloc( p->nDivsMax );
+    p->vSigs1B   = Vec_WrdAlloc( p->nDivsMax );
+    p->vSigs2UP  = Vec_WrdAlloc( ABC_RS_DIV2_MAX + 4 );
+    p->vSigs2UN  = Vec_WrdAlloc( ABC_RS_DIV2_MAX + 4 );
+    p->vIndex2UP = Vec_WecStart( 65 );
+    p->vIndex2UN = Vec_WecStart( 65 );
     p->vTemp     = Vec_PtrAlloc( p->nDivsMax );
     return p;
 }
@@ -456,6 +481,13 @@ void Abc_ManResubStop( Abc_ManRes_t * p )
     Vec_PtrFree( p->vDivs2UP1 );
     Vec_PtrFree( p->vDivs2UN0 );
     Vec_PtrFree( p->vDivs2UN1 );
+    Vec_WrdFree( p->vSigs1UP );
+    Vec_WrdFree( p->vSigs1UN );
+    Vec_WrdFree( p->vSigs1B );
+    Vec_WrdFree( p->vSigs2UP );
+    Vec_WrdFree( p->vSigs2UN );
+    Vec_WecFree( p->vIndex2UP );
+    Vec_WecFree( p->vIndex2UN );
     Vec_PtrFree( p->vTemp );
     ABC_FREE( p->pInfo );
     ABC_FREE( p );
@@ -700,11 +732,56 @@ void Abc_ManResubDumpInstance( Vec_Ptr_t * vDivs, int nLeaves, int nDivs, int nW
     printf( "Finished dumping file \"%s\" with %d divisors and %d patterns.\n", pFileName, nDivs, (1 << nLeaves) );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Performs simulation 64 bits at a time.]
+
+  Description [Normalizes the info of each node right after computing it.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ManResubSimulateWord( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, int nLeavesMax, int nWords )
+{
+    Abc_Obj_t * pObj, * pFanin0, * pFanin1;
+    word * pData0, * pData1, * pData, Mask0, Mask1, MaskR;
+    int i, k, Phase0, Phase1;
+    Vec_PtrForEachEntry( Abc_Obj_t *, vDivs, pObj, i )
+    {
+        if ( i < nLeaves )
+        { // initialize the leaf (elementary info is zero in the first minterm)
+            pObj->pData  = Vec_PtrEntry( vSims, i );
+            pObj->fPhase = 0;
+            continue;
+        }
+        // set storage for the node's simulation info
+        pObj->pData = Vec_PtrEntry( vSims, i - nLeaves + nLeavesMax );
+        pFanin0 = Abc_ObjFanin0(pObj);
+        pFanin1 = Abc_ObjFanin1(pObj);
+        pData   = (word *)pObj->pData;
+        pData0  = (word *)pFanin0->pData;
+        pData1  = (word *)pFanin1->pData;
+        // the fanin info is already normalized, so its phase is added to the edge complement
+        Phase0  = Abc_ObjFaninC0(pObj) ^ pFanin0->fPhase;
+        Phase1  = Abc_ObjFaninC1(pObj) ^ pFanin1->fPhase;
+        // the node is normalized as soon as it is simulated
+        pObj->fPhase = (Phase0 ^ (int)(pData0[0] & 1)) & (Phase1 ^ (int)(pData1[0] & 1));
+        Mask0   = Phase0 ? ~(word)0 : 0;
+        Mask1   = Phase1 ? ~(word)0 : 0;
+        MaskR   = pObj->fPhase ? ~(word)0 : 0;
+        for ( k = 0; k < nWords; k++ )
+            pData[k] = ((pData0[k] ^ Mask0) & (pData1[k] ^ Mask1)) ^ MaskR;
+    }
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs simulation.]
 
-  Description []
+  Description [Simulates the divisors and normalizes their info so that
+  it is zero in the first minterm, recording the phase in fPhase.]
                
   SideEffects []
 
@@ -717,6 +794,13 @@ void Abc_ManResubSimulate( Vec_Ptr_t * vDivs, int nLeaves, Vec_Ptr_t * vSims, in
     unsigned * puData0, * puData1, * puData;
     int i, k;
     assert( Vec_PtrSize(vDivs) - nLeaves <= Vec_PtrSize(vSims) - nLeavesMax );
+    // the info of windows with more than 5 leaves is simulated 64 bits at a time
+    if ( nWords > 1 )
+    {
+        assert( nWords % 2 == 0 );
+        Abc_ManResubSimulateWord( vDivs, nLeaves, vSims, nLeavesMax, nWords / 2 );
+        return;
+    }
     // simulate
     Vec_PtrForEachEntry( Abc_Obj_t *, vDivs, pObj, i )
     {
@@ -969,6 +1053,73 @@ Dec_Graph_t * Abc_ManResubQuit3( Abc_Obj_t * pRoot, Abc_Obj_t * pObj0, Abc_Obj_t
 
 
 
+/**Function*************************************************************
+
+  Synopsis    [Starts indexing the divisors by the bits of their signatures.]
+
+  Description [Level b < 64 of the index lists the divisors whose signature 
+  has bit b set (or clear, for the complemented lookups). These levels are 
+  filled on demand, when the bit is looked up for the first time, and the 
+  bits filled so far are recorded in puIndexed. Level 64 lists all divisors.
+  The lists are in the order of the divisors.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_ManResubSigIndex( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs )
+{
+    int b;
+    for ( b = 0; *puIndexed; b++, *puIndexed >>= 1 )
+        if ( *puIndexed & 1 )
+            Vec_IntClear( Vec_WecEntry(vIndex, b) );
+    Vec_IntClear( Vec_WecEntry(vIndex, 64) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the shortest list of candidates having the missing bits.]
+
+  Description [A divisor completes the function only if its signature has 
+  all bits of uMissing, so it is enough to look at the divisors indexed by 
+  any one of them.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Int_t * Abc_ManResubSigLookup( Vec_Wec_t * vIndex, word * puIndexed, Vec_Wrd_t * vSigs, int fCompl, word uMissing )
+{
+    Vec_Int_t * vBest = NULL;
+    word uSig, uBits = uMissing & *puIndexed;
+    int b, i;
+    // all divisors are candidates if nothing is missing
+    if ( uMissing == 0 )
+    {
+        vBest = Vec_WecEntry( vIndex, 64 );
+        if ( Vec_IntSize(vBest) < Vec_WrdSize(vSigs) )
+            Vec_IntFillNatural( vBest, Vec_WrdSize(vSigs) );
+        return vBest;
+    }
+    // index one more bit if none of the missing bits is indexed yet
+    if ( uBits == 0 )
+    {
+        for ( b = 0; !((uMissing >> b) & 1); b++ );
+        Vec_WrdForEachEntry( vSigs, uSig, i )
+            if ( ((fCompl ? ~uSig : uSig) >> b) & 1 )
+                Vec_WecPush( vIndex, b, i );
+        *puIndexed |= ((word)1 << b);
+        return Vec_WecEntry( vIndex, b );
+    }
+    // otherwise, take the shortest list among the indexed ones
+    for ( b = 0; uBits; b++, uBits >>= 1 )
+        if ( (uBits & 1) && (vBest == NULL || Vec_WecLevelSize(vIndex, b) < Vec_IntSize(vBest)) )
+            vBest = Vec_WecEntry( vIndex, b );
+    return vBest;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Derives single-node unate/binate divisors.]
@@ -985,10 +1136,14 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
     int fMoreDivs = 1; // bug fix by Siang-Yun Lee
     Abc_Obj_t * pObj;
     unsigned * puData, * puDataR;
+    word uSig;
     int i, w;
     Vec_PtrClear( p->vDivs1UP );
     Vec_PtrClear( p->vDivs1UN );
     Vec_PtrClear( p->vDivs1B );
+    Vec_WrdClear( p->vSigs1UP );
+    Vec_WrdClear( p->vSigs1UN );
+    Vec_WrdClear( p->vSigs1B );
     puDataR = (unsigned *)p->pRoot->pData;
     Vec_PtrForEachEntryStop( Abc_Obj_t *, p->vDivs, pObj, i, p->nDivs )
     {
@@ -996,6 +1151,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
             continue;
 
         puData = (unsigned *)pObj->pData;
+        uSig   = Abc_ManResubSig( p, puData );
         // check positive containment
         for ( w = 0; w < p->nWords; w++ )
 //            if ( puData[w] & ~puDataR[w] )
@@ -1004,6 +1160,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
         if ( w == p->nWords )
         {
             Vec_PtrPush( p->vDivs1UP, pObj );
+            Vec_WrdPush( p->vSigs1UP, uSig );
             continue;
         }
         if ( fMoreDivs )
@@ -1015,6 +1172,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
             if ( w == p->nWords )
             {
                 Vec_PtrPush( p->vDivs1UP, Abc_ObjNot(pObj) );
+                Vec_WrdPush( p->vSigs1UP, ~uSig );
                 continue;
             }
         }
@@ -1026,6 +1184,7 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
         if ( w == p->nWords )
         {
             Vec_PtrPush( p->vDivs1UN, pObj );
+            Vec_WrdPush( p->vSigs1UN, uSig );
             continue;
         }
         if ( fMoreDivs )
@@ -1037,11 +1196,13 @@ void Abc_ManResubDivsS( Abc_ManRes_t * p, int Required )
             if ( w == p->nWords )
             {
                 Vec_PtrPush( p->vDivs1UN, Abc_ObjNot(pObj) );
+                Vec_WrdPush( p->vSigs1UN, ~uSig );
                 continue;
             }
         }
         // add the node to binates
         Vec_PtrPush( p->vDivs1B, pObj );
+        Vec_WrdPush( p->vSigs1B, uSig );
     }
 }
 
@@ -1060,109 +1221,152 @@ void Abc_ManResubDivsD( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1;
     unsigned * puData0, * puData1, * puDataR;
+    word uSig0, uSig1, uSigR, uSigC;
     int i, k, w;
     Vec_PtrClear( p->vDivs2UP0 );
     Vec_PtrClear( p->vDivs2UP1 );
     Vec_PtrClear( p->vDivs2UN0 );
     Vec_PtrClear( p->vDivs2UN1 );
+    Vec_WrdClear( p->vSigs2UP );
+    Vec_WrdClear( p->vSigs2UN );
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1B, pObj0, i )
     {
         if ( (int)pObj0->Level > Required - 2 )
             continue;
 
         puData0 = (unsigned *)pObj0->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1B, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1B, pObj1, k, i + 1 )
         {
             if ( (int)pObj1->Level > Required - 2 )
                 continue;
 
             puData1 = (unsigned *)pObj1->pData;
+            uSig1   = Vec_WrdEntry( p->vSigs1B, k );
 
+            // each check below is skipped if it already fails on the signatures
             if ( Vec_PtrSize(p->vDivs2UP0) < ABC_RS_DIV2_MAX )
             {
                 // get positive unate divisors
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (puData0[w] & puData1[w]) & ~puDataR[w] )
-                    if ( (puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (uSig0 & uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (puData0[w] & puData1[w]) & ~puDataR[w] )
+                        if ( (puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UP, uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (~puData0[w] & puData1[w]) & ~puDataR[w] )
-                    if ( (~puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (~uSig0 & uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (~puData0[w] & puData1[w]) & ~puDataR[w] )
+                        if ( (~puData0[w] & puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UP1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UP, ~uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] )
-                    if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (uSig0 & ~uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] )
+                        if ( (puData0[w] & ~puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UP, uSig0 & ~uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( (puData0[w] | puData1[w]) & ~puDataR[w] )
-                    if ( (puData0[w] | puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( (uSig0 | uSig1) & ~uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( (puData0[w] | puData1[w]) & ~puDataR[w] )
+                        if ( (puData0[w] | puData1[w]) & ~puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UP0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UP1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UP, uSig0 | uSig1 );
+                    }
                 }
             }
 
             if ( Vec_PtrSize(p->vDivs2UN0) < ABC_RS_DIV2_MAX )
             {
                 // get negative unate divisors
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(puData0[w] & puData1[w]) & puDataR[w] )
-                    if ( ~(puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(uSig0 & uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(puData0[w] & puData1[w]) & puDataR[w] )
+                        if ( ~(puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UN, uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(~puData0[w] & puData1[w]) & puDataR[w] )
-                    if ( ~(~puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(~uSig0 & uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(~puData0[w] & puData1[w]) & puDataR[w] )
+                        if ( ~(~puData0[w] & puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UN1, pObj1 );
+                        Vec_WrdPush( p->vSigs2UN, ~uSig0 & uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] )
-                    if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(uSig0 & ~uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, pObj0 );
-                    Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] )
+                        if ( ~(puData0[w] & ~puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, pObj0 );
+                        Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UN, uSig0 & ~uSig1 );
+                    }
                 }
-                for ( w = 0; w < p->nWords; w++ )
-//                    if ( ~(puData0[w] | puData1[w]) & puDataR[w] )
-                    if ( ~(puData0[w] | puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
-                        break;
-                if ( w == p->nWords )
+                if ( !( ~(uSig0 | uSig1) & uSigR & uSigC ) )
                 {
-                    Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
-                    Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                    for ( w = 0; w < p->nWords; w++ )
+//                        if ( ~(puData0[w] | puData1[w]) & puDataR[w] )
+                        if ( ~(puData0[w] | puData1[w]) & puDataR[w] & p->pCareSet[w] ) // care set
+                            break;
+                    if ( w == p->nWords )
+                    {
+                        Vec_PtrPush( p->vDivs2UN0, Abc_ObjNot(pObj0) );
+                        Vec_PtrPush( p->vDivs2UN1, Abc_ObjNot(pObj1) );
+                        Vec_WrdPush( p->vSigs2UN, uSig0 | uSig1 );
+                    }
                 }
             }
         }
     }
 //    printf( "%d %d  ", Vec_PtrSize(p->vDivs2UP0), Vec_PtrSize(p->vDivs2UN0) );
+    // start indexing the pairs by the minterms they cover (or leave out)
+    Abc_ManResubSigIndex( p->vIndex2UP, &p->uIndex2UP, p->vSigs2UP );
+    Abc_ManResubSigIndex( p->vIndex2UN, &p->uIndex2UN, p->vSigs2UN );
 }
 
 
@@ -1243,14 +1447,20 @@ Dec_Graph_t * Abc_ManResubDivs1( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1;
     unsigned * puData0, * puData1, * puDataR;
+    word uSig0, uSigR, uSigC;
     int i, k, w;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UP, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1UP, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UP, pObj1, k, i + 1 )
         {
+            if ( ((uSig0 | Vec_WrdEntry(p->vSigs1UP, k)) ^ uSigR) & uSigC )
+                continue;
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
             if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) )
             {
@@ -1291,8 +1501,12 @@ Dec_Graph_t * Abc_ManResubDivs1( Abc_ManRes_t * p, int Required )
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UN, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        // the checks below end up using the first divisor without its complement
+        uSig0   = Abc_ManResubSig( p, puData0 );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UN, pObj1, k, i + 1 )
         {
+            if ( ((uSig0 & Vec_WrdEntry(p->vSigs1UN, k)) ^ uSigR) & uSigC )
+                continue;
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
             if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) )
             {
@@ -1347,17 +1561,24 @@ Dec_Graph_t * Abc_ManResubDivs12( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1, * pObj2, * pObjMax, * pObjMin0 = NULL, * pObjMin1 = NULL;
     unsigned * puData0, * puData1, * puData2, * puDataR;
+    word uSig0, uSig1, uSigR, uSigC;
     int i, k, j, w, LevelMax;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UP, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1UP, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UP, pObj1, k, i + 1 )
         {
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
+            uSig1   = uSig0 | Vec_WrdEntry( p->vSigs1UP, k );
             Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UP, pObj2, j, k + 1 )
             {
+                if ( ((uSig1 | Vec_WrdEntry(p->vSigs1UP, j)) ^ uSigR) & uSigC )
+                    continue;
                 puData2 = (unsigned *)Abc_ObjRegular(pObj2)->pData;
                 if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) && Abc_ObjIsComplement(pObj2) )
                 {
@@ -1447,11 +1668,15 @@ Dec_Graph_t * Abc_ManResubDivs12( Abc_ManRes_t * p, int Required )
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UN, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
+        uSig0   = Vec_WrdEntry( p->vSigs1UN, i );
         Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UN, pObj1, k, i + 1 )
         {
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
+            uSig1   = uSig0 & Vec_WrdEntry( p->vSigs1UN, k );
             Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs1UN, pObj2, j, k + 1 )
             {
+                if ( ((uSig1 & Vec_WrdEntry(p->vSigs1UN, j)) ^ uSigR) & uSigC )
+                    continue;
                 puData2 = (unsigned *)Abc_ObjRegular(pObj2)->pData;
                 if ( Abc_ObjIsComplement(pObj0) && Abc_ObjIsComplement(pObj1) && Abc_ObjIsComplement(pObj2) )
                 {
@@ -1555,14 +1780,25 @@ Dec_Graph_t * Abc_ManResubDivs2( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1, * pObj2;
     unsigned * puData0, * puData1, * puData2, * puDataR;
-    int i, k, w;
+    Vec_Int_t * vCands;
+    word * pSigs, uSig0, uSigR, uSigC;
+    int i, k, j, w;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UP, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
-        Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs2UP0, pObj1, k )
+        uSig0   = Vec_WrdEntry( p->vSigs1UP, i );
+        // only the pairs covering the minterms missing in the divisor are considered
+        vCands  = Abc_ManResubSigLookup( p->vIndex2UP, &p->uIndex2UP, p->vSigs2UP, 0, uSigR & uSigC & ~uSig0 );
+        pSigs   = Vec_WrdArray( p->vSigs2UP );
+        Vec_IntForEachEntry( vCands, k, j )
         {
+            if ( ((uSig0 | pSigs[k]) ^ uSigR) & uSigC )
+                continue;
+            pObj1 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP0, k );
             pObj2 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP1, k );
 
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
@@ -1640,8 +1876,15 @@ Dec_Graph_t * Abc_ManResubDivs2( Abc_ManRes_t * p, int Required )
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs1UN, pObj0, i )
     {
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
-        Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs2UN0, pObj1, k )
+        uSig0   = Vec_WrdEntry( p->vSigs1UN, i );
+        // only the pairs leaving out the minterms extra in the divisor are considered
+        vCands  = Abc_ManResubSigLookup( p->vIndex2UN, &p->uIndex2UN, p->vSigs2UN, 1, ~uSigR & uSigC & uSig0 );
+        pSigs   = Vec_WrdArray( p->vSigs2UN );
+        Vec_IntForEachEntry( vCands, k, j )
         {
+            if ( ((uSig0 & pSigs[k]) ^ uSigR) & uSigC )
+                continue;
+            pObj1 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UN0, k );
             pObj2 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UN1, k );
 
             puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
@@ -1733,8 +1976,12 @@ Dec_Graph_t * Abc_ManResubDivs3( Abc_ManRes_t * p, int Required )
 {
     Abc_Obj_t * pObj0, * pObj1, * pObj2, * pObj3;
     unsigned * puData0, * puData1, * puData2, * puData3, * puDataR;
-    int i, k, w = 0, Flag;
+    Vec_Int_t * vCands;
+    word * pSigs, uSig0, uSigR, uSigC;
+    int i, k, j, w = 0, Flag;
     puDataR = (unsigned *)p->pRoot->pData;
+    uSigR   = Abc_ManResubSig( p, puDataR );
+    uSigC   = Abc_ManResubSig( p, p->pCareSet );
     // check positive unate divisors
     Vec_PtrForEachEntry( Abc_Obj_t *, p->vDivs2UP0, pObj0, i )
     {
@@ -1742,9 +1989,16 @@ Dec_Graph_t * Abc_ManResubDivs3( Abc_ManRes_t * p, int Required )
         puData0 = (unsigned *)Abc_ObjRegular(pObj0)->pData;
         puData1 = (unsigned *)Abc_ObjRegular(pObj1)->pData;
         Flag = (Abc_ObjIsComplement(pObj0) << 3) | (Abc_ObjIsComplement(pObj1) << 2);
+        uSig0 = Vec_WrdEntry( p->vSigs2UP, i );
 
-        Vec_PtrForEachEntryStart( Abc_Obj_t *, p->vDivs2UP0, pObj2, k, i + 1 )
+        // only the pairs covering the minterms missing in this pair are considered
+        vCands = Abc_ManResubSigLookup( p->vIndex2UP, &p->uIndex2UP, p->vSigs2UP, 0, uSigR & uSigC & ~uSig0 );
+        pSigs  = Vec_WrdArray( p->vSigs2UP );
+        Vec_IntForEachEntry( vCands, k, j )
         {
+            if ( k <= i || (((uSig0 | pSigs[k]) ^ uSigR) & uSigC) )
+                continue;
+            pObj2 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP0, k );
             pObj3 = (Abc_Obj_t *)Vec_PtrEntry( p->vDivs2UP1, k );
             puData2 = (unsigned *)Abc_ObjRegular(pObj2)->pData;
             puData3 = (unsigned *)Abc_ObjRegular(pObj3)->pData;
@@ -22,19 +22,20 @@
 #include "opt/rwr/rwr.h"
 #include "bool/dec/dec.h"
 
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
  
-extern abctime global_time; 
-extern abctime global_resynthesis_time; 
-extern abctime global_cut_time; 
-extern abctime global_aig_update_time; 
-extern abctime global_aig_converter_time;  
-extern long int global_level_updates;
-extern long int global_reverse_updates;
-extern long int global_node_rewritten; 
-extern long int global_reorder_nodes;
 /*
     The ideas realized in this package are inspired by the paper:
     Per Bjesse, Arne Boralv, "DAG-aware circuit compression for 
@@ -45,9 +46,61 @@ extern long int global_reorder_nodes;
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk );
-static void        Abc_NodePrintCuts( Abc_Obj_t * pNode );
-static void        Abc_ManShowCutCone( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
+// the max number of nodes evaluated by one thread in one batch
+#define ABC_RWR_BATCH  1024
+// the number of distinct node scores used by the budgeted rewriting
+#define ABC_RWR_SCORES    8
+// the object IDs are compacted when this percentage of them are deleted
+#define ABC_RWR_COMPACT  25
+// the number of local PageRank sweeps after each accepted rewrite
+#define ABC_RWR_PR_ITERS  3
+
+typedef struct Abc_RwrPar_t_ Abc_RwrPar_t;
+typedef struct Abc_RwrJob_t_ Abc_RwrJob_t;
+struct Abc_RwrJob_t_
+{
+    Abc_RwrPar_t *   pPar;          // the manager of the threads
+    Rwr_Man_t *      pManRwr;       // the rewriting manager of this thread
+    Rwr_Spec_t *     pSpecs;        // the nodes of the batch
+    int              nSpecs;        // the number of nodes in the batch
+    int              iJob;          // the first node evaluated by this thread
+    int              nJobs;         // the step between the nodes evaluated by this thread
+};
+
+struct Abc_RwrPar_t_
+{
+    int              nSpecsMax;     // the max number of nodes in one batch
+    int              nSpecs;        // the number of nodes in the current batch
+    Rwr_Spec_t *     pSpecs;        // the nodes in the current batch
+    Vec_Int_t *      vSpecMap;      // maps node IDs into the nodes of the batch
+    Vec_Ptr_t *      vJobs;         // the jobs (one for each thread)
+#ifdef ABC_USE_PTHREADS
+    pthread_t *      pThreads;      // the threads of the jobs (except the first one)
+    pthread_mutex_t  Mutex;         // the barrier of the threads
+    pthread_cond_t   Cond;
+    int              nWaiting;      // the number of threads at the barrier
+    int              Phase;         // the number of passed barriers
+    int              fStop;         // the threads should exit
+#endif
+    int              nCommits;      // the number of accepted rewrites
+    int              nCommitsBatch; // the number of accepted rewrites when the batch was evaluated
+    // statistics
+    int              nBatches;      // the number of batches
+    int              nTrusted;      // the results used as they are
+    int              nChecked;      // the results confirmed after recounting
+    int              nReevals;      // the results recomputed by the main thread
+};
+
+static void           Abc_NodePrintCuts( Abc_Obj_t * pNode );
+static void           Abc_ManShowCutCone( Abc_Obj_t * pNode, Vec_Ptr_t * vLeaves );
+static Abc_RwrPar_t * Abc_NtkRewriteParStart( Abc_Ntk_t * pNtk, int nThreads );
+static void           Abc_NtkRewriteParStop( Abc_RwrPar_t * p, Rwr_Man_t * pManRwr, int fVerbose );
+static int            Abc_NtkRewriteParNode( Abc_RwrPar_t * p, Rwr_Man_t * pManRwr, Cut_Man_t * pManCut, List_Ptr_Node_t * pCur, int nNodeIdMax, int fUpdateLevel, int fUseZeros );
+static int            Abc_NtkRewriteScore_rec( Abc_Obj_t * pNode, int nDepth );
+static Vec_Int_t *    Abc_NtkRewriteScores( Abc_Ntk_t * pNtk, Vec_Int_t * vHist );
+static void           Abc_NtkRewriteUnscore( Vec_Int_t * vScores, Vec_Int_t * vHist, Vec_Int_t * vDeleted );
+static int            Abc_NtkRewriteCompact( Abc_Ntk_t * pNtk, int * pNodeIdMax, Vec_Int_t * vScores, Abc_Ckp_t * pCkp );
+static int            Abc_NtkRewriteSelect( Vec_Int_t * vHist, int Score, int nEvals, int nNodeBudget, abctime clkStart, abctime clkStop );
 
 extern void  Abc_PlaceBegin( Abc_Ntk_t * pNtk );
 extern void  Abc_PlaceEnd( Abc_Ntk_t * pNtk );
@@ -61,20 +114,30 @@ extern void  Abc_PlaceUpdate( Vec_Ptr_t * vAddedCells, Vec_Ptr_t * vUpdatedNets
 
   Synopsis    [Performs incremental rewriting of the AIG.]
 
-  Description []
+  Description [If the node budget (nNodeBudget) or the runtime limit 
+  (nTimeLimit, in seconds) is given, the nodes are still visited in the 
+  topological order, which keeps the incremental level update valid, but 
+  only the nodes with the highest scores that fit into the budget are 
+  evaluated. If the checkpoint manager (pCkp) is given, the state of the 
+  pass is periodically saved, and if the manager holds the state restored 
+  from a checkpoint, the pass continues from this state.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int fVerbose, int fVeryVerbose, int fPlaceEnable )
+int Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int nThreads, int nNodeBudget, int nTimeLimit, int fVerbose, int fVeryVerbose, int fPlaceEnable, Abc_Ckp_t * pCkp )
 {
     extern int           Dec_GraphUpdateNetwork( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain );
     ProgressBar * pProgress;
     Cut_Man_t * pManCut;
     Rwr_Man_t * pManRwr;
+    Abc_RwrPar_t * pPar = NULL;
     Abc_Obj_t * pNode;
+    Vec_Int_t * vScores = NULL, * vHist = NULL, * vDeleted = NULL, * vTouched = NULL;
+    abctime clkBudget = 0, clkStop = 0;
+    int nEvals = 0, nSkips = 0, nRewritten = 0, nCompacts = 0;
 //    Vec_Ptr_t * vAddedCells = NULL, * vUpdatedNets = NULL;
     Dec_Graph_t * pGraph;
     int i, nNodes, nGain, fCompl, RetValue = 1;
@@ -87,15 +150,6 @@ int Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int fVerb
     Abc_AigCleanupInc((Abc_Aig_t *)pNtk->pManFunc);
     
  
-    global_time = 0; 
-    global_resynthesis_time = 0; 
-    global_cut_time = 0; 
-    global_aig_update_time = 0; 
-    global_aig_converter_time = 0;  
-    global_level_updates = 0;
-    global_reverse_updates = 0;
-    global_node_rewritten = 0;
-    global_reorder_nodes = 0;
 
 /*
     {
@@ -118,15 +172,27 @@ int Abc_NtkRewrite( Abc_Ntk_t * pNtk, int fUpdateLevel, int fUseZeros, int fVerb
         return 0;
     // compute the reverse levels if level update is requested
     if ( fUpdateLevel )
+    {
         Abc_NtkStartReverseLevels( pNtk, 0 );
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 1 );
+    }
     // start the cut manager
 clk = Abc_Clock();
-    pManCut = Abc_NtkStartCutManForRewrite( pNtk );
+    pManCut = (Cut_Man_t *)Abc_NtkStartCutManForRewrite( pNtk );
 Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     pNtk->pManCut = pManCut;
 
     if ( fVeryVerbose )
         Rwr_ScoresClean( pManRwr );
+    // keep the PageRank scores up to date if they were computed
+    if ( pNtk->vPageRank )
+    {
+        vTouched = Vec_IntAlloc( 100 );
+        Abc_AigSetTouched( (Abc_Aig_t *)pNtk->pManFunc, vTouched );
+    }
+    // start speculative evaluation
+    if ( nThreads > 0 )
+        pPar = Abc_NtkRewriteParStart( pNtk, nThreads );
 
     // resynthesize each node once
     pManRwr->nNodesBeg = Abc_NtkNodeNum(pNtk);
@@ -138,18 +204,41 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
     List_Ptr_Node_t * oLNode; 
     List_Ptr_t * oList = Abc_AigGetOList((Abc_Aig_t *)pNtk->pManFunc);
     oList->nSize = 0;
+    // lay out the list nodes in the initial order
+    List_PtrReserve( oList, Abc_NtkNodeNum(pNtk) );
     
     // with representation of order by List 
-    Abc_NtkForEachNode( pNtk, pNode, i ){
-        oLNode = List_PtrPushBack( oList, pNode );
-        assert(oLNode != NULL);
-        pNode ->oLNode = oLNode;  
+    if ( !Abc_NtkCkpRestoreList( pCkp, pNtk, fUpdateLevel, &i, &nNodes, &nRewritten, &pManRwr->nNodesBeg ) )
+    {
+        Abc_NtkForEachNode( pNtk, pNode, i ){
+            oLNode = List_PtrPushBack( oList, pNode );
+            assert(oLNode != NULL);
+            pNode ->oLNode = oLNode;  
+        }
+        oList->pCurItera = List_PtrFirstNode(oList);
+        i = -1; 
     }
-    i = -1; 
     int max_node_id = Abc_NtkObjNumMax(pNtk); 
-    oList->pCurItera = List_PtrFirstNode(oList);
+    // rank the nodes if the budget is given
+    if ( nNodeBudget > 0 || nTimeLimit > 0 )
+    {
+        vHist     = Vec_IntStart( ABC_RWR_SCORES );
+        vScores   = Abc_NtkRewriteScores( pNtk, vHist );
+        vDeleted  = Vec_IntAlloc( 100 );
+        Abc_AigSetDeleted( (Abc_Aig_t *)pNtk->pManFunc, vDeleted );
+        clkBudget = Abc_Clock();
+        clkStop   = nTimeLimit > 0 ? clkBudget + (abctime)nTimeLimit * CLOCKS_PER_SEC : 0;
+    }
     for (; oList->pCurItera != NULL; oList->pCurItera = oList->pCurItera ->pNext) { 
         pNode = (Abc_Obj_t *) oList->pCurItera->pData; 
+        // the nodes deleted since the previous step are not visited
+        if ( vDeleted )
+            Abc_NtkRewriteUnscore( vScores, vHist, vDeleted );
+        // save the state before visiting the node if the checkpoint is due
+        Abc_NtkCkpUpdate( pCkp, pNtk, i, nNodes, max_node_id, nRewritten, pManRwr->nNodesBeg );
+        // renumber the objects if many of them were deleted
+        if ( pPar == NULL && (i & 0xFFF) == 0 )
+            nCompacts += Abc_NtkRewriteCompact( pNtk, &max_node_id, vScores, pCkp );
         i ++;  
         // different from the condition in Abc_NtkForEachNode
         // this condition is used to avoid the nodes that may be deleted not in the nework 
@@ -157,7 +246,7 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
         if (pNode == NULL || !Abc_ObjIsNode(pNode)) continue;
         Extra_ProgressBarUpdate( pProgress, i, NULL );
   
-        if (pNode->fHandled){
+        if (Abc_ObjIsHandled(pNode)){
             printf("Abc_NtkRewrite: node %d has been handled.\n", pNode->Id); 
             continue;
         }
@@ -170,7 +259,7 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
         // skip persistant nodes
         if ( Abc_NodeIsPersistant(pNode) ){
             if (fUpdateLevel) {
-                pNode->fHandled = 1;
+                Abc_ObjSetHandled( pNode, 1 );
                 Abc_AigUpdateLevel_Lazy( pNode);
             } 
             continue;
@@ -179,7 +268,7 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
         // skip the nodes with many fanouts
         if ( Abc_ObjFanoutNum(pNode) > 1000 ){
             if (fUpdateLevel) {
-                pNode->fHandled = 1;
+                Abc_ObjSetHandled( pNode, 1 );
                 Abc_AigUpdateLevel_Lazy( pNode);
             } 
             continue;
@@ -193,28 +282,48 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
             Abc_Obj_t * pFanin1 = Abc_ObjFanin1(pNode);         
             if (pFanin0 != NULL) 
             if (!Abc_ObjIsCi(pFanin0) && pFanin0->oLNode != NULL)
-                assert(pFanin0->fHandled);
+                assert(Abc_ObjIsHandled(pFanin0));
             if (pFanin1 != NULL)
             if (!Abc_ObjIsCi(pFanin1) && pFanin1->oLNode != NULL)
-                assert(pFanin1->fHandled);
+                assert(Abc_ObjIsHandled(pFanin1));
              
             Abc_AigUpdateLevel_Lazy(pNode); 
+            // flush the batched level updates if this node may depend on them
+            Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, pNode->Level, 0 );
         }
          
         // avoid persistently rewriting newly created nodes with zero gain 
-        if (pNode->Id > max_node_id) {
-            if (fUpdateLevel)  pNode->fHandled = 1;  
+        if (pNode->Id > max_node_id || Abc_NtkCkpNodeIsFresh(pCkp, pNode)) {
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );  
             i --;
             continue;
         }
        
 
+        // skip the node if the nodes with larger scores use up the budget
+        if ( vScores && pNode->Id < Vec_IntSize(vScores) && Vec_IntEntry(vScores, pNode->Id) >= 0 )
+        {
+            int Score = Vec_IntEntry( vScores, pNode->Id );
+            Vec_IntAddToEntry( vHist, Score, -1 );
+            Vec_IntWriteEntry( vScores, pNode->Id, -1 );
+            if ( !Abc_NtkRewriteSelect( vHist, Score, nEvals, nNodeBudget, clkBudget, clkStop ) )
+            {
+                if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );  
+                nSkips++;
+                continue;
+            }
+            nEvals++;
+        }
+
         // for each cut, try to resynthesize it
-        nGain = Rwr_NodeRewrite( pManRwr, pManCut, pNode, fUpdateLevel, fUseZeros, fPlaceEnable );
+        if ( pPar )
+            nGain = Abc_NtkRewriteParNode( pPar, pManRwr, pManCut, oList->pCurItera, max_node_id, fUpdateLevel, fUseZeros );
+        else
+            nGain = Rwr_NodeRewrite( pManRwr, pManCut, pNode, fUpdateLevel, fUseZeros, fPlaceEnable );
        
 
         if ( !(nGain > 0 || (nGain == 0 && fUseZeros)) ){
-            if (fUpdateLevel)  pNode->fHandled = 1;  
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );  
             continue;
         } 
 
@@ -233,18 +342,26 @@ Rwr_ManAddTimeCuts( pManRwr, Abc_Clock() - clk );
 clk = Abc_Clock(); 
     if ( !Dec_GraphUpdateNetwork( pNode, pGraph, fUpdateLevel, nGain ) )
         {
-            if (fUpdateLevel)  pNode->fHandled = 1;
+            if (fUpdateLevel)  Abc_ObjSetHandled( pNode, 1 );
             RetValue = -1;
             break;
         } 
 Rwr_ManAddTimeUpdate( pManRwr, Abc_Clock() - clk );
     if (fCompl) Dec_GraphComplement(pGraph);
+        if ( vTouched )
+        {
+            Abc_NtkPageRankRefresh( pNtk, vTouched, ABC_RWR_PR_ITERS );
+            Vec_IntClear( vTouched );
+        }
+        if ( pPar )
+            pPar->nCommits++;
         // use the array of changed nodes to update placement
 //        if ( fPlaceEnable )
 //            Abc_PlaceUpdate( vAddedCells, vUpdatedNets ); 
-        global_node_rewritten += 1; 
+        Util_StatAdd( UTIL_STAT_NODES_REWRITTEN, 1 );
+        nRewritten++;
         if ( fUpdateLevel ){
-            pNode->fHandled = 1;
+            Abc_ObjSetHandled( pNode, 1 );
             if (!Abc_AigReplaceUpdateAff( (Abc_Aig_t *)pNtk->pManFunc)){
                 RetValue = -1; 
                 break; 
@@ -252,20 +369,47 @@ Rwr_ManAddTimeUpdate( pManRwr, Abc_Clock() - clk );
         }  
     } 
     Extra_ProgressBarStop( pProgress );
+    // the traversal is over, even if the loop was left early
+    oList->pCurItera = NULL;
+    if ( pPar )
+        Abc_NtkRewriteParStop( pPar, pManRwr, fVerbose );
+    if ( vTouched )
+    {
+        Abc_AigSetTouched( (Abc_Aig_t *)pNtk->pManFunc, NULL );
+        Vec_IntFree( vTouched );
+    }
+    if ( fVerbose && nCompacts )
+        printf( "Compaction: The object IDs were compacted %d times.\n", nCompacts );
+    if ( vScores )
+    {
+        if ( fVerbose )
+            printf( "Budget: Evaluated %d nodes. Skipped %d nodes with smaller scores.\n", nEvals, nSkips );
+        Abc_AigSetDeleted( (Abc_Aig_t *)pNtk->pManFunc, NULL );
+        Vec_IntFree( vDeleted );
+        Vec_IntFree( vScores );
+        Vec_IntFree( vHist );
+    }
+    // flush the remaining batched level updates
+    if ( fUpdateLevel )
+        Abc_AigSetDeferLevels( (Abc_Aig_t *)pNtk->pManFunc, 0 );
      
 
 Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
 
-    ABC_PRT("###global_time ",                   pManRwr->timeTotal);   
-    ABC_PRT("###global_cut ",                    pManRwr->timeCut); 
-    ABC_PRT("###global_resynthesis_time",        pManRwr->timeRes); 
-    ABC_PRT("###global_aig_update_time",         global_aig_update_time); 
-    ABC_PRT("###global_aig_converter_time ",     pManRwr->timeUpdate); 
-      
-    printf("###global_level_updates \t %ld\n",    global_level_updates);   
-    printf("###global_reverse_updates \t %ld\n",  global_reverse_updates);   
-    printf("###global_node_rewritten \t %ld\n",   global_node_rewritten);       
-    printf("###global_reorder_nodes \t %ld\n",    global_reorder_nodes);
+    // print the summary of the metrics
+    if ( fVerbose && Util_StatIsOn() )
+    {
+        ABC_PRT("###global_time ",                   pManRwr->timeTotal);
+        ABC_PRT("###global_cut ",                    pManRwr->timeCut);
+        ABC_PRT("###global_resynthesis_time",        pManRwr->timeRes);
+        ABC_PRT("###global_aig_update_time",         (abctime)Util_StatRead(UTIL_STAT_AIG_UPDATE_TIME));
+        ABC_PRT("###global_aig_converter_time ",     pManRwr->timeUpdate);
+
+        printf("###global_level_updates \t %ld\n",    (long)Util_StatRead(UTIL_STAT_LEVEL_UPDATES));
+        printf("###global_reverse_updates \t %ld\n",  (long)Util_StatRead(UTIL_STAT_REVERSE_UPDATES));
+        printf("###global_node_rewritten \t %ld\n",   (long)nRewritten);
+        printf("###global_reorder_nodes \t %ld\n",    (long)Util_StatRead(UTIL_STAT_REORDER_NODES));
+    }
 
     // print stats
     pManRwr->nNodesEnd = Abc_NtkNodeNum(pNtk);
@@ -276,21 +420,23 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
         Rwr_ScoresReport( pManRwr );
     // delete the managers
     Rwr_ManStop( pManRwr );
-    Cut_ManStop( pManCut );
-    pNtk->pManCut = NULL;
+    // the cuts are kept with the network for the following passes
 
     // clear the mark of fHandled nodes
     List_Ptr_Iterator_t * oLIter = (List_Ptr_Iterator_t*)ABC_ALLOC(List_Ptr_Iterator_t, 1);
     List_PtrForEach(List_Ptr_t*, oList, pNode, oLIter ){ 
-        if (pNode == NULL || !Abc_ObjIsNode(pNode)) continue;
-        if (pNode->Id > max_node_id) {
-            pNode->fHandled = 0;
+        if (pNode == NULL) continue;
+        // the list entries are freed below
+        pNode->oLNode = NULL;
+        if (!Abc_ObjIsNode(pNode)) continue;
+        if (pNode->Id > max_node_id || Abc_NtkCkpNodeIsFresh(pCkp, pNode)) {
+            Abc_ObjSetHandled( pNode, 0 );
             continue;
         }
         // printf("after delete node: %d \n", pNode->Id);
         if ( pNode->Level != 1 + (unsigned)Abc_MaxInt( Abc_ObjFanin0(pNode)->Level, Abc_ObjFanin1(pNode)->Level ) )
-            printf( "Abc_AigCheck immediately after rewrite: Node \"%d\" (%d) handled has level that does not agree with the fanin levels.\n", pNode->fHandled, Abc_ObjId(pNode) );
-        pNode->fHandled = 0;  
+            printf( "Abc_AigCheck immediately after rewrite: Node \"%d\" (%d) handled has level that does not agree with the fanin levels.\n", Abc_ObjIsHandled(pNode), Abc_ObjId(pNode) );
+        Abc_ObjSetHandled( pNode, 0 );  
     }
     List_PtrClear(oList);
     ABC_FREE(oLIter);
@@ -303,6 +449,11 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
 //        Abc_AigUpdateStop( pNtk->pManFunc );
 //    }
 
+    // do not keep the cuts if the update has failed or they are too large
+    if ( RetValue < 0 )
+        Abc_NtkFreeCuts( pNtk );
+    else
+        Abc_NtkLimitCuts( pNtk );
     // put the nodes into the DFS order and reassign their IDs
     {
 //        abctime clk = Abc_Clock();
@@ -331,6 +482,420 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
  
 
 
+/**Function*************************************************************
+
+  Synopsis    [Compacts the object IDs in the middle of the pass.]
+
+  Description [Returns 1 if the IDs were compacted. The nodes keep their 
+  relative order, so the largest ID before the pass (*pNodeIdMax) still 
+  separates the original nodes from the new ones. The entries of the order 
+  list left by the deleted nodes are removed as well.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkRewriteCompact( Abc_Ntk_t * pNtk, int * pNodeIdMax, Vec_Int_t * vScores, Abc_Ckp_t * pCkp )
+{
+    Vec_Int_t * vMap;
+    int i, iNew, nDeleted = Abc_NtkObjNumMax(pNtk) - Abc_NtkObjNum(pNtk);
+    if ( 100 * nDeleted < ABC_RWR_COMPACT * Abc_NtkObjNumMax(pNtk) )
+        return 0;
+    vMap = Abc_NtkCompactIds( pNtk );
+    if ( vMap == NULL )
+        return 0;
+    List_PtrCompact( Abc_AigGetOList((Abc_Aig_t *)pNtk->pManFunc) );
+    // the new largest ID of the original nodes
+    for ( i = Abc_MinInt(*pNodeIdMax, Vec_IntSize(vMap) - 1); i >= 0 && Vec_IntEntry(vMap, i) < 0; i-- );
+    *pNodeIdMax = i >= 0 ? Vec_IntEntry(vMap, i) : -1;
+    if ( vScores )
+    {
+        Vec_IntForEachEntry( vMap, iNew, i )
+            if ( iNew >= 0 && i < Vec_IntSize(vScores) )
+                Vec_IntWriteEntry( vScores, iNew, Vec_IntEntry(vScores, i) );
+        Vec_IntShrink( vScores, Abc_MinInt(Vec_IntSize(vScores), *pNodeIdMax + 1) );
+    }
+    Abc_NtkCkpRemapIds( pCkp, vMap );
+    Vec_IntFree( vMap );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Scores the nodes for the budgeted rewriting.]
+
+  Description [The score of a node is the number of nodes in its MFFC 
+  that are at most two levels below it. Only these nodes are likely to be 
+  covered by the 4-input cuts, so they estimate the gain better than the 
+  full MFFC. Returns the scores by node ID (-1 for the nodes that are not 
+  rewritten) and fills the histogram of the scores. The scores of the
+  visited and the deleted nodes are removed from the histogram.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkRewriteScore_rec( Abc_Obj_t * pNode, int nDepth )
+{
+    Abc_Obj_t * pFanin;
+    int i, Score = 1;
+    if ( nDepth == 0 )
+        return Score;
+    Abc_ObjForEachFanin( pNode, pFanin, i )
+        if ( Abc_ObjIsNode(pFanin) && Abc_ObjFanoutNum(pFanin) == 1 )
+            Score += Abc_NtkRewriteScore_rec( pFanin, nDepth - 1 );
+    return Score;
+}
+Vec_Int_t * Abc_NtkRewriteScores( Abc_Ntk_t * pNtk, Vec_Int_t * vHist )
+{
+    Vec_Int_t * vScores = Vec_IntStartFull( Abc_NtkObjNumMax(pNtk) );
+    Abc_Obj_t * pNode;
+    int i, Score;
+    Abc_NtkForEachNode( pNtk, pNode, i )
+    {
+        if ( Abc_NodeIsPersistant(pNode) || Abc_ObjFanoutNum(pNode) > 1000 )
+            continue;
+        Score = Abc_NtkRewriteScore_rec( pNode, 2 );
+        Vec_IntWriteEntry( vScores, pNode->Id, Score );
+        Vec_IntAddToEntry( vHist, Score, 1 );
+    }
+    return vScores;
+}
+void Abc_NtkRewriteUnscore( Vec_Int_t * vScores, Vec_Int_t * vHist, Vec_Int_t * vDeleted )
+{
+    int i, Id;
+    Vec_IntForEachEntry( vDeleted, Id, i )
+        if ( Id < Vec_IntSize(vScores) && Vec_IntEntry(vScores, Id) >= 0 )
+        {
+            Vec_IntAddToEntry( vHist, Vec_IntEntry(vScores, Id), -1 );
+            Vec_IntWriteEntry( vScores, Id, -1 );
+        }
+    Vec_IntClear( vDeleted );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Decides whether the node fits into the budget.]
+
+  Description [The histogram contains the scores of the nodes that are 
+  not visited yet. The node is evaluated if the number of these nodes 
+  with larger scores is below the number of evaluations left in the 
+  budget. When the runtime is limited, the number of evaluations left 
+  is estimated from the average time spent per evaluation so far.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkRewriteSelect( Vec_Int_t * vHist, int Score, int nEvals, int nNodeBudget, abctime clkStart, abctime clkStop )
+{
+    int s, nAbove = 0, nLeft = nNodeBudget > 0 ? nNodeBudget - nEvals : ABC_INFINITY;
+    if ( clkStop )
+    {
+        abctime clkNow = Abc_Clock();
+        if ( clkNow >= clkStop )
+            return 0;
+        if ( nEvals > 0 )
+            nLeft = Abc_MinInt( nLeft, (int)Abc_MinDouble( (double)nEvals * (clkStop - clkNow) / Abc_MaxDouble(clkNow - clkStart, 1), ABC_INFINITY ) );
+    }
+    for ( s = Score + 1; s < Vec_IntSize(vHist); s++ )
+        nAbove += Vec_IntEntry( vHist, s );
+    return nAbove < nLeft;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Evaluates the nodes of one job.]
+
+  Description [The threads are started once for the pass. They wait at
+  the barrier for the next batch, evaluate their nodes without modifying
+  the network and meet again at the barrier when they are done. The main
+  thread evaluates the nodes of the first job.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_NtkRewriteParJob( Abc_RwrJob_t * pJob )
+{
+    int i;
+    for ( i = pJob->iJob; i < pJob->nSpecs; i += pJob->nJobs )
+        Rwr_NodeRewriteSpec( pJob->pManRwr, pJob->pSpecs + i );
+}
+#ifdef ABC_USE_PTHREADS
+static void Abc_NtkRewriteParBarrier( Abc_RwrPar_t * p )
+{
+    int Phase;
+    pthread_mutex_lock( &p->Mutex );
+    Phase = p->Phase;
+    if ( ++p->nWaiting == Vec_PtrSize(p->vJobs) )
+    {
+        p->nWaiting = 0;
+        p->Phase++;
+        pthread_cond_broadcast( &p->Cond );
+    }
+    else while ( Phase == p->Phase )
+        pthread_cond_wait( &p->Cond, &p->Mutex );
+    pthread_mutex_unlock( &p->Mutex );
+}
+static void * Abc_NtkRewriteParWorker( void * pArg )
+{
+    Abc_RwrJob_t * pJob = (Abc_RwrJob_t *)pArg;
+    Abc_RwrPar_t * p = pJob->pPar;
+    while ( 1 )
+    {
+        Abc_NtkRewriteParBarrier( p );
+        if ( p->fStop )
+            break;
+        Abc_NtkRewriteParJob( pJob );
+        Abc_NtkRewriteParBarrier( p );
+    }
+    return NULL;
+}
+#endif
+
+/**Function*************************************************************
+
+  Synopsis    [Starts speculative evaluation of the nodes.]
+
+  Description [Each thread gets its own rewriting manager because the
+  evaluation writes the leaves into the subgraphs of the manager.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_RwrPar_t * Abc_NtkRewriteParStart( Abc_Ntk_t * pNtk, int nThreads )
+{
+    Abc_RwrPar_t * p;
+    Abc_RwrJob_t * pJob;
+    int i;
+    assert( nThreads >= 1 && nThreads <= ABC_RESYN_THREADS_MAX );
+    p = ABC_CALLOC( Abc_RwrPar_t, 1 );
+    p->nSpecsMax = ABC_RWR_BATCH * nThreads;
+    p->pSpecs    = ABC_CALLOC( Rwr_Spec_t, p->nSpecsMax );
+    for ( i = 0; i < p->nSpecsMax; i++ )
+        p->pSpecs[i].vWindow = Vec_IntAlloc( 100 );
+    p->vSpecMap  = Vec_IntStartFull( Abc_NtkObjNumMax(pNtk) + 1 );
+    p->vJobs     = Vec_PtrAlloc( nThreads );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        pJob = ABC_CALLOC( Abc_RwrJob_t, 1 );
+        pJob->pPar    = p;
+        pJob->pManRwr = Rwr_ManStart( 0 );
+        pJob->iJob    = i;
+        pJob->nJobs   = nThreads;
+        Vec_PtrPush( p->vJobs, pJob );
+    }
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_init( &p->Mutex, NULL );
+    pthread_cond_init( &p->Cond, NULL );
+    p->pThreads = ABC_CALLOC( pthread_t, nThreads );
+    for ( i = 1; i < nThreads; i++ )
+    {
+        int status = pthread_create( p->pThreads + i, NULL, Abc_NtkRewriteParWorker, Vec_PtrEntry(p->vJobs, i) );
+        assert( status == 0 );
+    }
+#endif
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stops speculative evaluation of the nodes.]
+
+  Description [Stops the threads and adds their statistics to the main
+  manager.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkRewriteParStop( Abc_RwrPar_t * p, Rwr_Man_t * pManRwr, int fVerbose )
+{
+    Abc_RwrJob_t * pJob;
+    int i;
+#ifdef ABC_USE_PTHREADS
+    p->fStop = 1;
+    Abc_NtkRewriteParBarrier( p );
+    for ( i = 1; i < Vec_PtrSize(p->vJobs); i++ )
+    {
+        int status = pthread_join( p->pThreads[i], NULL );
+        assert( status == 0 );
+    }
+    pthread_cond_destroy( &p->Cond );
+    pthread_mutex_destroy( &p->Mutex );
+    ABC_FREE( p->pThreads );
+#endif
+    Vec_PtrForEachEntry( Abc_RwrJob_t *, p->vJobs, pJob, i )
+    {
+        pManRwr->nNodesConsidered += pJob->pManRwr->nNodesConsidered;
+        pManRwr->nCutsGood        += pJob->pManRwr->nCutsGood;
+        pManRwr->nCutsBad         += pJob->pManRwr->nCutsBad;
+        pManRwr->nSubgraphs       += pJob->pManRwr->nSubgraphs;
+        Rwr_ManStop( pJob->pManRwr );
+        ABC_FREE( pJob );
+    }
+    if ( fVerbose )
+        printf( "Speculation: Threads = %d. Batches = %d. Trusted = %d. Checked = %d. Reevaluated = %d.\n",
+            Vec_PtrSize(p->vJobs), p->nBatches, p->nTrusted, p->nChecked, p->nReevals );
+    for ( i = 0; i < p->nSpecsMax; i++ )
+        Vec_IntFree( p->pSpecs[i].vWindow );
+    Vec_PtrFree( p->vJobs );
+    Vec_IntFree( p->vSpecMap );
+    ABC_FREE( p->pSpecs );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Evaluates the nodes of one batch.]
+
+  Description [The batch contains the nodes that follow the current one
+  in the order list and are going to be rewritten. The cuts and required
+  levels are computed here, after which the threads evaluate the nodes
+  without modifying the network.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_NtkRewriteParBatch( Abc_RwrPar_t * p, Cut_Man_t * pManCut, List_Ptr_Node_t * pStart, int nNodeIdMax, int fUpdateLevel )
+{
+    Abc_Ntk_t * pNtk = ((Abc_Obj_t *)pStart->pData)->pNtk;
+    List_Ptr_Node_t * pCur;
+    Abc_RwrJob_t * pJob;
+    Rwr_Spec_t * pSpec;
+    Abc_Obj_t * pNode;
+    int i;
+    // forget the nodes of the previous batch
+    for ( i = 0; i < p->nSpecs; i++ )
+        Vec_IntWriteEntry( p->vSpecMap, p->pSpecs[i].Id, -1 );
+    // the levels should be up to date
+    if ( fUpdateLevel )
+        Abc_AigUpdateLevel_Trigger( (Abc_Aig_t *)pNtk->pManFunc, 0, 1 );
+    // collect the nodes in the same way as Abc_NtkRewrite() does
+    p->nSpecs = 0;
+    for ( pCur = pStart; pCur && p->nSpecs < p->nSpecsMax; pCur = pCur->pNext )
+    {
+        pNode = (Abc_Obj_t *)pCur->pData;
+        if ( pNode == NULL || !Abc_ObjIsNode(pNode) || Abc_ObjIsHandled(pNode) || pNode->Id > nNodeIdMax )
+            continue;
+        if ( Abc_NodeIsPersistant(pNode) || Abc_ObjFanoutNum(pNode) > 1000 )
+            continue;
+        if ( fUpdateLevel )
+            Abc_AigUpdateLevel_Lazy( pNode );
+        pSpec = p->pSpecs + p->nSpecs;
+        pSpec->pNode    = pNode;
+        pSpec->Id       = pNode->Id;
+        pSpec->pCuts    = Abc_NodeGetCutsRecursive( pManCut, pNode, 0, 0 );
+        pSpec->Required = fUpdateLevel? Abc_ObjRequiredLevel(pNode) : ABC_INFINITY;
+        Vec_IntWriteEntry( p->vSpecMap, pNode->Id, p->nSpecs++ );
+    }
+    // evaluate the nodes
+    Vec_PtrForEachEntry( Abc_RwrJob_t *, p->vJobs, pJob, i )
+    {
+        pJob->pSpecs = p->pSpecs;
+        pJob->nSpecs = p->nSpecs;
+    }
+#ifdef ABC_USE_PTHREADS
+    Abc_NtkRewriteParBarrier( p );
+    Abc_NtkRewriteParJob( (Abc_RwrJob_t *)Vec_PtrEntry(p->vJobs, 0) );
+    Abc_NtkRewriteParBarrier( p );
+#else
+    Vec_PtrForEachEntry( Abc_RwrJob_t *, p->vJobs, pJob, i )
+        Abc_NtkRewriteParJob( pJob );
+#endif
+    p->nCommitsBatch = p->nCommits;
+    p->nBatches++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the gain of rewriting the current node.]
+
+  Description [Uses the result of speculative evaluation, which is
+  computed for the next batch of nodes when the node is not in the
+  current batch. If other nodes were rewritten after the batch was
+  evaluated, the result is validated: a replacement is recounted in
+  the current network and a failed evaluation is kept only if its
+  window is unchanged. Otherwise, the node is evaluated again.
+  Returns the gain like Rwr_NodeRewrite() and similarly sets the
+  graph and its leaves in the manager.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkRewriteParNode( Abc_RwrPar_t * p, Rwr_Man_t * pManRwr, Cut_Man_t * pManCut, List_Ptr_Node_t * pCur, int nNodeIdMax, int fUpdateLevel, int fUseZeros )
+{
+    Abc_Obj_t * pNode = (Abc_Obj_t *)pCur->pData;
+    Rwr_Spec_t * pSpec;
+    int i, iSpec, fAccept, Gain;
+    if ( Vec_IntEntry(p->vSpecMap, pNode->Id) == -1 )
+        Abc_NtkRewriteParBatch( p, pManCut, pCur, nNodeIdMax, fUpdateLevel );
+    iSpec = Vec_IntEntry( p->vSpecMap, pNode->Id );
+    assert( iSpec >= 0 );
+    Vec_IntWriteEntry( p->vSpecMap, pNode->Id, -1 );
+    pSpec = p->pSpecs + iSpec;
+    assert( pSpec->pNode == pNode );
+    fAccept = pSpec->Gain > 0 || (pSpec->Gain == 0 && fUseZeros);
+    if ( p->nCommits == p->nCommitsBatch )
+    {
+        // the network did not change since the evaluation
+        Gain = pSpec->Gain;
+        p->nTrusted++;
+    }
+    else if ( fAccept )
+    {
+        // the replacement is used if its gain did not change
+        Gain = Rwr_NodeRewriteCheck( pManRwr, pSpec, fUpdateLevel );
+        if ( Gain != pSpec->Gain )
+        {
+            p->nReevals++;
+            // the cuts were computed before the window changed (the kept cuts of
+            // the fanouts were derived from them)
+            Abc_NodeFreeCutsTfo( pManCut, pNode );
+            return Rwr_NodeRewrite( pManRwr, pManCut, pNode, fUpdateLevel, fUseZeros, 0 );
+        }
+        p->nChecked++;
+    }
+    else
+    {
+        // the failure is kept if the window did not change
+        if ( (fUpdateLevel && pSpec->Required != Abc_ObjRequiredLevel(pNode)) ||
+             pSpec->uWindow != Rwr_NodeWindowHash(pNode, pSpec->vWindow, pManRwr->vCone, fUpdateLevel) )
+        {
+            p->nReevals++;
+            // the cuts were computed before the window changed (the kept cuts of
+            // the fanouts were derived from them)
+            Abc_NodeFreeCutsTfo( pManCut, pNode );
+            return Rwr_NodeRewrite( pManRwr, pManCut, pNode, fUpdateLevel, fUseZeros, 0 );
+        }
+        Gain = pSpec->Gain;
+        p->nChecked++;
+    }
+    if ( Gain == -1 )
+        return -1;
+    // save the replacement in the main manager
+    pManRwr->pGraph = pSpec->pGraph;
+    pManRwr->fCompl = pSpec->fCompl;
+    for ( i = 0; i < 4; i++ )
+        Dec_GraphNode((Dec_Graph_t *)pSpec->pGraph, i)->pFunc = pSpec->pFanins[i];
+    if ( fAccept )
+        pManRwr->nNodesRewritten++;
+    pManRwr->nNodesGained += Gain;
+    return Gain;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Starts the cut manager for rewriting.]
@@ -342,9 +907,9 @@ Rwr_ManAddTimeTotal( pManRwr, Abc_Clock() - clkStart );
   SeeAlso     []
 
 ***********************************************************************/
-Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk )
+void * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk )
 {
-    static Cut_Params_t Params, * pParams = &Params;
+    Cut_Params_t Params, * pParams = &Params;
     Cut_Man_t * pManCut;
     Abc_Obj_t * pObj;
     int i;
@@ -358,6 +923,22 @@ Cut_Man_t * Abc_NtkStartCutManForRewrite( Abc_Ntk_t * pNtk )
     pParams->fDrop     = 0;     // drop cuts on the fly
     pParams->fVerbose  = 0;     // the verbosiness flag
     pParams->nIdsMax   = Abc_NtkObjNumMax( pNtk );
+    // reuse the cuts left by the previous pass if they were computed in the same way
+    pManCut = (Cut_Man_t *)pNtk->pManCut;
+    if ( pManCut )
+    {
+        Cut_Params_t * pOld = Cut_ManReadParams( pManCut );
+        if ( pOld->nVarsMax == pParams->nVarsMax && pOld->nKeepMax == pParams->nKeepMax &&
+             pOld->fTruth == pParams->fTruth && pOld->fFilter == pParams->fFilter &&
+             pOld->fSeq == pParams->fSeq && pOld->fDrop == pParams->fDrop )
+        {
+            Abc_NtkForEachCi( pNtk, pObj, i )
+                if ( Abc_ObjFanoutNum(pObj) > 0 && Abc_NodeReadCuts(pManCut, pObj) == NULL )
+                    Cut_NodeSetTriv( pManCut, pObj->Id );
+            return pManCut;
+        }
+        Abc_NtkFreeCuts( pNtk );
+    }
     pManCut = Cut_ManStart( pParams );
     if ( pParams->fDrop )
         Cut_ManSetFanoutCounts( pManCut, Abc_NtkFanoutCounts(pNtk) );
@@ -1281,6 +1281,17 @@ void Abc_NtkStartReverseLevels( Abc_Ntk_t * pNtk, int nMaxLevelIncrease )
     // start the reverse levels
     pNtk->vLevelsR = Vec_IntAlloc( 0 );
     Vec_IntFill( pNtk->vLevelsR, 1 + Abc_NtkObjNumMax(pNtk), 0 );
+    // in the AIG, the fanouts of a node have larger levels
+    if ( Abc_NtkIsStrash(pNtk) )
+    {
+        B_Que_t * qNodes = B_QueAlloc( pNtk->LevelMax + 1 );
+        Abc_NtkForEachNode( pNtk, pObj, i )
+            B_QuePush( qNodes, pObj, Abc_ObjLevel(pObj) );
+        while ( (pObj = (Abc_Obj_t *)B_QuePopMax(qNodes)) )
+            Abc_ObjSetReverseLevel( pObj, Abc_ObjReverseLevelNew(pObj) );
+        B_QueFree( qNodes );
+        return;
+    }
     // compute levels in reverse topological order
     vNodes = Abc_NtkDfsReverse( pNtk );
     Vec_PtrForEachEntry( Abc_Obj_t *, vNodes, pObj, i )
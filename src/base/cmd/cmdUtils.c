@@ -156,6 +156,8 @@ int CmdCommandDispatch( Abc_Frame_t * pAbc, int * pargc, char *** pargv )
     pFunc = (int (*)(Abc_Frame_t *, int, char **))pCommand->pFunc;
     fError = (*pFunc)( pAbc, argc, argv );
     pAbc->TimeCommand += Extra_CpuTimeDouble() - clk;
+    // save the metrics collected by the command
+    Util_StatCommandEnd( argc, argv );
 
     // automatic execution of arbitrary command after each command 
     // usually this is a passive command ... 
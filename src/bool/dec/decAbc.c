@@ -29,6 +29,9 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+int Dec_GraphToNetworkCountMffc( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, Vec_Ptr_t * vMffc, int NodeMax, int LevelMax );
+Abc_Obj_t * Dec_GraphToNetworkBatch( Abc_Ntk_t * pNtk, Dec_Graph_t * pGraph );
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -67,6 +70,86 @@ Abc_Obj_t * Dec_GraphToNetwork( Abc_Ntk_t * pNtk, Dec_Graph_t * pGraph )
     return Abc_ObjNotCond( (Abc_Obj_t *)pNode->pFunc, Dec_GraphIsComplement(pGraph) );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Transforms the decomposition graph into the AIG in one batch.]
+
+  Description [Produces the same nodes as Dec_GraphToNetwork(). The object
+  array is grown once for all the nodes of the graph. The nodes whose fanins
+  are both leaves are looked up first: the table entries are prefetched
+  together and then probed, and the leaves of the missing nodes get the room
+  for their new fanouts. The other nodes depend on the nodes of the graph
+  and are looked up one by one while the graph is built, as before.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Obj_t * Dec_GraphToNetworkBatch( Abc_Ntk_t * pNtk, Dec_Graph_t * pGraph )
+{
+    Abc_Aig_t * pMan = (Abc_Aig_t *)pNtk->pManFunc;
+    Abc_Obj_t * pAnd0, * pAnd1, * pLeafObj;
+    Dec_Node_t * pNode = NULL; // Suppress "might be used uninitialized"
+    Dec_Node_t * pLeaf;
+    int i, k, nLeaves, nMisses, nFanouts;
+    // check for constant function
+    if ( Dec_GraphIsConst(pGraph) )
+        return Abc_ObjNotCond( Abc_AigConst1(pNtk), Dec_GraphIsComplement(pGraph) );
+    // check for a literal
+    if ( Dec_GraphIsVar(pGraph) )
+        return Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphVar(pGraph)->pFunc, Dec_GraphIsComplement(pGraph) );
+    // reserve the IDs of the new nodes (keeping the growth of the array geometric)
+    if ( Vec_PtrSize(pNtk->vObjs) + Dec_GraphNodeNum(pGraph) > Vec_PtrCap(pNtk->vObjs) )
+        Vec_PtrGrow( pNtk->vObjs, Abc_MaxInt( 2 * Vec_PtrCap(pNtk->vObjs), Vec_PtrSize(pNtk->vObjs) + Dec_GraphNodeNum(pGraph) ) );
+    // prefetch the table entries of the nodes whose fanins are leaves
+    nLeaves = Dec_GraphLeaveNum(pGraph);
+    Dec_GraphForEachNode( pGraph, pNode, i )
+    {
+        if ( (int)pNode->eEdge0.Node >= nLeaves || (int)pNode->eEdge1.Node >= nLeaves )
+            continue;
+        pAnd0 = Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphNode(pGraph, pNode->eEdge0.Node)->pFunc, pNode->eEdge0.fCompl ); 
+        pAnd1 = Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphNode(pGraph, pNode->eEdge1.Node)->pFunc, pNode->eEdge1.fCompl ); 
+        Abc_AigAndPrefetch( pMan, pAnd0, pAnd1 );
+    }
+    // probe these entries and count the missing nodes
+    nMisses = 0;
+    Dec_GraphForEachNode( pGraph, pNode, i )
+    {
+        if ( (int)pNode->eEdge0.Node >= nLeaves || (int)pNode->eEdge1.Node >= nLeaves )
+            continue;
+        pAnd0 = Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphNode(pGraph, pNode->eEdge0.Node)->pFunc, pNode->eEdge0.fCompl ); 
+        pAnd1 = Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphNode(pGraph, pNode->eEdge1.Node)->pFunc, pNode->eEdge1.fCompl ); 
+        pNode->pFunc = Abc_AigAndLookup( pMan, pAnd0, pAnd1 );
+        nMisses += (pNode->pFunc == NULL);
+    }
+    // reserve the fanouts of the leaves used by the missing nodes
+    if ( nMisses )
+    {
+        Dec_GraphForEachLeaf( pGraph, pLeaf, k )
+        {
+            nFanouts = 0;
+            Dec_GraphForEachNode( pGraph, pNode, i )
+                if ( (int)pNode->eEdge0.Node < nLeaves && (int)pNode->eEdge1.Node < nLeaves && pNode->pFunc == NULL )
+                    nFanouts += ((int)pNode->eEdge0.Node == k) + ((int)pNode->eEdge1.Node == k);
+            pLeafObj = Abc_ObjRegular( (Abc_Obj_t *)pLeaf->pFunc );
+            if ( nFanouts )
+                Abc_ObjReserveFanouts( pLeafObj, Abc_ObjFanoutNum(pLeafObj) + nFanouts );
+        }
+    }
+    // build the AIG nodes corresponding to the AND gates of the graph
+    Dec_GraphForEachNode( pGraph, pNode, i )
+    {
+        if ( (int)pNode->eEdge0.Node < nLeaves && (int)pNode->eEdge1.Node < nLeaves && pNode->pFunc )
+            continue;
+        pAnd0 = Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphNode(pGraph, pNode->eEdge0.Node)->pFunc, pNode->eEdge0.fCompl ); 
+        pAnd1 = Abc_ObjNotCond( (Abc_Obj_t *)Dec_GraphNode(pGraph, pNode->eEdge1.Node)->pFunc, pNode->eEdge1.fCompl ); 
+        pNode->pFunc = Abc_AigAnd( pMan, pAnd0, pAnd1 );
+    }
+    // complement the result if necessary
+    return Abc_ObjNotCond( (Abc_Obj_t *)pNode->pFunc, Dec_GraphIsComplement(pGraph) );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Transforms the decomposition graph into the AIG.]
@@ -167,6 +250,25 @@ Abc_Obj_t * Dec_GraphToNetworkNoStrash( Abc_Ntk_t * pNtk, Dec_Graph_t * pGraph )
 
 ***********************************************************************/
 int Dec_GraphToNetworkCount( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int NodeMax, int LevelMax )
+{
+    return Dec_GraphToNetworkCountMffc( pRoot, pGraph, NULL, NodeMax, LevelMax );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Counts the number of new nodes added when using this graph.]
+
+  Description [If vMffc is given, it contains the MFFC of the root. 
+  Otherwise, the MFFC is labeled with the current traversal ID.
+  The former does not write into the network and can be called 
+  concurrently for different roots.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Dec_GraphToNetworkCountMffc( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, Vec_Ptr_t * vMffc, int NodeMax, int LevelMax )
 {
     Abc_Aig_t * pMan = (Abc_Aig_t *)pRoot->pNtk->pManFunc;
     Dec_Node_t * pNode, * pNode0, * pNode1;
@@ -202,7 +304,7 @@ int Dec_GraphToNetworkCount( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int NodeMa
         else
             pAnd = NULL;
         // count the number of added nodes
-        if ( pAnd == NULL || Abc_NodeIsTravIdCurrent(Abc_ObjRegular(pAnd)) ) 
+        if ( pAnd == NULL || (vMffc ? Vec_PtrFind(vMffc, Abc_ObjRegular(pAnd)) >= 0 : Abc_NodeIsTravIdCurrent(Abc_ObjRegular(pAnd))) ) 
         {
             if ( ++Counter > NodeMax )
                 return -1;
@@ -250,15 +352,16 @@ int Dec_GraphToNetworkCount( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int NodeMa
 ***********************************************************************/
 int Dec_GraphUpdateNetwork( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain )
 {
-    extern Abc_Obj_t *    Dec_GraphToNetwork( Abc_Ntk_t * pNtk, Dec_Graph_t * pGraph );
     Abc_Obj_t * pRootNew;
     Abc_Ntk_t * pNtk = pRoot->pNtk;
     int nNodesNew, nNodesOld, RetValue;
+    abctime clk = Util_StatClock();
     nNodesOld = Abc_NtkNodeNum(pNtk);
     // create the new structure of nodes
-    pRootNew = Dec_GraphToNetwork( pNtk, pGraph );
+    pRootNew = Dec_GraphToNetworkBatch( pNtk, pGraph );
     // remove the old nodes
     RetValue = Abc_AigReplaceInc( (Abc_Aig_t *)pNtk->pManFunc, pRoot, pRootNew, fUpdateLevel );
+    Util_StatAddTime( UTIL_STAT_NODE_UPDATE, clk );
 
     // compare the gains
     nNodesNew = Abc_NtkNodeNum(pNtk);
@@ -283,15 +386,16 @@ int Dec_GraphUpdateNetwork( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdate
 ***********************************************************************/
 int Dec_GraphUpdateNetworkLevelUpdate( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int fUpdateLevel, int nGain)
 {
-    extern Abc_Obj_t *    Dec_GraphToNetwork( Abc_Ntk_t * pNtk, Dec_Graph_t * pGraph );
     Abc_Obj_t * pRootNew;
     Abc_Ntk_t * pNtk = pRoot->pNtk;
     int nNodesNew, nNodesOld, RetValue;
+    abctime clk = Util_StatClock();
     nNodesOld = Abc_NtkNodeNum(pNtk);
     // create the new structure of nodes
-    pRootNew = Dec_GraphToNetwork( pNtk, pGraph );
+    pRootNew = Dec_GraphToNetworkBatch( pNtk, pGraph );
     // remove the old nodes
     RetValue = Abc_AigReplaceIncLevelUpdate( (Abc_Aig_t *)pNtk->pManFunc, pRoot, pRootNew, fUpdateLevel );
+    Util_StatAddTime( UTIL_STAT_NODE_UPDATE, clk );
 
     // compare the gains
     nNodesNew = Abc_NtkNodeNum(pNtk);
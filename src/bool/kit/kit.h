@@ -96,6 +96,21 @@ struct Kit_Graph_t_
     Kit_Edge_t        eRoot;           // the pointer to the topmost node
 };
 
+// the cache of factored forms indexed by truth tables
+typedef struct Kit_GraphCache_t_ Kit_GraphCache_t;
+struct Kit_GraphCache_t_
+{
+    int               nVarsMax;        // the largest support size
+    int               nWordsMax;       // the limit on the truth table memory (in words)
+    int               nWords;          // the truth table memory (in words)
+    Vec_Mem_t **      pTtMems;         // the truth tables for each support size
+    Vec_Ptr_t **      pGraphs;         // the factored forms for each support size
+    // statistics
+    int               nLookups;        // the number of lookups
+    int               nHits;           // the number of hits
+    int               nFlushes;        // the number of times the cache was flushed
+};
+
 
 // DSD node types
 typedef enum { 
@@ -567,6 +582,11 @@ extern Kit_Edge_t      Kit_GraphAddNodeMux( Kit_Graph_t * pGraph, Kit_Edge_t eEd
 extern unsigned        Kit_GraphToTruth( Kit_Graph_t * pGraph );
 extern Kit_Graph_t *   Kit_TruthToGraph( unsigned * pTruth, int nVars, Vec_Int_t * vMemory );
 extern Kit_Graph_t *   Kit_TruthToGraph2( unsigned * pTruth0, unsigned * pTruth1, int nVars, Vec_Int_t * vMemory );
+extern Kit_Graph_t *   Kit_GraphDup( Kit_Graph_t * pGraph );
+extern Kit_GraphCache_t * Kit_GraphCacheStart( int nVarsMax, int nWordsMax );
+extern void            Kit_GraphCacheStop( Kit_GraphCache_t * p );
+extern void            Kit_GraphCachePrintStats( Kit_GraphCache_t * p );
+extern Kit_Graph_t *   Kit_TruthToGraphCache( Kit_GraphCache_t * p, unsigned * pTruth, int nVars, Vec_Int_t * vMemory );
 extern int             Kit_GraphLeafDepth_rec( Kit_Graph_t * pGraph, Kit_Node_t * pNode, Kit_Node_t * pLeaf );
 extern int             Kit_TruthLitNum( unsigned * pTruth, int nVars, Vec_Int_t * vMemory );
 /*=== kitHop.c ==========================================================*/
@@ -398,6 +398,146 @@ Kit_Graph_t * Kit_TruthToGraph2( unsigned * pTruth0, unsigned * pTruth1, int nVa
     return pGraph;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Duplicates the graph.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Kit_Graph_t * Kit_GraphDup( Kit_Graph_t * pGraph )
+{
+    Kit_Graph_t * pGraphNew;
+    pGraphNew = ABC_ALLOC( Kit_Graph_t, 1 );
+    *pGraphNew = *pGraph;
+    if ( pGraph->pNodes == NULL )
+        return pGraphNew;
+    pGraphNew->nCap   = Abc_MaxInt( pGraph->nSize, 1 );
+    pGraphNew->pNodes = ABC_ALLOC( Kit_Node_t, pGraphNew->nCap );
+    memcpy( pGraphNew->pNodes, pGraph->pNodes, sizeof(Kit_Node_t) * pGraph->nSize );
+    return pGraphNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the cache of factored forms.]
+
+  Description [The cache keeps the factored forms derived for the truth 
+  tables with up to nVarsMax variables. When the truth tables take more
+  than nWordsMax words, the cache is flushed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Kit_GraphCache_t * Kit_GraphCacheStart( int nVarsMax, int nWordsMax )
+{
+    Kit_GraphCache_t * p;
+    p = ABC_CALLOC( Kit_GraphCache_t, 1 );
+    p->nVarsMax  = nVarsMax;
+    p->nWordsMax = nWordsMax;
+    p->pTtMems   = ABC_CALLOC( Vec_Mem_t *, nVarsMax + 1 );
+    p->pGraphs   = ABC_CALLOC( Vec_Ptr_t *, nVarsMax + 1 );
+    return p;
+}
+static void Kit_GraphCacheFlush( Kit_GraphCache_t * p )
+{
+    Kit_Graph_t * pGraph;
+    int v, i;
+    for ( v = 0; v <= p->nVarsMax; v++ )
+    {
+        if ( p->pTtMems[v] == NULL )
+            continue;
+        Vec_PtrForEachEntry( Kit_Graph_t *, p->pGraphs[v], pGraph, i )
+            if ( pGraph )
+                Kit_GraphFree( pGraph );
+        Vec_PtrFree( p->pGraphs[v] );
+        Vec_MemHashFree( p->pTtMems[v] );
+        Vec_MemFree( p->pTtMems[v] );
+        p->pGraphs[v] = NULL;
+        p->pTtMems[v] = NULL;
+    }
+    p->nWords = 0;
+}
+void Kit_GraphCacheStop( Kit_GraphCache_t * p )
+{
+    Kit_GraphCacheFlush( p );
+    ABC_FREE( p->pTtMems );
+    ABC_FREE( p->pGraphs );
+    ABC_FREE( p );
+}
+void Kit_GraphCachePrintStats( Kit_GraphCache_t * p )
+{
+    printf( "FF cache: Lookups = %d. Hits = %d. (%6.2f %%)  Flushes = %d.  Memory = %.2f MB.\n", 
+        p->nLookups, p->nHits, 100.0*p->nHits/Abc_MaxInt(p->nLookups, 1), p->nFlushes, 8.0*p->nWords/(1<<20) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the factored form from the truth table using the cache.]
+
+  Description [Returns a copy of the factored form computed by 
+  Kit_TruthToGraph() for the same truth table, which the caller should
+  free. The truth tables are matched exactly, so the result is the same
+  as without the cache.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Kit_Graph_t * Kit_TruthToGraphCache( Kit_GraphCache_t * p, unsigned * pTruth, int nVars, Vec_Int_t * vMemory )
+{
+    Kit_Graph_t * pGraph;
+    word uTruth, * pEntry;
+    int nWords, * pSpot;
+    if ( p == NULL || nVars > p->nVarsMax )
+        return Kit_TruthToGraph( pTruth, nVars, vMemory );
+    p->nLookups++;
+    // the key is the part of the truth table used by Kit_TruthToGraph()
+    if ( nVars <= 5 )
+    {
+        uTruth = (word)pTruth[0];
+        pEntry = &uTruth;
+    }
+    else
+        pEntry = (word *)pTruth;
+    nWords = nVars <= 6 ? 1 : (1 << (nVars - 6));
+    if ( p->pTtMems[nVars] )
+    {
+        pSpot = Vec_MemHashLookup( p->pTtMems[nVars], pEntry );
+        if ( *pSpot != -1 )
+        {
+            p->nHits++;
+            pGraph = (Kit_Graph_t *)Vec_PtrEntry( p->pGraphs[nVars], *pSpot );
+            return pGraph ? Kit_GraphDup( pGraph ) : NULL;
+        }
+    }
+    pGraph = Kit_TruthToGraph( pTruth, nVars, vMemory );
+    // save the result, including the failure
+    if ( p->nWords + nWords > p->nWordsMax )
+    {
+        Kit_GraphCacheFlush( p );
+        p->nFlushes++;
+    }
+    if ( p->pTtMems[nVars] == NULL )
+    {
+        p->pTtMems[nVars] = Vec_MemAlloc( nWords, 12 );
+        Vec_MemHashAlloc( p->pTtMems[nVars], 1000 );
+        p->pGraphs[nVars] = Vec_PtrAlloc( 1000 );
+    }
+    Vec_MemHashInsert( p->pTtMems[nVars], pEntry );
+    Vec_PtrPush( p->pGraphs[nVars], pGraph ? Kit_GraphDup( pGraph ) : NULL );
+    assert( Vec_MemEntryNum(p->pTtMems[nVars]) == Vec_PtrSize(p->pGraphs[nVars]) );
+    p->nWords += nWords;
+    return pGraph;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Derives the maximum depth from the leaf to the root.]
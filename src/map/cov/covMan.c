@@ -48,6 +48,7 @@ Cov_Man_t * Cov_ManAlloc( Abc_Ntk_t * pNtk, int nFaninMax, int nCubesMax )
     Cov_Obj_t * pMem;
     Abc_Obj_t * pObj;
     int i;
+    Abc_NtkFreeCuts( pNtk );
     assert( pNtk->pManCut == NULL );
 
     // start the manager
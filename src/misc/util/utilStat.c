@@ -0,0 +1,411 @@
+/**CFile****************************************************************
+
+  FileName    [utilStat.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Metrics of the commands.]
+
+  Synopsis    [Named counters, timers and histograms.]
+
+  Author      [ABC contributors]
+
+  Affiliation [ABC open-source project]
+
+  Date        [Ver. 1.0. Started - October 17, 2026.]
+
+  Revision    [$Id: utilStat.c,v 1.00 2026/10/17 00:00:00 abc Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <assert.h>
+
+#include "abc_global.h"
+#include "misc/vec/vec.h"
+#include "utilStat.h"
+
+ABC_NAMESPACE_IMPL_START
+
+/*
+    The metrics are updated by the procedures of the current command.
+    The updates are atomic, so that the threads started by the command
+    can update the metrics too. When the command is over, the non-zero
+    metrics are saved into a record labeled by the command line and reset.
+    Only the last UTIL_STAT_RECORDS records are kept.
+    The records are printed by the command "stats" and, optionally, on exit.
+    When the metrics are disabled, an update costs one test of a flag.
+    New metrics should be registered before the threads are started.
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+typedef struct Util_Stat_t_ Util_Stat_t;
+struct Util_Stat_t_
+{
+    char *           pName;         // the name of the metric
+    int              Type;          // the type of the metric
+    word             Count;         // the number of updates
+    word             Sum;           // the sum of the values
+    word             Max;           // the max value
+    word             Buckets[UTIL_STAT_BUCKETS]; // the number of values in [2^(i-1), 2^i)
+};
+
+typedef struct Util_StatRec_t_ Util_StatRec_t;
+struct Util_StatRec_t_
+{
+    char *           pCommand;      // the command line
+    int              nStats;        // the number of metrics
+    Util_Stat_t *    pStats;        // the non-zero metrics of the command
+};
+
+int                  Util_StatOn = 1;
+static Util_Stat_t   s_Stats[UTIL_STAT_MAX] = {
+    { (char *)"level_updates",    UTIL_STAT_COUNTER },
+    { (char *)"reverse_updates",  UTIL_STAT_COUNTER },
+    { (char *)"reorder_nodes",    UTIL_STAT_COUNTER },
+    { (char *)"nodes_rewritten",  UTIL_STAT_COUNTER },
+    { (char *)"aig_update_time",  UTIL_STAT_TIMER   },
+    { (char *)"node_update_clk",  UTIL_STAT_HISTO   },
+    { (char *)"replace_tfo",      UTIL_STAT_HISTO   },
+    { (char *)"replace_steps",    UTIL_STAT_HISTO   },
+    { (char *)"node_cuts",        UTIL_STAT_HISTO   },
+};
+static int           s_nStats = UTIL_STAT_BUILTIN;
+static Vec_Ptr_t *   s_vRecords = NULL;
+static int           s_nDropped = 0;    // the number of the dropped records
+static char *        s_pExitFile = NULL;
+static int           s_fExitCsv = 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UTIL_STAT_ATOMIC_ADD( p, v )  __atomic_fetch_add( (p), (v), __ATOMIC_RELAXED )
+#else
+#define UTIL_STAT_ATOMIC_ADD( p, v )  (*(p) += (v))
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Registers the metric.]
+
+  Description [Returns the number of the metric with this name, which is
+  added if it does not exist. Returns -1 if there are too many metrics.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Util_StatRegister( char * pName, int Type )
+{
+    int i;
+    for ( i = 0; i < s_nStats; i++ )
+        if ( !strcmp(s_Stats[i].pName, pName) )
+        {
+            assert( s_Stats[i].Type == Type );
+            return i;
+        }
+    if ( s_nStats == UTIL_STAT_MAX )
+        return -1;
+    s_Stats[s_nStats].pName = Abc_UtilStrsav( pName );
+    s_Stats[s_nStats].Type  = Type;
+    return s_nStats++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Updates the metric.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Util_StatAtomicMax( word * pMax, word Value )
+{
+#if defined(__GNUC__) || defined(__clang__)
+    word Old = __atomic_load_n( pMax, __ATOMIC_RELAXED );
+    while ( Old < Value && !__atomic_compare_exchange_n( pMax, &Old, Value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) );
+#else
+    if ( *pMax < Value )
+        *pMax = Value;
+#endif
+}
+void Util_StatAddInt( int iStat, word Value )
+{
+    Util_Stat_t * p;
+    int Bucket;
+    if ( iStat < 0 || iStat >= s_nStats )
+        return;
+    p = s_Stats + iStat;
+    UTIL_STAT_ATOMIC_ADD( &p->Count, 1 );
+    UTIL_STAT_ATOMIC_ADD( &p->Sum, Value );
+    if ( p->Type != UTIL_STAT_HISTO )
+        return;
+    Util_StatAtomicMax( &p->Max, Value );
+    for ( Bucket = 0; Value; Value >>= 1 )
+        Bucket++;
+    UTIL_STAT_ATOMIC_ADD( &p->Buckets[Abc_MinInt(Bucket, UTIL_STAT_BUCKETS-1)], 1 );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the sum of the values of the current command.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+word Util_StatRead( int iStat )
+{
+    return (iStat >= 0 && iStat < s_nStats) ? s_Stats[iStat].Sum : 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Enables or disables collecting the metrics.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_StatSetEnabled( int fEnable )
+{
+    Util_StatOn = fEnable;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Saves the metrics of the command that is over.]
+
+  Description [If there are too many records, the oldest one is dropped.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Util_StatRecFree( Util_StatRec_t * pRec )
+{
+    ABC_FREE( pRec->pCommand );
+    ABC_FREE( pRec->pStats );
+    ABC_FREE( pRec );
+}
+void Util_StatCommandEnd( int argc, char ** argv )
+{
+    Util_StatRec_t * pRec;
+    int i, k, nChars = 0, nStats = 0;
+    for ( i = 0; i < s_nStats; i++ )
+        nStats += (s_Stats[i].Count > 0);
+    if ( nStats == 0 )
+        return;
+    pRec = ABC_CALLOC( Util_StatRec_t, 1 );
+    pRec->pStats = ABC_ALLOC( Util_Stat_t, nStats );
+    for ( i = 0; i < s_nStats; i++ )
+    {
+        if ( s_Stats[i].Count == 0 )
+            continue;
+        pRec->pStats[pRec->nStats++] = s_Stats[i];
+        memset( &s_Stats[i].Count, 0, sizeof(Util_Stat_t) - offsetof(Util_Stat_t, Count) );
+    }
+    for ( k = 0; k < argc; k++ )
+        nChars += strlen(argv[k]) + 1;
+    pRec->pCommand = ABC_CALLOC( char, nChars + 1 );
+    for ( k = 0; k < argc; k++ )
+    {
+        if ( k ) strcat( pRec->pCommand, " " );
+        strcat( pRec->pCommand, argv[k] );
+    }
+    if ( s_vRecords == NULL )
+        s_vRecords = Vec_PtrAlloc( 100 );
+    if ( Vec_PtrSize(s_vRecords) == UTIL_STAT_RECORDS )
+    {
+        Util_StatRecFree( (Util_StatRec_t *)Vec_PtrEntry(s_vRecords, 0) );
+        Vec_PtrDrop( s_vRecords, 0 );
+        s_nDropped++;
+    }
+    Vec_PtrPush( s_vRecords, pRec );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Prints the saved metrics.]
+
+  Description [Returns the number of the printed records.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Util_StatPrintString( FILE * pFile, char * pStr )
+{
+    fputc( '\"', pFile );
+    for ( ; *pStr; pStr++ )
+    {
+        if ( *pStr == '\"' || *pStr == '\\' )
+            fputc( '\\', pFile );
+        fputc( *pStr, pFile );
+    }
+    fputc( '\"', pFile );
+}
+static void Util_StatPrintOne( FILE * pFile, Util_Stat_t * p )
+{
+    int k, fFirst = 1;
+    Util_StatPrintString( pFile, p->pName );
+    if ( p->Type == UTIL_STAT_COUNTER )
+        fprintf( pFile, ": %.0f", (double)p->Sum );
+    else if ( p->Type == UTIL_STAT_TIMER )
+        fprintf( pFile, ": %.6f", 1.0*((double)(p->Sum))/((double)CLOCKS_PER_SEC) );
+    else
+    {
+        fprintf( pFile, ": { \"count\": %.0f, \"sum\": %.0f, \"max\": %.0f, \"buckets\": [",
+            (double)p->Count, (double)p->Sum, (double)p->Max );
+        for ( k = 0; k < UTIL_STAT_BUCKETS; k++ )
+        {
+            if ( p->Buckets[k] == 0 )
+                continue;
+            fprintf( pFile, "%s[%.0f, %.0f]", fFirst ? "" : ", ", k ? (double)((word)1 << (k-1)) : 0.0, (double)p->Buckets[k] );
+            fFirst = 0;
+        }
+        fprintf( pFile, "] }" );
+    }
+}
+int Util_StatPrint( FILE * pFile, int fCsv )
+{
+    static char * pTypes[3] = { (char *)"counter", (char *)"timer", (char *)"histogram" };
+    Util_StatRec_t * pRec;
+    Util_Stat_t * p;
+    int i, k;
+    if ( fCsv )
+        fprintf( pFile, "index,command,metric,type,count,sum,max\n" );
+    else
+        fprintf( pFile, "[\n" );
+    if ( s_vRecords )
+    Vec_PtrForEachEntry( Util_StatRec_t *, s_vRecords, pRec, i )
+    {
+        if ( !fCsv )
+        {
+            fprintf( pFile, "  { \"command\": " );
+            Util_StatPrintString( pFile, pRec->pCommand );
+            fprintf( pFile, ", \"metrics\": {\n" );
+        }
+        for ( k = 0; k < pRec->nStats; k++ )
+        {
+            p = pRec->pStats + k;
+            if ( fCsv )
+            {
+                fprintf( pFile, "%d,", s_nDropped + i );
+                Util_StatPrintString( pFile, pRec->pCommand );
+                fprintf( pFile, ",%s,%s,%.0f,", p->pName, pTypes[p->Type], (double)p->Count );
+                if ( p->Type == UTIL_STAT_TIMER )
+                    fprintf( pFile, "%.6f,\n", 1.0*((double)(p->Sum))/((double)CLOCKS_PER_SEC) );
+                else if ( p->Type == UTIL_STAT_HISTO )
+                    fprintf( pFile, "%.0f,%.0f\n", (double)p->Sum, (double)p->Max );
+                else
+                    fprintf( pFile, "%.0f,\n", (double)p->Sum );
+                continue;
+            }
+            fprintf( pFile, "      " );
+            Util_StatPrintOne( pFile, p );
+            fprintf( pFile, "%s\n", k < pRec->nStats - 1 ? "," : "" );
+        }
+        if ( !fCsv )
+            fprintf( pFile, "  } }%s\n", i < Vec_PtrSize(s_vRecords) - 1 ? "," : "" );
+    }
+    if ( !fCsv )
+        fprintf( pFile, "]\n" );
+    return s_vRecords ? Vec_PtrSize(s_vRecords) : 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the file to write the metrics on exit.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_StatSetExitFile( char * pFileName, int fCsv )
+{
+    ABC_FREE( s_pExitFile );
+    s_pExitFile = pFileName ? Abc_UtilStrsav( pFileName ) : NULL;
+    s_fExitCsv  = fCsv;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Forgets the saved metrics.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_StatReset()
+{
+    Util_StatRec_t * pRec;
+    int i;
+    if ( s_vRecords == NULL )
+        return;
+    Vec_PtrForEachEntry( Util_StatRec_t *, s_vRecords, pRec, i )
+        Util_StatRecFree( pRec );
+    Vec_PtrFreeP( &s_vRecords );
+    s_nDropped = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the metrics into the exit file and forgets them.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Util_StatStop()
+{
+    FILE * pFile;
+    if ( s_pExitFile )
+    {
+        if ( (pFile = fopen( s_pExitFile, "wb" )) )
+        {
+            Util_StatPrint( pFile, s_fExitCsv );
+            fclose( pFile );
+        }
+        else
+            printf( "Cannot open file \"%s\" for writing the metrics.\n", s_pExitFile );
+        ABC_FREE( s_pExitFile );
+    }
+    Util_StatReset();
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
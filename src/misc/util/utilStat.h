@@ -0,0 +1,101 @@
+/**CFile****************************************************************
+
+  FileName    [utilStat.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Metrics of the commands.]
+
+  Synopsis    [External declarations.]
+
+  Author      [ABC contributors]
+
+  Affiliation [ABC open-source project]
+
+  Date        [Ver. 1.0. Started - October 17, 2026.]
+
+  Revision    [$Id: utilStat.h,v 1.00 2026/10/17 00:00:00 abc Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilStat_h
+#define ABC__misc__util__utilStat_h
+
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "abc_global.h"
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+// the types of the metrics
+#define UTIL_STAT_COUNTER     0     // the sum of the values
+#define UTIL_STAT_TIMER       1     // the sum of the time intervals (in clocks)
+#define UTIL_STAT_HISTO       2     // the distribution of the values (power-of-two buckets)
+
+// the max number of the metrics
+#define UTIL_STAT_MAX       128
+// the number of the histogram buckets
+#define UTIL_STAT_BUCKETS    64
+// the max number of the saved records (the oldest ones are dropped)
+#define UTIL_STAT_RECORDS  1000
+
+// the predefined metrics (the others are added by Util_StatRegister)
+enum {
+    UTIL_STAT_LEVEL_UPDATES,        // counter: the nodes whose levels were recomputed
+    UTIL_STAT_REVERSE_UPDATES,      // counter: the nodes whose reverse levels were recomputed
+    UTIL_STAT_REORDER_NODES,        // counter: the nodes moved in the order list
+    UTIL_STAT_NODES_REWRITTEN,      // counter: the accepted replacements
+    UTIL_STAT_AIG_UPDATE_TIME,      // timer:   maintaining the levels and the order
+    UTIL_STAT_NODE_UPDATE,          // histo:   the clocks spent replacing one node
+    UTIL_STAT_REPLACE_TFO,          // histo:   the TFO nodes reordered after one replacement
+    UTIL_STAT_REPLACE_STEPS,        // histo:   the cascaded replacements after one replacement
+    UTIL_STAT_NODE_CUTS,            // histo:   the cuts of one node
+    UTIL_STAT_BUILTIN
+};
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+extern int Util_StatOn;
+
+// returns 1 if the metrics are collected
+static inline int     Util_StatIsOn()                 { return Util_StatOn;                          }
+// returns the current time if the metrics are collected
+static inline abctime Util_StatClock()                { return Util_StatOn ? Abc_Clock() : 0;        }
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilStat.c ===============================================================*/
+extern int             Util_StatRegister( char * pName, int Type );
+extern void            Util_StatAddInt( int iStat, word Value );
+extern word            Util_StatRead( int iStat );
+extern void            Util_StatSetEnabled( int fEnable );
+extern void            Util_StatCommandEnd( int argc, char ** argv );
+extern int             Util_StatPrint( FILE * pFile, int fCsv );
+extern void            Util_StatSetExitFile( char * pFileName, int fCsv );
+extern void            Util_StatReset();
+extern void            Util_StatStop();
+
+// adds the value to the metric (thread-safe)
+static inline void    Util_StatAdd( int iStat, word Value )        { if ( Util_StatOn ) Util_StatAddInt( iStat, Value );             }
+// adds the time passed since clk, which was returned by Util_StatClock()
+static inline void    Util_StatAddTime( int iStat, abctime clk )   { if ( Util_StatOn ) Util_StatAddInt( iStat, Abc_Clock() - clk ); }
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,233 @@
+/**CFile****************************************************************
+
+  FileName    [bQue.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Priority queue implementation.]
+
+  Synopsis    [A bucket queue keyed by small non-negative integers (levels).]
+
+  Author      [ABC contributors]
+
+  Affiliation [ABC open-source project]
+
+  Date        [Ver. 1.0. Started - October 16, 2026.]
+
+  Revision    [$Id: bQue.h,v 1.00 2026/10/16 00:00:00 abc Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__bQue_h
+#define ABC__misc__bQue_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <assert.h>
+
+ABC_NAMESPACE_HEADER_START
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+// The queue keeps one bucket per key. Pushing is O(1); popping the minimum
+// (or the maximum) scans the buckets from the last popped key, which is
+// amortized O(1) when the keys are processed monotonically, as it happens
+// when propagating levels (or reverse levels) through the AIG.
+// The queue does not remove duplicates; the callers mark the queued objects.
+
+typedef struct B_Que_t_  B_Que_t;
+struct B_Que_t_
+{
+    Vec_Vec_t *     vBuckets;      // the entries of each key
+    int             nSize;         // the number of entries in the queue
+    int             iMin;          // no entries with keys below this one
+    int             iMax;          // no entries with keys above this one
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Allocates a bucket queue for the given number of keys.]
+
+  Description [The number of buckets grows on demand.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline B_Que_t * B_QueAlloc( int nKeys )
+{
+    B_Que_t * p;
+    p = ABC_CALLOC( B_Que_t, 1 );
+    p->vBuckets = Vec_VecAlloc( Abc_MaxInt(nKeys, 16) );
+    p->iMin = ABC_INFINITY;
+    p->iMax = -1;
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Frees the bucket queue.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void B_QueFree( B_Que_t * p )
+{
+    Vec_VecFree( p->vBuckets );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the number of entries in the queue.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int B_QueSize( B_Que_t * p )
+{
+    return p->nSize;
+}
+static inline int B_QueIsEmpty( B_Que_t * p )
+{
+    return p->nSize == 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Pushes an entry with the given key.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void B_QuePush( B_Que_t * p, void * pData, int Key )
+{
+    assert( Key >= 0 );
+    Vec_VecPush( p->vBuckets, Key, pData );
+    if ( p->iMin > Key )
+        p->iMin = Key;
+    if ( p->iMax < Key )
+        p->iMax = Key;
+    p->nSize++;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Removes and returns an entry with the smallest key.]
+
+  Description [Returns NULL if the queue is empty.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void * B_QuePopMin( B_Que_t * p )
+{
+    Vec_Ptr_t * vBucket;
+    if ( p->nSize == 0 )
+        return NULL;
+    while ( Vec_PtrSize(vBucket = Vec_VecEntry(p->vBuckets, p->iMin)) == 0 )
+        p->iMin++;
+    assert( p->iMin <= p->iMax );
+    p->nSize--;
+    if ( p->nSize == 0 )
+        p->iMin = ABC_INFINITY, p->iMax = -1;
+    return Vec_PtrPop( vBucket );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Removes and returns an entry with the largest key.]
+
+  Description [Returns NULL if the queue is empty.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void * B_QuePopMax( B_Que_t * p )
+{
+    Vec_Ptr_t * vBucket;
+    if ( p->nSize == 0 )
+        return NULL;
+    while ( Vec_PtrSize(vBucket = Vec_VecEntry(p->vBuckets, p->iMax)) == 0 )
+        p->iMax--;
+    assert( p->iMin <= p->iMax );
+    p->nSize--;
+    if ( p->nSize == 0 )
+        p->iMin = ABC_INFINITY, p->iMax = -1;
+    return Vec_PtrPop( vBucket );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the smallest key in the queue or -1 if it is empty.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int B_QueMinKey( B_Que_t * p )
+{
+    if ( p->nSize == 0 )
+        return -1;
+    while ( Vec_PtrSize(Vec_VecEntry(p->vBuckets, p->iMin)) == 0 )
+        p->iMin++;
+    return p->iMin;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Clears the queue while keeping the allocated memory.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void B_QueClear( B_Que_t * p )
+{
+    int i;
+    for ( i = Abc_MaxInt(p->iMin, 0); i <= p->iMax; i++ )
+        Vec_PtrClear( Vec_VecEntry(p->vBuckets, i) );
+    p->nSize = 0;
+    p->iMin = ABC_INFINITY;
+    p->iMax = -1;
+}
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,13 @@ ABC_NAMESPACE_HEADER_START
 ///                         PARAMETERS                               ///
 ////////////////////////////////////////////////////////////////////////
 
+// order-maintenance tags live in the open range (0, LIST_PTR_TAG_MAX)
+#define LIST_PTR_TAG_MAX    ((word)1 << 62)
+// the tag distance used when appending to either end of the list
+#define LIST_PTR_TAG_STEP   ((word)1 << 32)
+// the default number of nodes in one page of the node arena
+#define LIST_PTR_PAGE_SIZE  4096
+
 ////////////////////////////////////////////////////////////////////////
 ///                         BASIC TYPES                              ///
 ////////////////////////////////////////////////////////////////////////
@@ -49,6 +56,7 @@ struct List_Ptr_Node_t_
     void *              pData;        // pointer to the data
     List_Ptr_Node_t *   pNext;        // pointer to the next node
     List_Ptr_Node_t *   pPrev;        // pointer to the previous node
+    word                Tag;          // order label (increases from head to tail)
 };
 
 // Main list structure
@@ -58,6 +66,13 @@ struct List_Ptr_t_
     List_Ptr_Node_t *   pTail;        // pointer to the last node
     int                 nSize;        // number of nodes in the list
     List_Ptr_Node_t *   pCurItera;
+    // node arena
+    List_Ptr_Node_t *   pFree;        // recycled nodes linked through pNext
+    List_Ptr_Node_t **  pPages;       // pages of nodes
+    int                 nPages;       // number of pages
+    int                 nPagesAlloc;  // number of allocated page pointers
+    int                 nPageNext;    // next unused node in the last page
+    int                 nPageSize;    // number of nodes in the last page
 };
 
 // Iterator structure for traversing the list
@@ -98,36 +113,199 @@ static inline List_Ptr_t * List_PtrAlloc()
     p = ABC_ALLOC( List_Ptr_t, 1 );
     if ( p == NULL )
         return NULL;
-    p->pHead = NULL;
-    p->pTail = NULL;
-    p->nSize = 0;
-    p->pCurItera = NULL; 
+    memset( p, 0, sizeof(List_Ptr_t) );
     return p;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Starts a new page of the node arena.]
+
+  Description [Makes sure that the next nNodes nodes allocated without
+  recycling come from one contiguous page. Calling it before pushing 
+  the entries in order makes the first traversal stream through memory.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void List_PtrReserve( List_Ptr_t * p, int nNodes )
+{
+    if ( p == NULL || p->nPageSize - p->nPageNext >= nNodes )
+        return;
+    if ( p->nPages == p->nPagesAlloc )
+    {
+        p->nPagesAlloc = p->nPagesAlloc ? 2 * p->nPagesAlloc : 16;
+        p->pPages = ABC_REALLOC( List_Ptr_Node_t *, p->pPages, p->nPagesAlloc );
+    }
+    p->pPages[p->nPages++] = ABC_ALLOC( List_Ptr_Node_t, nNodes );
+    p->nPageSize = nNodes;
+    p->nPageNext = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Releases all nodes of the list in one shot.]
+
+  Description [Frees the pages of the node arena without visiting the nodes.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void List_PtrFreeNodes( List_Ptr_t * p )
+{
+    int i;
+    for ( i = 0; i < p->nPages; i++ )
+        ABC_FREE( p->pPages[i] );
+    p->nPages    = 0;
+    p->nPageNext = 0;
+    p->nPageSize = 0;
+    p->pFree     = NULL;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Creates a new node with given data.]
 
-  Description [Internal function to create a new node.]
+  Description [Internal function to create a new node. The node is taken
+  from the free list or from the node arena of the list.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline List_Ptr_Node_t * List_PtrNodeAlloc( void * pData )
+static inline List_Ptr_Node_t * List_PtrNodeAlloc( List_Ptr_t * p, void * pData )
 {
     List_Ptr_Node_t * pNode;
-    pNode = ABC_ALLOC( List_Ptr_Node_t, 1 );
-    if ( pNode == NULL )
-        return NULL;
+    if ( p->pFree != NULL )
+    {
+        pNode = p->pFree;
+        p->pFree = pNode->pNext;
+    }
+    else
+    {
+        if ( p->nPageNext == p->nPageSize )
+            List_PtrReserve( p, LIST_PTR_PAGE_SIZE );
+        pNode = p->pPages[p->nPages-1] + p->nPageNext++;
+    }
     pNode->pData = pData;
     pNode->pNext = NULL;
     pNode->pPrev = NULL;
+    pNode->Tag   = 0;
     return pNode;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Relabels all nodes of the list with evenly spaced tags.]
+
+  Description [Fallback of the order-maintenance scheme, used when the
+  tag space near the tail is exhausted or after the list is reversed.]
+               
+  SideEffects []
+
+  SeeAlso     [List_PtrRelabel]
+
+***********************************************************************/
+static inline void List_PtrRelabelAll( List_Ptr_t * p )
+{
+    List_Ptr_Node_t * pNode;
+    word Step, Tag = 0;
+    int nNodes = 0;
+    for ( pNode = p->pHead; pNode; pNode = pNode->pNext )
+        nNodes++;
+    Step = LIST_PTR_TAG_MAX / (word)(nNodes + 1);
+    for ( pNode = p->pHead; pNode; pNode = pNode->pNext )
+        pNode->Tag = (Tag += Step);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Relabels the nodes following pBase to open a tag gap.]
+
+  Description [Implements the relabeling step of the Dietz-Sleator order
+  maintenance scheme (in the simplified form of Bender et al.): the window
+  starting after pBase grows until the j-th successor is more than j^2
+  tags away, then the j-1 nodes inside the window are spread evenly.
+  If pBase is NULL, the window starts at the head of the list.
+  The amortized cost of an insertion is O(log n) relabeled nodes.]
+               
+  SideEffects []
+
+  SeeAlso     [List_PtrRelabelAll]
+
+***********************************************************************/
+static inline void List_PtrRelabel( List_Ptr_t * p, List_Ptr_Node_t * pBase )
+{
+    List_Ptr_Node_t * pEnd, * pNode;
+    word Base = pBase ? pBase->Tag : 0;
+    word Gap, Step, j = 1;
+    pEnd = pBase ? pBase->pNext : p->pHead;
+    while ( pEnd != NULL && pEnd->Tag - Base <= j * j )
+        pEnd = pEnd->pNext, j++;
+    Gap = (pEnd ? pEnd->Tag : LIST_PTR_TAG_MAX) - Base;
+    if ( Gap <= j * j ) // the window has reached the end of the tag space
+    {
+        List_PtrRelabelAll( p );
+        return;
+    }
+    Step = Gap / j;
+    for ( pNode = pBase ? pBase->pNext : p->pHead; pNode != pEnd; pNode = pNode->pNext )
+        pNode->Tag = (Base += Step);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Assigns the order tag to a node just linked into the list.]
+
+  Description [The node should already be connected to its neighbors.
+  Appending to either end keeps a fixed distance from the last tag, so
+  that building the list in order never triggers relabeling.]
+               
+  SideEffects [May relabel a few of the following nodes.]
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void List_PtrNodeSetTag( List_Ptr_t * p, List_Ptr_Node_t * pNode )
+{
+    word Lo = pNode->pPrev ? pNode->pPrev->Tag : 0;
+    word Hi = pNode->pNext ? pNode->pNext->Tag : LIST_PTR_TAG_MAX;
+    if ( Hi - Lo < 2 )
+    {
+        // include the node itself into the window to be relabeled
+        pNode->Tag = Lo;
+        List_PtrRelabel( p, pNode->pPrev );
+        return;
+    }
+    if ( pNode->pNext == NULL && Hi - Lo > 2 * LIST_PTR_TAG_STEP )
+        pNode->Tag = Lo + LIST_PTR_TAG_STEP;
+    else if ( pNode->pPrev == NULL && Hi - Lo > 2 * LIST_PTR_TAG_STEP )
+        pNode->Tag = Hi - LIST_PTR_TAG_STEP;
+    else
+        pNode->Tag = Lo + (Hi - Lo) / 2;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if node pA comes before node pB in the list.]
+
+  Description [Both nodes should belong to the same list. Takes O(1) time.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int List_PtrNodePrecedes( List_Ptr_Node_t * pA, List_Ptr_Node_t * pB )
+{
+    return pA->Tag < pB->Tag;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Returns the first node in the list.]
@@ -168,16 +346,20 @@ static inline List_Ptr_Node_t * List_PtrLastNode( List_Ptr_t * p )
 
   Synopsis    [Frees a list node.]
 
-  Description [Internal function to free a node.]
+  Description [Internal function to free a node. The node is recycled 
+  through the free list of the list it was allocated in.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void List_PtrNodeFree( List_Ptr_Node_t * pNode )
+static inline void List_PtrNodeFree( List_Ptr_t * p, List_Ptr_Node_t * pNode )
 {   
-    ABC_FREE( pNode );
+    pNode->pData = NULL;
+    pNode->pPrev = NULL;
+    pNode->pNext = p->pFree;
+    p->pFree = pNode;
 }
 
 /**Function*************************************************************
@@ -193,21 +375,14 @@ static inline void List_PtrNodeFree( List_Ptr_Node_t * pNode )
 ***********************************************************************/
 static inline void List_PtrFree( List_Ptr_t * p )
 {
-    List_Ptr_Node_t * pNode, * pNext;
-
     if ( p == NULL )
         return;
 
     // free all nodes
-    pNode = p->pHead;
-    while ( pNode != NULL )
-    {
-        pNext = pNode->pNext;
-        List_PtrNodeFree( pNode );
-        pNode = pNext;
-    }
+    List_PtrFreeNodes( p );
 
     // free the list structure
+    ABC_FREE( p->pPages );
     ABC_FREE( p );
 }
 
@@ -229,19 +404,18 @@ static inline void List_PtrFreeData( List_Ptr_t * p )
     if ( p == NULL )
         return;
 
-    // free all nodes and their data
+    // free the data of all nodes
     pNode = p->pHead;
     while ( pNode != NULL )
     {
         pNext = pNode->pNext;
         if ( pNode->pData )
             ABC_FREE( pNode->pData );
-        List_PtrNodeFree( pNode );
         pNode = pNext;
     }
 
     // free the list structure
-    ABC_FREE( p );
+    List_PtrFree( p );
 }
 
 /**Function*************************************************************
@@ -262,19 +436,18 @@ static inline void List_PtrFreeFunc( List_Ptr_t * p, void (*pFuncFree)(void *) )
     if ( p == NULL || pFuncFree == NULL )
         return;
 
-    // free all nodes and their data
+    // free the data of all nodes
     pNode = p->pHead;
     while ( pNode != NULL )
     {
         pNext = pNode->pNext;
         if ( pNode->pData )
             pFuncFree( pNode->pData );
-        List_PtrNodeFree( pNode );
         pNode = pNext;
     }
 
     // free the list structure
-    ABC_FREE( p );
+    List_PtrFree( p );
 }
 
 /**Function*************************************************************
@@ -362,23 +535,16 @@ static inline void * List_PtrLast( List_Ptr_t * p )
 ***********************************************************************/
 static inline void List_PtrClear( List_Ptr_t * p )
 {
-    List_Ptr_Node_t * pNode, * pNext;
-
     if ( p == NULL )
         return;
 
     // free all nodes
-    pNode = p->pHead;
-    while ( pNode != NULL )
-    {
-        pNext = pNode->pNext;
-        List_PtrNodeFree( pNode );
-        pNode = pNext;
-    }
+    List_PtrFreeNodes( p );
 
     // reset list
     p->pHead = NULL;
     p->pTail = NULL;
+    p->pCurItera = NULL;
     p->nSize = 0;
 }
 
@@ -400,20 +566,21 @@ static inline void List_PtrClearData( List_Ptr_t * p )
     if ( p == NULL )
         return;
 
-    // free all nodes and their data
+    // free the data of all nodes
     pNode = p->pHead;
     while ( pNode != NULL )
     {
         pNext = pNode->pNext;
         if ( pNode->pData )
             ABC_FREE( pNode->pData );
-        List_PtrNodeFree( pNode );
         pNode = pNext;
     }
+    List_PtrFreeNodes( p );
 
     // reset list
     p->pHead = NULL;
     p->pTail = NULL;
+    p->pCurItera = NULL;
     p->nSize = 0;
 }
 
@@ -435,7 +602,7 @@ static inline List_Ptr_Node_t * List_PtrPushFront( List_Ptr_t * p, void * pData
     if ( p == NULL )
         return NULL;
 
-    pNode = List_PtrNodeAlloc( pData );
+    pNode = List_PtrNodeAlloc( p, pData );
     if ( pNode == NULL )
         return NULL;
 
@@ -451,6 +618,7 @@ static inline List_Ptr_Node_t * List_PtrPushFront( List_Ptr_t * p, void * pData
         p->pHead->pPrev = pNode;
         p->pHead = pNode;
     }
+    List_PtrNodeSetTag( p, pNode );
 
     p->nSize++;
     return pNode;
@@ -474,7 +642,7 @@ static inline List_Ptr_Node_t * List_PtrPushBack( List_Ptr_t * p, void * pData )
     if ( p == NULL )
         return NULL;
 
-    pNode = List_PtrNodeAlloc( pData );
+    pNode = List_PtrNodeAlloc( p, pData );
     if ( pNode == NULL )
         return NULL;
 
@@ -490,6 +658,7 @@ static inline List_Ptr_Node_t * List_PtrPushBack( List_Ptr_t * p, void * pData )
         p->pTail->pNext = pNode;
         p->pTail = pNode;
     }
+    List_PtrNodeSetTag( p, pNode );
 
     p->nSize++;
     return pNode;
@@ -526,7 +695,7 @@ static inline void * List_PtrPopFront( List_Ptr_t * p )
     else
         p->pHead->pPrev = NULL;
 
-    List_PtrNodeFree( pNode );
+    List_PtrNodeFree( p, pNode );
     p->nSize--;
     
     return pData;
@@ -563,7 +732,7 @@ static inline void * List_PtrPopBack( List_Ptr_t * p )
     else
         p->pTail->pNext = NULL;
 
-    List_PtrNodeFree( pNode );
+    List_PtrNodeFree( p, pNode );
     p->nSize--;
     
     return pData;
@@ -587,7 +756,7 @@ static inline List_Ptr_Node_t * List_PtrInsertAfter( List_Ptr_t * p, List_Ptr_No
     if ( p == NULL || pNode == NULL )
         return NULL;
 
-    pNewNode = List_PtrNodeAlloc( pData );
+    pNewNode = List_PtrNodeAlloc( p, pData );
     if ( pNewNode == NULL )
         return NULL;
 
@@ -600,6 +769,7 @@ static inline List_Ptr_Node_t * List_PtrInsertAfter( List_Ptr_t * p, List_Ptr_No
         p->pTail = pNewNode;  // Update tail if inserting at the end
     
     pNode->pNext = pNewNode;
+    List_PtrNodeSetTag( p, pNewNode );
     p->nSize++;
     
     return pNewNode;
@@ -623,7 +793,7 @@ static inline List_Ptr_Node_t * List_PtrInsertBefore( List_Ptr_t * p, List_Ptr_N
     if ( p == NULL || pNode == NULL )
         return NULL;
 
-    pNewNode = List_PtrNodeAlloc( pData );
+    pNewNode = List_PtrNodeAlloc( p, pData );
     if ( pNewNode == NULL )
         return NULL;
 
@@ -636,11 +806,53 @@ static inline List_Ptr_Node_t * List_PtrInsertBefore( List_Ptr_t * p, List_Ptr_N
         p->pHead = pNewNode;  // Update head if inserting at the beginning
     
     pNode->pPrev = pNewNode;
+    List_PtrNodeSetTag( p, pNewNode );
     p->nSize++;
     
     return pNewNode;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Moves an existing node right after the specified node.]
+
+  Description [Relinks pNode without reallocating it, so that external
+  references to pNode remain valid. Returns pNode.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline List_Ptr_Node_t * List_PtrMoveAfter( List_Ptr_t * p, List_Ptr_Node_t * pPos, List_Ptr_Node_t * pNode )
+{
+    if ( p == NULL || pPos == NULL || pNode == NULL )
+        return NULL;
+    if ( pNode == pPos || pPos->pNext == pNode )
+        return pNode;
+
+    // unlink the node
+    if ( pNode->pPrev != NULL )
+        pNode->pPrev->pNext = pNode->pNext;
+    else
+        p->pHead = pNode->pNext;
+    if ( pNode->pNext != NULL )
+        pNode->pNext->pPrev = pNode->pPrev;
+    else
+        p->pTail = pNode->pPrev;
+
+    // link it after the given position
+    pNode->pNext = pPos->pNext;
+    pNode->pPrev = pPos;
+    if ( pPos->pNext != NULL )
+        pPos->pNext->pPrev = pNode;
+    else
+        p->pTail = pNode;
+    pPos->pNext = pNode;
+    List_PtrNodeSetTag( p, pNode );
+    return pNode;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Inserts a new element at the specified position.]
@@ -720,7 +932,7 @@ static inline void * List_PtrRemoveNode( List_Ptr_t * p, List_Ptr_Node_t * pNode
         p->pTail = pNode->pPrev;  // Update tail if removing last node
     
 
-    List_PtrNodeFree( pNode );
+    List_PtrNodeFree( p, pNode );
     p->nSize--;
     
     return pData;
@@ -1001,13 +1213,14 @@ static inline List_Ptr_Node_t * List_PtrDupNodeEmpty( List_Ptr_t * p, List_Ptr_N
         return NULL;
     
     // Allocate and initialize the new node with the same data
-    pNewNode = List_PtrNodeAlloc( NULL );
+    pNewNode = List_PtrNodeAlloc( p, NULL );
     if ( pNewNode == NULL )
         return NULL;
     
     // Connect the new node to the same adjacent nodes
     pNewNode->pNext = pNode->pNext;
     pNewNode->pPrev = pNode->pPrev;
+    pNewNode->Tag   = pNode->Tag;
     
     // Update adjacent nodes to point to the new node
     if ( pNewNode->pPrev != NULL )
@@ -1023,6 +1236,38 @@ static inline List_Ptr_Node_t * List_PtrDupNodeEmpty( List_Ptr_t * p, List_Ptr_N
     return pNewNode;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Removes the nodes with null data.]
+
+  Description [The node of the current iterator is kept even if its data
+               is null, so that the traversal can continue from it.
+               Returns the number of removed nodes.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int List_PtrCompact( List_Ptr_t * p )
+{
+    List_Ptr_Node_t * pNode, * pNext;
+    int Counter = 0;
+
+    if ( p == NULL )
+        return 0;
+
+    for ( pNode = p->pHead; pNode != NULL; pNode = pNext )
+    {
+        pNext = pNode->pNext;
+        if ( pNode->pData != NULL || pNode == p->pCurItera )
+            continue;
+        List_PtrRemoveNode( p, pNode );
+        Counter++;
+    }
+    return Counter;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Creates a duplicate of the list.]
@@ -1097,6 +1342,9 @@ static inline void List_PtrReverse( List_Ptr_t * p )
     pTemp = p->pHead;
     p->pHead = p->pTail;
     p->pTail = pTemp;
+
+    // the tags are now decreasing
+    List_PtrRelabelAll( p );
 }
 
 /**Function*************************************************************
@@ -1325,7 +1573,7 @@ static inline double List_PtrMemory( List_Ptr_t * p )
     if ( p == NULL )
         return 0.0;
     
-    return sizeof(List_Ptr_t) + sizeof(List_Ptr_Node_t) * (size_t)p->nSize;
+    return sizeof(List_Ptr_t) + sizeof(List_Ptr_Node_t) * (size_t)p->nSize + sizeof(List_Ptr_Node_t *) * (size_t)p->nPagesAlloc;
 }
 
 /**Function*************************************************************
@@ -1342,6 +1590,7 @@ static inline double List_PtrMemory( List_Ptr_t * p )
 static inline void List_PtrSwap( List_Ptr_t * p1, List_Ptr_t * p2 )
 {
     List_Ptr_Node_t * pHeadTemp, * pTailTemp;
+    List_Ptr_t Temp;
     int nSizeTemp;
     
     if ( p1 == NULL || p2 == NULL || p1 == p2 )
@@ -1361,6 +1610,21 @@ static inline void List_PtrSwap( List_Ptr_t * p1, List_Ptr_t * p2 )
     nSizeTemp = p1->nSize;
     p1->nSize = p2->nSize;
     p2->nSize = nSizeTemp;
+
+    // Swap node arenas (the nodes belong to the arena of their list)
+    Temp = *p1;
+    p1->pFree       = p2->pFree;
+    p1->pPages      = p2->pPages;
+    p1->nPages      = p2->nPages;
+    p1->nPagesAlloc = p2->nPagesAlloc;
+    p1->nPageNext   = p2->nPageNext;
+    p1->nPageSize   = p2->nPageSize;
+    p2->pFree       = Temp.pFree;
+    p2->pPages      = Temp.pPages;
+    p2->nPages      = Temp.nPages;
+    p2->nPagesAlloc = Temp.nPagesAlloc;
+    p2->nPageNext   = Temp.nPageNext;
+    p2->nPageSize   = Temp.nPageSize;
 }
 
 /**Function*************************************************************
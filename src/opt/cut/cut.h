@@ -116,6 +116,9 @@ extern void             Cut_NodeWriteCutsTemp( Cut_Man_t * p, int Node, Cut_Cut_
 extern void             Cut_NodeSetTriv( Cut_Man_t * p, int Node );
 extern void             Cut_NodeTryDroppingCuts( Cut_Man_t * p, int Node );
 extern void             Cut_NodeFreeCuts( Cut_Man_t * p, int Node );
+extern unsigned         Cut_NodeCollectLeaves( Cut_Man_t * p, int Node, Vec_Int_t * vLeaves );
+extern int              Cut_NodeCutsHaveLeaf( Cut_Man_t * p, int Node, Vec_Int_t * vLeaves, unsigned uSign );
+extern void             Cut_ManRemapIds( Cut_Man_t * p, Vec_Int_t * vMap );
 /*=== cutCut.c ==========================================================*/
 extern void             Cut_CutPrint( Cut_Cut_t * pCut, int fSeq );
 extern void             Cut_CutPrintList( Cut_Cut_t * pList, int fSeq );
@@ -129,6 +132,7 @@ extern void             Cut_ManSetFanoutCounts( Cut_Man_t * p, Vec_Int_t * vFanC
 extern void             Cut_ManSetNodeAttrs( Cut_Man_t * p, Vec_Int_t * vFanCounts );
 extern int              Cut_ManReadVarsMax( Cut_Man_t * p );
 extern Cut_Params_t *   Cut_ManReadParams( Cut_Man_t * p );
+extern int              Cut_ManReadMemUsage( Cut_Man_t * p );
 extern Vec_Int_t *      Cut_ManReadNodeAttrs( Cut_Man_t * p );
 extern void             Cut_ManIncrementDagNodes( Cut_Man_t * p );
 /*=== cutNode.c ==========================================================*/
@@ -192,6 +192,150 @@ void Cut_NodeFreeCuts( Cut_Man_t * p, int Node )
     Cut_NodeWriteCutsNew( p, Node, NULL );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects the node and the leaves of its cuts.]
+
+  Description [The IDs are stored in vLeaves in the increasing order,
+  without duplicates. Returns the union of their signatures.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+unsigned Cut_NodeCollectLeaves( Cut_Man_t * p, int Node, Vec_Int_t * vLeaves )
+{
+    Cut_Cut_t * pCut;
+    unsigned uSign = Cut_NodeSign( Node );
+    int i;
+    Vec_IntFill( vLeaves, 1, Node );
+    Cut_ListForEachCut( Cut_NodeReadCutsNew(p, Node), pCut )
+    {
+        for ( i = 0; i < (int)pCut->nLeaves; i++ )
+            Vec_IntPushUniqueOrder( vLeaves, pCut->pLeaves[i] );
+        uSign |= pCut->uSign;
+    }
+    return uSign;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if a cut at the node has a leaf in the set.]
+
+  Description [The set of leaves and its signature are computed by
+  Cut_NodeCollectLeaves().]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cut_NodeCutsHaveLeaf( Cut_Man_t * p, int Node, Vec_Int_t * vLeaves, unsigned uSign )
+{
+    Cut_Cut_t * pCut;
+    int i, iBeg, iEnd, iMid;
+    Cut_ListForEachCut( Cut_NodeReadCutsNew(p, Node), pCut )
+    {
+        if ( (pCut->uSign & uSign) == 0 )
+            continue;
+        for ( i = 0; i < (int)pCut->nLeaves; i++ )
+        {
+            // find the leaf in the sorted set
+            for ( iBeg = 0, iEnd = Vec_IntSize(vLeaves); iBeg < iEnd; )
+            {
+                iMid = (iBeg + iEnd) / 2;
+                if ( Vec_IntEntry(vLeaves, iMid) < pCut->pLeaves[i] )
+                    iBeg = iMid + 1;
+                else
+                    iEnd = iMid;
+            }
+            if ( iBeg < Vec_IntSize(vLeaves) && Vec_IntEntry(vLeaves, iBeg) == pCut->pLeaves[i] )
+                return 1;
+        }
+    }
+    return 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Renumbers the nodes whose cuts are stored in the manager.]
+
+  Description [vMap maps the old node numbers into the new ones (-1 if 
+  the node was removed). The leaves of each cut are sorted again, and 
+  the truth table is permuted accordingly. The cuts with removed leaves
+  are dropped. Only the combinational cuts are remapped.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Cut_ManRemapIds( Cut_Man_t * p, Vec_Int_t * vMap )
+{
+    Vec_Ptr_t * vCutsNew;
+    Cut_Cut_t * pList, * pCut, * pCut2, ** ppTail;
+    int Node, NodeNew, Temp, i, fChange;
+    assert( !p->pParams->fSeq );
+    vCutsNew = Vec_PtrAlloc( Vec_IntSize(vMap) );
+    Vec_PtrForEachEntry( Cut_Cut_t *, p->vCutsNew, pList, Node )
+    {
+        if ( pList == NULL )
+            continue;
+        NodeNew = Node < Vec_IntSize(vMap) ? Vec_IntEntry(vMap, Node) : -1;
+        if ( NodeNew < 0 )
+        {
+            Cut_ListForEachCutSafe( pList, pCut, pCut2 )
+                Cut_CutRecycle( p, pCut );
+            continue;
+        }
+        ppTail = &pList;
+        Cut_ListForEachCutSafe( pList, pCut, pCut2 )
+        {
+            // map the leaves
+            for ( i = 0; i < (int)pCut->nLeaves; i++ )
+            {
+                pCut->pLeaves[i] = pCut->pLeaves[i] < Vec_IntSize(vMap) ? Vec_IntEntry(vMap, pCut->pLeaves[i]) : -1;
+                if ( pCut->pLeaves[i] < 0 )
+                    break;
+            }
+            if ( i < (int)pCut->nLeaves )
+            {
+                Cut_CutRecycle( p, pCut );
+                continue;
+            }
+            // sort the leaves while permuting the truth table
+            do {
+                fChange = 0;
+                for ( i = 0; i < (int)pCut->nLeaves - 1; i++ )
+                {
+                    if ( pCut->pLeaves[i] < pCut->pLeaves[i+1] )
+                        continue;
+                    Temp = pCut->pLeaves[i];
+                    pCut->pLeaves[i] = pCut->pLeaves[i+1];
+                    pCut->pLeaves[i+1] = Temp;
+                    if ( p->pParams->fTruth )
+                    {
+                        Extra_TruthSwapAdjacentVars( p->puTemp[0], Cut_CutReadTruth(pCut), pCut->nVarsMax, i );
+                        Cut_CutWriteTruth( pCut, p->puTemp[0] );
+                    }
+                    fChange = 1;
+                }
+            } while ( fChange );
+            pCut->uSign = 0;
+            for ( i = 0; i < (int)pCut->nLeaves; i++ )
+                pCut->uSign |= Cut_NodeSign( pCut->pLeaves[i] );
+            *ppTail = pCut;
+            ppTail = &pCut->pNext;
+        }
+        *ppTail = NULL;
+        Vec_PtrFillExtra( vCutsNew, NodeNew + 1, NULL );
+        Vec_PtrWriteEntry( vCutsNew, NodeNew, pList );
+    }
+    Vec_PtrFree( p->vCutsNew );
+    p->vCutsNew = vCutsNew;
+}
+
 
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
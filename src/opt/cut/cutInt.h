@@ -48,7 +48,8 @@ typedef struct Cut_HashTableStruct_t_ Cut_HashTable_t;
 struct Cut_ManStruct_t_
 { 
     // user preferences
-    Cut_Params_t *     pParams;          // computation parameters
+    Cut_Params_t *     pParams;          // computation parameters (points to Params)
+    Cut_Params_t       Params;           // the copy of the parameters given by the user
     Vec_Int_t *        vFanCounts;       // the array of fanout counters
     Vec_Int_t *        vNodeAttrs;       // node attributes (1 = global; 0 = local)
     // storage for cuts
@@ -52,8 +52,10 @@ Cut_Man_t * Cut_ManStart( Cut_Params_t * pParams )
     assert( pParams->nVarsMax >= 3 && pParams->nVarsMax <= CUT_SIZE_MAX );
     p = ABC_ALLOC( Cut_Man_t, 1 );
     memset( p, 0, sizeof(Cut_Man_t) );
-    // set and correct parameters
-    p->pParams = pParams;
+    // set and correct parameters (the manager keeps its own copy, so that 
+    // it does not depend on the lifetime of the structure given by the user)
+    p->Params  = *pParams;
+    p->pParams = pParams = &p->Params;
     // prepare storage for cuts
     p->vCutsNew = Vec_PtrAlloc( pParams->nIdsMax );
     Vec_PtrFill( p->vCutsNew, pParams->nIdsMax, NULL );
@@ -279,6 +281,22 @@ Cut_Params_t * Cut_ManReadParams( Cut_Man_t * p )
     return p->pParams;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns the memory allocated for the cuts.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Cut_ManReadMemUsage( Cut_Man_t * p )
+{
+    return Extra_MmFixedReadMemUsage( p->pMmCuts );
+}
+
 /**Function*************************************************************
 
   Synopsis    []
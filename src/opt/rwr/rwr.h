@@ -43,9 +43,11 @@ ABC_NAMESPACE_HEADER_START
 ////////////////////////////////////////////////////////////////////////
  
 #define RWR_LIMIT  1048576/4  // ((1 << 20) 
+#define RWR_MFFC_LIMIT  32       // the max size of the MFFC collected for the node (larger ones are labeled per cut)
 
 typedef struct Rwr_Man_t_   Rwr_Man_t;
 typedef struct Rwr_Node_t_  Rwr_Node_t;
+typedef struct Rwr_Prog_t_  Rwr_Prog_t;
 
 struct Rwr_Man_t_
 {
@@ -62,6 +64,7 @@ struct Rwr_Man_t_
     Vec_Ptr_t *        vForest;          // all the nodes
     Rwr_Node_t **      pTable;           // the hash table of nodes by their canonical form
     Vec_Vec_t *        vClasses;         // the nodes of the equivalence classes
+    Rwr_Prog_t *       pProgs;           // the subgraphs of the classes compiled into gates
     Extra_MmFixed_t *  pMmNode;          // memory for nodes and cuts
     // statistical variables
     int                nTravIds;         // the counter of traversal IDs
@@ -75,6 +78,16 @@ struct Rwr_Man_t_
     Vec_Ptr_t *        vFaninsCur;       // the fanins array (temporary)
     Vec_Int_t *        vLevNums;         // the array of levels (temporary)
     Vec_Ptr_t *        vNodesTemp;       // the nodes in MFFC (temporary)
+    Vec_Ptr_t *        vCone;            // the nodes in the cone (temporary)
+    Vec_Int_t *        vRefs;            // the references of the cone nodes (temporary)
+    Vec_Ptr_t *        vMffc;            // the MFFC of the node (temporary)
+    // evaluation of the compiled classes
+    int                nGatesMax;        // the max number of gates in a class
+    int                nGateStamp;       // the stamp of the current cut
+    int *              pGateStamps;      // the stamps of the evaluated gates
+    Abc_Obj_t **       pGateFuncs;       // the AIG nodes of the leaves and gates (NULL if absent)
+    int *              pGateLevels;      // the levels of the leaves and gates
+    char *             pGateInfo;        // the evaluation flags of the gates (RWR_GATE_*)
     // node statistics
     int                nNodesConsidered;
     int                nNodesRewritten;
@@ -95,6 +108,38 @@ struct Rwr_Man_t_
     abctime            timeTotal;
 };
 
+// the result of speculative rewriting of one node
+typedef struct Rwr_Spec_t_  Rwr_Spec_t;
+struct Rwr_Spec_t_
+{
+    Abc_Obj_t *        pNode;            // the node
+    int                Id;               // the node ID
+    void *             pCuts;            // the cuts of the node (computed in advance)
+    int                Required;         // the required level of the node
+    int                Gain;             // the best gain (-1 if there is no replacement)
+    int                fCompl;           // the complemented attribute of the best graph
+    void *             pGraph;           // the best graph (belongs to the evaluating manager)
+    Abc_Obj_t *        pFanins[4];       // the leaves of the best graph
+    int                FaninIds[4];      // the IDs of the leaves
+    Vec_Int_t *        vWindow;          // the leaves of the cuts that were evaluated
+    unsigned           uWindow;          // the signature of the window
+};
+
+// the subgraphs of one NPN class compiled into one array of AND gates;
+// the subgraphs share the structurally identical gates, so each gate is 
+// looked up in the network only once per cut
+struct Rwr_Prog_t_
+{
+    int                nGates;           // the number of distinct gates
+    int *              pFanins;          // two fanin literals per gate (vars 0-3 are the leaves, var 4+k is gate k)
+    int *              pStarts;          // the beginning of each subgraph in pGraphs
+    int *              pGraphs;          // for each subgraph, the number of its gates followed by the gates in topological order
+};
+
+// the flags computed for a gate of a compiled class
+#define RWR_GATE_ADDED   1               // the gate is not in the network or it is in the MFFC
+#define RWR_GATE_FAILED  2               // the gate is the root or it exceeds the required level
+
 struct Rwr_Node_t_ // 24 bytes
 {
     int                Id;               // ID 
@@ -128,8 +173,13 @@ static inline Rwr_Node_t * Rwr_NotCond( Rwr_Node_t * p, int c )  { return (Rwr_N
 
 /*=== rwrDec.c ========================================================*/
 extern void              Rwr_ManPreprocess( Rwr_Man_t * p );
+extern void              Rwr_ManCompile( Rwr_Man_t * p );
+extern void              Rwr_ManCompileFree( Rwr_Man_t * p );
 /*=== rwrEva.c ========================================================*/
 extern int               Rwr_NodeRewrite( Rwr_Man_t * p, Cut_Man_t * pManCut, Abc_Obj_t * pNode, int fUpdateLevel, int fUseZeros, int fPlaceEnable );
+extern int               Rwr_NodeRewriteSpec( Rwr_Man_t * p, Rwr_Spec_t * pSpec );
+extern int               Rwr_NodeRewriteCheck( Rwr_Man_t * p, Rwr_Spec_t * pSpec, int fUpdateLevel );
+extern unsigned          Rwr_NodeWindowHash( Abc_Obj_t * pRoot, Vec_Int_t * vWindow, Vec_Ptr_t * vVisited, int fLevels );
 extern void              Rwr_ScoresClean( Rwr_Man_t * p );
 extern void              Rwr_ScoresReport( Rwr_Man_t * p );
 /*=== rwrLib.c ========================================================*/
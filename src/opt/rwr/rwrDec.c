@@ -20,6 +20,7 @@
 
 #include "rwr.h"
 #include "bool/dec/dec.h"
+#include "misc/vec/vecHsh.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -75,6 +76,8 @@ void Rwr_ManPreprocess( Rwr_Man_t * p )
         pNode->pNext = (Rwr_Node_t *)pGraph;
         assert( pNode->uTruth == (Dec_GraphDeriveTruth(pGraph) & 0xFFFF) );
     }
+    // compile the subgraphs of each class
+    Rwr_ManCompile( p );
 }
 
 /**Function*************************************************************
@@ -146,6 +149,112 @@ Dec_Edge_t Rwr_TravCollect_rec( Rwr_Man_t * p, Rwr_Node_t * pNode, Dec_Graph_t *
     return eNode;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Compiles the subgraphs of each class into one array of gates.]
+
+  Description [The AND nodes of the subgraphs of a class are structurally 
+  hashed, so that the nodes shared by several subgraphs become one gate. 
+  Each subgraph is then represented by the list of its gates in the 
+  topological order. The subgraphs keep the order of the class.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Rwr_ManCompile( Rwr_Man_t * p )
+{
+    Vec_Ptr_t * vSubgraphs;
+    Vec_Int_t * vPairs, * vGraphs, * vGates;
+    Hsh_IntMan_t * pHash;
+    Rwr_Prog_t * pProg;
+    Rwr_Node_t * pNode;
+    Dec_Graph_t * pGraph;
+    Dec_Node_t * pAnd;
+    int i, k, n, iLit0, iLit1, iGate;
+    assert( p->pProgs == NULL );
+    p->pProgs = ABC_CALLOC( Rwr_Prog_t, Vec_VecSize(p->vClasses) );
+    vPairs  = Vec_IntAlloc( 1000 );
+    vGraphs = Vec_IntAlloc( 1000 );
+    vGates  = Vec_IntAlloc( 100 );
+    Vec_VecForEachLevel( p->vClasses, vSubgraphs, i )
+    {
+        pProg = p->pProgs + i;
+        pProg->pStarts = ABC_ALLOC( int, Vec_PtrSize(vSubgraphs) + 1 );
+        Vec_IntClear( vPairs );
+        Vec_IntClear( vGraphs );
+        pHash = Hsh_IntManStart( vPairs, 2, 1000 );
+        Vec_PtrForEachEntry( Rwr_Node_t *, vSubgraphs, pNode, k )
+        {
+            pGraph = (Dec_Graph_t *)pNode->pNext;
+            pProg->pStarts[k] = Vec_IntSize( vGraphs );
+            Vec_IntPush( vGraphs, 0 );
+            // the graph nodes are in the topological order; iFunc of a node remembers its var
+            Dec_GraphForEachLeaf( pGraph, pAnd, n )
+                pAnd->iFunc = n;
+            Vec_IntClear( vGates );
+            Dec_GraphForEachNode( pGraph, pAnd, n )
+            {
+                iLit0 = Abc_Var2Lit( Dec_GraphNode(pGraph, pAnd->eEdge0.Node)->iFunc, pAnd->eEdge0.fCompl );
+                iLit1 = Abc_Var2Lit( Dec_GraphNode(pGraph, pAnd->eEdge1.Node)->iFunc, pAnd->eEdge1.fCompl );
+                Vec_IntPush( vPairs, Abc_MinInt(iLit0, iLit1) );
+                Vec_IntPush( vPairs, Abc_MaxInt(iLit0, iLit1) );
+                iGate = Hsh_IntManAdd( pHash, Vec_IntSize(vPairs) / 2 - 1 );
+                if ( iGate < Vec_IntSize(vPairs) / 2 - 1 )
+                    Vec_IntShrink( vPairs, Vec_IntSize(vPairs) - 2 );
+                pAnd->iFunc = 4 + iGate;
+                Vec_IntPush( vGates, iGate );
+            }
+            Vec_IntAddToEntry( vGraphs, pProg->pStarts[k], Vec_IntSize(vGates) );
+            Vec_IntAppend( vGraphs, vGates );
+        }
+        pProg->pStarts[k] = Vec_IntSize( vGraphs );
+        pProg->nGates  = Vec_IntSize( vPairs ) / 2;
+        pProg->pFanins = Vec_IntReleaseArray( vPairs );
+        pProg->pGraphs = Vec_IntReleaseArray( vGraphs );
+        Hsh_IntManStop( pHash );
+        p->nGatesMax = Abc_MaxInt( p->nGatesMax, pProg->nGates );
+    }
+    Vec_IntFree( vPairs );
+    Vec_IntFree( vGraphs );
+    Vec_IntFree( vGates );
+    // the storage for evaluating the gates
+    p->pGateStamps = ABC_CALLOC( int, 4 + p->nGatesMax );
+    p->pGateFuncs  = ABC_CALLOC( Abc_Obj_t *, 4 + p->nGatesMax );
+    p->pGateLevels = ABC_CALLOC( int, 4 + p->nGatesMax );
+    p->pGateInfo   = ABC_CALLOC( char, 4 + p->nGatesMax );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Frees the compiled classes.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Rwr_ManCompileFree( Rwr_Man_t * p )
+{
+    int i;
+    if ( p->pProgs == NULL )
+        return;
+    for ( i = 0; i < Vec_VecSize(p->vClasses); i++ )
+    {
+        ABC_FREE( p->pProgs[i].pFanins );
+        ABC_FREE( p->pProgs[i].pStarts );
+        ABC_FREE( p->pProgs[i].pGraphs );
+    }
+    ABC_FREE( p->pProgs );
+    ABC_FREE( p->pGateStamps );
+    ABC_FREE( p->pGateFuncs );
+    ABC_FREE( p->pGateLevels );
+    ABC_FREE( p->pGateInfo );
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -29,7 +29,7 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
-static Dec_Graph_t * Rwr_CutEvaluate( Rwr_Man_t * p, Abc_Obj_t * pRoot, Cut_Cut_t * pCut, Vec_Ptr_t * vFaninsCur, int nNodesSaved, int LevelMax, int * pGainBest, int fPlaceEnable );
+static Dec_Graph_t * Rwr_CutEvaluate( Rwr_Man_t * p, Abc_Obj_t * pRoot, Cut_Cut_t * pCut, Vec_Ptr_t * vFaninsCur, Vec_Ptr_t * vMffc, int nNodesSaved, int LevelMax, int * pGainBest, int fPlaceEnable );
 static int Rwr_CutIsBoolean( Abc_Obj_t * pObj, Vec_Ptr_t * vLeaves );
 static int Rwr_CutCountNumNodes( Abc_Obj_t * pObj, Cut_Cut_t * pCut );
 static int Rwr_NodeGetDepth_rec( Abc_Obj_t * pObj, Vec_Ptr_t * vLeaves );
@@ -66,7 +66,7 @@ int Rwr_NodeRewrite( Rwr_Man_t * p, Cut_Man_t * pManCut, Abc_Obj_t * pNode, int
     unsigned uTruthBest = 0; // Suppress "might be used uninitialized"
     unsigned uTruth;
     char * pPerm;
-    int Required, nNodesSaved;
+    int Required, nNodesSaved, nMffcSize = -2, fLabeled = 0;
     int nNodesSaveCur = -1; // Suppress "might be used uninitialized"
     int i, GainCur = -1, GainBest = -1;
     abctime clk, clk2;//, Counter;
@@ -80,6 +80,8 @@ clk = Abc_Clock();
     pCut = (Cut_Cut_t *)Abc_NodeGetCutsRecursive( pManCut, pNode, 0, 0 );
     assert( pCut != NULL );
 p->timeCut += Abc_Clock() - clk;
+    if ( Util_StatIsOn() )
+        Util_StatAdd( UTIL_STAT_NODE_CUTS, Cut_CutCountList(pCut->pNext) );
 
 //printf( " %d", Rwr_CutCountNumNodes(pNode, pCut) );
 /*
@@ -135,21 +137,33 @@ clk2 = Abc_Clock();
             printf( "%d ", Abc_ObjFanoutNum(Abc_ObjRegular(pFanin)) );
         printf( ")\n" );
 */
-        // mark the fanin boundary 
-        Vec_PtrForEachEntry( Abc_Obj_t *, p->vFaninsCur, pFanin, i )
-            Abc_ObjRegular(pFanin)->vFanouts.nSize++;
+        // collect the MFFC once (the MFFCs bounded by the cuts are derived from it)
+        if ( nMffcSize == -2 )
+            nMffcSize = Abc_NodeMffcCollectLimit( pNode, p->vMffc, RWR_MFFC_LIMIT );
+        if ( nMffcSize >= 0 )
+        {
+            // label MFFC bounded by the cut using the collected MFFC
+            nNodesSaved = Abc_NodeMffcLabelLeaves( p->vMffc, p->vFaninsCur, &fLabeled );
+        }
+        else
+        {
+            // mark the fanin boundary 
+            Vec_PtrForEachEntry( Abc_Obj_t *, p->vFaninsCur, pFanin, i )
+                Abc_ObjRegular(pFanin)->vFanouts.nSize++;
 
-        // label MFFC with current ID
-        Abc_NtkIncrementTravId( pNode->pNtk );
-        nNodesSaved = Abc_NodeMffcLabelAig( pNode );
-        // unmark the fanin boundary
-        Vec_PtrForEachEntry( Abc_Obj_t *, p->vFaninsCur, pFanin, i )
-            Abc_ObjRegular(pFanin)->vFanouts.nSize--;
+            // label MFFC with current ID
+            Abc_NtkIncrementTravId( pNode->pNtk );
+            nNodesSaved = Abc_NodeMffcLabelAig( pNode );
+            // unmark the fanin boundary
+            Vec_PtrForEachEntry( Abc_Obj_t *, p->vFaninsCur, pFanin, i )
+                Abc_ObjRegular(pFanin)->vFanouts.nSize--;
+        }
 p->timeMffc += Abc_Clock() - clk2;
 
         // evaluate the cut
 clk2 = Abc_Clock();
-        pGraph = Rwr_CutEvaluate( p, pNode, pCut, p->vFaninsCur, nNodesSaved, Required, &GainCur, fPlaceEnable );
+        GainCur = GainBest;
+        pGraph = Rwr_CutEvaluate( p, pNode, pCut, p->vFaninsCur, NULL, nNodesSaved, Required, &GainCur, fPlaceEnable );
 p->timeEval += Abc_Clock() - clk2;
 
         // check if the cut is better than the current best one
@@ -239,43 +253,391 @@ p->timeRes += Abc_Clock() - clk;
     return GainBest;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Performs speculative rewriting for one node.]
+
+  Description [Same as Rwr_NodeRewrite() but does not write into the 
+  network, the cut manager, or the traversal IDs, so that several nodes 
+  can be evaluated concurrently, each with its own rewriting manager.
+  The cuts and the required level are computed by the caller. The 
+  result is saved in pSpec together with the leaves of the evaluated 
+  cuts (the window), which are used to detect whether the result is 
+  still valid after other nodes are rewritten.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Rwr_NodeRewriteSpec( Rwr_Man_t * p, Rwr_Spec_t * pSpec )
+{
+    Abc_Obj_t * pNode = pSpec->pNode;
+    Dec_Graph_t * pGraph;
+    Cut_Cut_t * pCut;
+    Abc_Obj_t * pFanin;
+    unsigned uPhase, uTruth;
+    char * pPerm;
+    int i, nNodesSaved, GainCur = -1, GainBest = -1;
+    abctime clk = Abc_Clock();
+
+    p->nNodesConsidered++;
+    pSpec->pGraph = NULL;
+    Vec_IntClear( pSpec->vWindow );
+    if ( Util_StatIsOn() )
+        Util_StatAdd( UTIL_STAT_NODE_CUTS, Cut_CutCountList(((Cut_Cut_t *)pSpec->pCuts)->pNext) );
+    for ( pCut = ((Cut_Cut_t *)pSpec->pCuts)->pNext; pCut; pCut = pCut->pNext )
+    {
+        // consider only 4-input cuts
+        if ( pCut->nLeaves < 4 )
+            continue;
+        // get the fanin permutation
+        uTruth = 0xFFFF & *Cut_CutReadTruth(pCut);
+        pPerm = p->pPerms4[ (int)p->pPerms[uTruth] ];
+        uPhase = p->pPhases[uTruth];
+        // collect fanins with the corresponding permutation/phase
+        Vec_PtrClear( p->vFaninsCur );
+        Vec_PtrFill( p->vFaninsCur, (int)pCut->nLeaves, 0 );
+        for ( i = 0; i < (int)pCut->nLeaves; i++ )
+        {
+            pFanin = Abc_NtkObj( pNode->pNtk, pCut->pLeaves[(int)pPerm[i]] );
+            if ( pFanin == NULL )
+                break;
+            pFanin = Abc_ObjNotCond(pFanin, ((uPhase & (1<<i)) > 0) );
+            Vec_PtrWriteEntry( p->vFaninsCur, i, pFanin );
+        }
+        if ( i != (int)pCut->nLeaves )
+        {
+            p->nCutsBad++;
+            continue;
+        }
+        p->nCutsGood++;
+        // remember the cut in the window
+        Vec_IntPush( pSpec->vWindow, (int)pCut->nLeaves );
+        for ( i = 0; i < (int)pCut->nLeaves; i++ )
+            Vec_IntPush( pSpec->vWindow, pCut->pLeaves[i] );
+
+        {
+            int Counter = 0;
+            Vec_PtrForEachEntry( Abc_Obj_t *, p->vFaninsCur, pFanin, i )
+                if ( Abc_ObjFanoutNum(Abc_ObjRegular(pFanin)) == 1 )
+                    Counter++;
+            if ( Counter > 2 )
+                continue;
+        }
+
+        // collect MFFC without labeling
+        nNodesSaved = Abc_NodeMffcCollectAig( pNode, p->vFaninsCur, p->vNodesTemp, p->vCone, p->vRefs );
+        // evaluate the cut
+        GainCur = GainBest;
+        pGraph = Rwr_CutEvaluate( p, pNode, pCut, p->vFaninsCur, p->vNodesTemp, nNodesSaved, pSpec->Required, &GainCur, 0 );
+        // check if the cut is better than the current best one
+        if ( pGraph != NULL && GainBest < GainCur )
+        {
+            GainBest       = GainCur;
+            pSpec->pGraph  = pGraph;
+            pSpec->fCompl  = ((uPhase & (1<<4)) > 0);
+            Vec_PtrForEachEntry( Abc_Obj_t *, p->vFaninsCur, pFanin, i )
+            {
+                pSpec->pFanins[i]  = pFanin;
+                pSpec->FaninIds[i] = Abc_ObjRegular(pFanin)->Id;
+            }
+        }
+    }
+    pSpec->Gain = GainBest;
+    pSpec->uWindow = Rwr_NodeWindowHash( pNode, pSpec->vWindow, p->vCone, pSpec->Required != ABC_INFINITY );
+p->timeRes += Abc_Clock() - clk;
+    return GainBest;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Recomputes the gain of the speculative result.]
+
+  Description [Called after other nodes have been rewritten. Checks that
+  the leaves of the best graph are still in the network, relabels the MFFC,
+  and recounts the nodes added by the graph. Returns the current gain or 
+  -1 if the graph cannot be used any more. After this call, the leaves of
+  the graph point to the fanins.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Rwr_NodeRewriteCheck( Rwr_Man_t * p, Rwr_Spec_t * pSpec, int fUpdateLevel )
+{
+    extern int Dec_GraphToNetworkCount( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int NodeMax, int LevelMax );
+    Abc_Obj_t * pNode = pSpec->pNode, * pFanin;
+    Dec_Graph_t * pGraph = (Dec_Graph_t *)pSpec->pGraph;
+    int i, Required, nNodesSaved, nNodesAdded;
+    assert( pGraph != NULL );
+    // check that the leaves are not deleted
+    Vec_PtrClear( p->vFanins );
+    for ( i = 0; i < 4; i++ )
+    {
+        if ( Abc_NtkObj(pNode->pNtk, pSpec->FaninIds[i]) == NULL )
+            return -1;
+        Vec_PtrPush( p->vFanins, pSpec->pFanins[i] );
+    }
+    // label MFFC with current ID
+    Vec_PtrForEachEntry( Abc_Obj_t *, p->vFanins, pFanin, i )
+        Abc_ObjRegular(pFanin)->vFanouts.nSize++;
+    Abc_NtkIncrementTravId( pNode->pNtk );
+    nNodesSaved = Abc_NodeMffcLabelAig( pNode );
+    Vec_PtrForEachEntry( Abc_Obj_t *, p->vFanins, pFanin, i )
+        Abc_ObjRegular(pFanin)->vFanouts.nSize--;
+    // recount the added nodes
+    Required = fUpdateLevel? Abc_ObjRequiredLevel(pNode) : ABC_INFINITY;
+    Vec_PtrForEachEntry( Abc_Obj_t *, p->vFanins, pFanin, i )
+        Dec_GraphNode(pGraph, i)->pFunc = pFanin;
+    nNodesAdded = Dec_GraphToNetworkCount( pNode, pGraph, nNodesSaved, Required );
+    if ( nNodesAdded == -1 )
+        return -1;
+    return nNodesSaved - nNodesAdded;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the signature of the window of the node.]
+
+  Description [The window is the union of the cones of the node bounded 
+  by the leaves of the evaluated cuts. The signature depends on the 
+  structure of the cones, the fanout counters of the internal nodes, 
+  whether the leaves have one fanout, and the levels of the leaves if 
+  levels are used. This is the network data used by Rwr_NodeRewriteSpec(),
+  except for the strashing table. Returns 0 if a leaf has been deleted 
+  or if a cut no longer bounds the cone.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline unsigned Rwr_WindowHashAdd( unsigned uHash, int Entry )
+{
+    return (uHash << 5) + uHash + (unsigned)Entry;
+}
+static int Rwr_NodeWindowHash_rec( Abc_Obj_t * pObj, int * pLeaves, int nLeaves, Vec_Ptr_t * vVisited, unsigned * puHash )
+{
+    Abc_Obj_t * pFanin;
+    int i;
+    for ( i = 0; i < nLeaves; i++ )
+        if ( pObj->Id == pLeaves[i] )
+            return 1;
+    if ( Vec_PtrFind(vVisited, pObj) >= 0 )
+        return 1;
+    if ( !Abc_ObjIsNode(pObj) || Vec_PtrSize(vVisited) == 64 )
+        return 0;
+    // the fanouts of the root do not matter
+    if ( Vec_PtrSize(vVisited) > 0 )
+        *puHash = Rwr_WindowHashAdd( *puHash, Abc_ObjFanoutNum(pObj) );
+    Vec_PtrPush( vVisited, pObj );
+    *puHash = Rwr_WindowHashAdd( *puHash, pObj->Id );
+    Abc_ObjForEachFanin( pObj, pFanin, i )
+    {
+        *puHash = Rwr_WindowHashAdd( *puHash, Abc_Var2Lit(pFanin->Id, Abc_ObjFaninC(pObj, i)) );
+        if ( !Rwr_NodeWindowHash_rec( pFanin, pLeaves, nLeaves, vVisited, puHash ) )
+            return 0;
+    }
+    return 1;
+}
+unsigned Rwr_NodeWindowHash( Abc_Obj_t * pRoot, Vec_Int_t * vWindow, Vec_Ptr_t * vVisited, int fLevels )
+{
+    Abc_Obj_t * pLeaf;
+    unsigned uHash = 0;
+    int i, k, nLeaves, * pLeaves;
+    for ( i = 0; i < Vec_IntSize(vWindow); i += nLeaves + 1 )
+    {
+        nLeaves = Vec_IntEntry( vWindow, i );
+        pLeaves = Vec_IntEntryP( vWindow, i + 1 );
+        for ( k = 0; k < nLeaves; k++ )
+        {
+            pLeaf = Abc_NtkObj( pRoot->pNtk, pLeaves[k] );
+            if ( pLeaf == NULL )
+                return 0;
+            if ( fLevels )
+                uHash = Rwr_WindowHashAdd( uHash, pLeaf->Level );
+            uHash = Rwr_WindowHashAdd( uHash, Abc_ObjFanoutNum(pLeaf) == 1 );
+        }
+        Vec_PtrClear( vVisited );
+        if ( !Rwr_NodeWindowHash_rec( pRoot, pLeaves, nLeaves, vVisited, &uHash ) )
+            return 0;
+    }
+    return uHash ? uHash : 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts evaluating the compiled class for the cut.]
+
+  Description [Assigns the leaves and prefetches the entries of the 
+  structural hashing table for the gates whose fanins are the leaves.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Rwr_ProgStart( Rwr_Man_t * p, Rwr_Prog_t * pProg, Abc_Obj_t * pRoot, Vec_Ptr_t * vFaninsCur )
+{
+    Abc_Aig_t * pMan = (Abc_Aig_t *)pRoot->pNtk->pManFunc;
+    Abc_Obj_t * pFanin;
+    int i, * pFanins;
+    if ( ++p->nGateStamp == ABC_INFINITY )
+    {
+        memset( p->pGateStamps, 0, sizeof(int) * (4 + p->nGatesMax) );
+        p->nGateStamp = 1;
+    }
+    Vec_PtrForEachEntry( Abc_Obj_t *, vFaninsCur, pFanin, i )
+    {
+        p->pGateFuncs[i]  = pFanin;
+        p->pGateLevels[i] = Abc_ObjRegular(pFanin)->Level;
+    }
+    for ( i = 0; i < pProg->nGates; i++ )
+    {
+        pFanins = pProg->pFanins + 2 * i;
+        if ( Abc_Lit2Var(pFanins[1]) >= 4 )
+            continue;
+        Abc_AigAndPrefetch( pMan, Abc_ObjNotCond(p->pGateFuncs[Abc_Lit2Var(pFanins[0])], Abc_LitIsCompl(pFanins[0])),
+                                  Abc_ObjNotCond(p->pGateFuncs[Abc_Lit2Var(pFanins[1])], Abc_LitIsCompl(pFanins[1])) );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Evaluates one gate of the compiled class.]
+
+  Description [Follows Dec_GraphToNetworkCountMffc() for one node of the 
+  graph. The result does not depend on the subgraph, so it is computed 
+  once per cut. The fanins of the gate should be already evaluated.
+  Returns the flags of the gate.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Rwr_ProgEvalGate( Rwr_Man_t * p, Rwr_Prog_t * pProg, int iGate, Abc_Obj_t * pRoot, Vec_Ptr_t * vMffc, int LevelMax )
+{
+    Abc_Obj_t * pAnd, * pAnd0, * pAnd1;
+    int * pFanins = pProg->pFanins + 2 * iGate;
+    int iVar0 = Abc_Lit2Var(pFanins[0]), iVar1 = Abc_Lit2Var(pFanins[1]);
+    int iVar = 4 + iGate, LevelNew, Info = 0;
+    if ( p->pGateStamps[iVar] == p->nGateStamp )
+        return p->pGateInfo[iVar];
+    p->pGateStamps[iVar] = p->nGateStamp;
+    // get the AIG nodes corresponding to the fanins
+    pAnd0 = p->pGateFuncs[iVar0];
+    pAnd1 = p->pGateFuncs[iVar1];
+    if ( pAnd0 && pAnd1 )
+    {
+        // if they are both present, find the resulting node
+        pAnd0 = Abc_ObjNotCond( pAnd0, Abc_LitIsCompl(pFanins[0]) );
+        pAnd1 = Abc_ObjNotCond( pAnd1, Abc_LitIsCompl(pFanins[1]) );
+        pAnd  = Abc_AigAndLookup( (Abc_Aig_t *)pRoot->pNtk->pManFunc, pAnd0, pAnd1 );
+        // the graph is useless if the node is the same as the original root
+        if ( Abc_ObjRegular(pAnd) == pRoot )
+            Info |= RWR_GATE_FAILED;
+    }
+    else
+        pAnd = NULL;
+    // check whether the node is added
+    if ( pAnd == NULL || (vMffc ? Vec_PtrFind(vMffc, Abc_ObjRegular(pAnd)) >= 0 : Abc_NodeIsTravIdCurrent(Abc_ObjRegular(pAnd))) ) 
+        Info |= RWR_GATE_ADDED;
+    // count the number of new levels
+    LevelNew = 1 + Abc_MaxInt( p->pGateLevels[iVar0], p->pGateLevels[iVar1] ); 
+    if ( pAnd )
+    {
+        if ( Abc_ObjRegular(pAnd) == Abc_AigConst1(pRoot->pNtk) )
+            LevelNew = 0;
+        else if ( Abc_ObjRegular(pAnd) == Abc_ObjRegular(pAnd0) )
+            LevelNew = (int)Abc_ObjRegular(pAnd0)->Level;
+        else if ( Abc_ObjRegular(pAnd) == Abc_ObjRegular(pAnd1) )
+            LevelNew = (int)Abc_ObjRegular(pAnd1)->Level;
+    }
+    if ( LevelNew > LevelMax )
+        Info |= RWR_GATE_FAILED;
+    p->pGateFuncs[iVar]  = pAnd;
+    p->pGateLevels[iVar] = LevelNew;
+    p->pGateInfo[iVar]   = Info;
+    return Info;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Counts the number of new nodes added when using the subgraph.]
+
+  Description [Same as Dec_GraphToNetworkCountMffc() for the given 
+  subgraph of the class but reuses the gates evaluated for other 
+  subgraphs of the same cut.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Rwr_ProgCountMffc( Rwr_Man_t * p, Rwr_Prog_t * pProg, int iGraph, Abc_Obj_t * pRoot, Vec_Ptr_t * vMffc, int NodeMax, int LevelMax )
+{
+    int * pGates = pProg->pGraphs + pProg->pStarts[iGraph];
+    int i, Info, Counter = 0;
+    for ( i = 1; i <= pGates[0]; i++ )
+    {
+        Info = Rwr_ProgEvalGate( p, pProg, pGates[i], pRoot, vMffc, LevelMax );
+        if ( Info & RWR_GATE_FAILED )
+            return -1;
+        if ( (Info & RWR_GATE_ADDED) && ++Counter > NodeMax )
+            return -1;
+    }
+    return Counter;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Evaluates the cut.]
 
-  Description []
+  Description [On entry, pGainBest is the gain of the best cut found so far.
+  Since the gain cannot exceed nNodesSaved, the added nodes are counted only
+  as long as the subgraph can improve on it. Returns the best subgraph and
+  its gain in pGainBest, or NULL if the gain could not be improved.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Dec_Graph_t * Rwr_CutEvaluate( Rwr_Man_t * p, Abc_Obj_t * pRoot, Cut_Cut_t * pCut, Vec_Ptr_t * vFaninsCur, int nNodesSaved, int LevelMax, int * pGainBest, int fPlaceEnable )
+Dec_Graph_t * Rwr_CutEvaluate( Rwr_Man_t * p, Abc_Obj_t * pRoot, Cut_Cut_t * pCut, Vec_Ptr_t * vFaninsCur, Vec_Ptr_t * vMffc, int nNodesSaved, int LevelMax, int * pGainBest, int fPlaceEnable )
 {
-    extern int            Dec_GraphToNetworkCount( Abc_Obj_t * pRoot, Dec_Graph_t * pGraph, int NodeMax, int LevelMax );
     Vec_Ptr_t * vSubgraphs;
+    Rwr_Prog_t * pProg;
     Dec_Graph_t * pGraphBest = NULL; // Suppress "might be used uninitialized"
     Dec_Graph_t * pGraphCur;
     Rwr_Node_t * pNode, * pFanin;
-    int nNodesAdded, GainBest, i, k;
+    int nNodesAdded, GainBest, GainMin = *pGainBest, i, k;
     unsigned uTruth;
     float CostBest;//, CostCur;
     // find the matching class of subgraphs
     uTruth = 0xFFFF & *Cut_CutReadTruth(pCut);
     vSubgraphs = Vec_VecEntry( p->vClasses, p->pMap[uTruth] );
     p->nSubgraphs += vSubgraphs->nSize;
+    // start evaluating the gates of the class
+    pProg = p->pProgs + p->pMap[uTruth];
+    Rwr_ProgStart( p, pProg, pRoot, vFaninsCur );
     // determine the best subgraph
     GainBest = -1;
     CostBest = ABC_INFINITY;
     Vec_PtrForEachEntry( Rwr_Node_t *, vSubgraphs, pNode, i )
     {
+        // skip the rest if no graph can be better
+        if ( nNodesSaved <= Abc_MaxInt(GainBest, GainMin) )
+            break;
         // get the current graph
         pGraphCur = (Dec_Graph_t *)pNode->pNext;
         // copy the leaves
         Vec_PtrForEachEntry( Rwr_Node_t *, vFaninsCur, pFanin, k )
             Dec_GraphNode(pGraphCur, k)->pFunc = pFanin;
         // detect how many unlabeled nodes will be reused
-        nNodesAdded = Dec_GraphToNetworkCount( pRoot, pGraphCur, nNodesSaved, LevelMax );
+        nNodesAdded = Rwr_ProgCountMffc( p, pProg, i, pRoot, vMffc, nNodesSaved - Abc_MaxInt(GainBest, GainMin) - 1, LevelMax );
         if ( nNodesAdded == -1 )
             continue;
         assert( nNodesSaved >= nNodesAdded );
@@ -79,6 +79,9 @@ clk = Abc_Clock();
     p->vFanins    = Vec_PtrAlloc( 50 );
     p->vFaninsCur = Vec_PtrAlloc( 50 );
     p->vNodesTemp = Vec_PtrAlloc( 50 );
+    p->vCone      = Vec_PtrAlloc( 50 );
+    p->vRefs      = Vec_IntAlloc( 50 );
+    p->vMffc      = Vec_PtrAlloc( 50 );
     if ( fPrecompute )
     {   // precompute subgraphs
         Rwr_ManPrecompute( p );
@@ -114,9 +117,13 @@ void Rwr_ManStop( Rwr_Man_t * p )
         int i, k;
         Vec_VecForEachEntry( Rwr_Node_t *, p->vClasses, pNode, i, k )
             Dec_GraphFree( (Dec_Graph_t *)pNode->pNext );
+        Rwr_ManCompileFree( p );
     }
     if ( p->vClasses )  Vec_VecFree( p->vClasses );
     Vec_PtrFree( p->vNodesTemp );
+    Vec_PtrFree( p->vCone );
+    Vec_IntFree( p->vRefs );
+    Vec_PtrFree( p->vMffc );
     Vec_PtrFree( p->vForest );
     Vec_IntFree( p->vLevNums );
     Vec_PtrFree( p->vFanins );
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""Synthesis performance benchmark for ABC.
+
+Runs each flow over each design of the corpus in a separate ABC process and
+records the wall time, the peak RSS, the final node count and level, and the
+per-command metrics collected by ABC (see the command "stats").  The results
+are compared with a baseline file and the script fails if any run became
+slower or larger than the baseline by more than the threshold, or if the
+node count grew.
+
+    abc_bench.py --abc build/abc --bench-dir exp-log/benchmark \
+                 --corpus des_area,tv80 --baseline base.json [--update]
+
+With --update (or when the baseline does not exist) the results are written
+into the baseline file instead of being compared with it.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+# the flows: the commands applied after reading the design
+# and the command printing the final statistics
+# (the aliases of abc.rc are not used, because it may not be found)
+FLOWS = {
+    'rewrite':     ('strash; rewrite',                  'print_stats'),
+    'refactor':    ('strash; refactor',                 'print_stats'),
+    'resub':       ('strash; resub',                    'print_stats'),
+    'orchestrate': ('strash; orchestrate',              'print_stats'),
+    'balance':     ('strash; balance',                  'print_stats'),
+    'if':          ('&get -n; &st; &if -K 6',           '&ps'),
+    'cec':         ('&get -n; &st; &syn2; &cec',        '&ps'),
+}
+
+RE_NODES = re.compile(r'(?:and|nd)\s*=\s*(\d+)')
+RE_LEVEL = re.compile(r'lev\s*=\s*(\d+)')
+
+
+def run_one(abc, design, flow, timeout):
+    cmds, ps = FLOWS[flow]
+    fd, stats_file = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    script = 'stats -E %s; read %s; %s; %s' % (stats_file, design, cmds, ps)
+    res = {'status': 'ok'}
+    with tempfile.TemporaryFile() as out:
+        start = time.perf_counter()
+        proc = subprocess.Popen([abc, '-c', script], stdout=out, stderr=subprocess.STDOUT)
+        try:
+            _, code, usage = wait4_timeout(proc, timeout)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+            _, code, usage = os.wait4(proc.pid, 0)
+            res['status'] = 'timeout'
+        res['wall'] = round(time.perf_counter() - start, 4)
+        # ru_maxrss is in kilobytes on Linux and in bytes on macOS
+        res['rss_kb'] = usage.ru_maxrss // (1024 if sys.platform == 'darwin' else 1)
+        out.seek(0)
+        text = out.read().decode('utf-8', 'replace')
+    if res['status'] == 'ok' and code != 0:
+        res['status'] = 'exit %d' % os.WEXITSTATUS(code) if os.WIFEXITED(code) else 'signal %d' % os.WTERMSIG(code)
+    if flow == 'cec' and 'Networks are equivalent' not in text:
+        res['status'] = 'not equivalent'
+    # the last statistics line is printed by the final command
+    lines = [l for l in text.splitlines() if RE_NODES.search(l)]
+    if lines:
+        res['nodes'] = int(RE_NODES.search(lines[-1]).group(1))
+        m = RE_LEVEL.search(lines[-1])
+        if m:
+            res['levels'] = int(m.group(1))
+    elif res['status'] == 'ok':
+        res['status'] = 'no statistics'
+    res['phases'] = read_phases(stats_file)
+    os.remove(stats_file)
+    return res
+
+
+def wait4_timeout(proc, timeout):
+    # os.wait4() returns the resources used by this process only
+    deadline = time.monotonic() + timeout if timeout > 0 else None
+    while True:
+        pid, code, usage = os.wait4(proc.pid, os.WNOHANG)
+        if pid == proc.pid:
+            proc.returncode = code
+            return pid, code, usage
+        if deadline is not None and time.monotonic() > deadline:
+            raise subprocess.TimeoutExpired(proc.args, timeout)
+        time.sleep(0.01)
+
+
+def read_phases(stats_file):
+    # keeps the timers and the histogram totals of each command
+    try:
+        with open(stats_file) as f:
+            records = json.load(f)
+    except (OSError, ValueError):
+        return {}
+    phases = {}
+    for rec in records:
+        metrics = {}
+        for name, value in rec['metrics'].items():
+            if isinstance(value, dict):
+                metrics[name] = {'count': value['count'], 'sum': value['sum'], 'max': value['max']}
+            else:
+                metrics[name] = value
+        name = rec['command']
+        while name in phases:
+            name += "'"
+        phases[name] = metrics
+    return phases
+
+
+def compare(results, baseline, threshold, min_time):
+    problems = []
+    for key, new in sorted(results.items()):
+        if new['status'] != 'ok':
+            problems.append('%s: %s' % (key, new['status']))
+            continue
+        old = baseline.get(key)
+        if old is None or old.get('status') != 'ok':
+            continue
+        if new['wall'] > old['wall'] * (1 + threshold) + min_time:
+            problems.append('%s: wall time %.3f s -> %.3f s' % (key, old['wall'], new['wall']))
+        if new['rss_kb'] > old['rss_kb'] * (1 + threshold):
+            problems.append('%s: peak RSS %d KB -> %d KB' % (key, old['rss_kb'], new['rss_kb']))
+        if new.get('nodes', 0) > old.get('nodes', 0):
+            problems.append('%s: nodes %d -> %d' % (key, old['nodes'], new['nodes']))
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Runs the ABC synthesis benchmark.')
+    parser.add_argument('--abc', required=True, help='the ABC binary')
+    parser.add_argument('--bench-dir', required=True, help='the directory with the designs')
+    parser.add_argument('--corpus', required=True, help='the designs (comma or semicolon separated)')
+    parser.add_argument('--flows', default=','.join(FLOWS), help='the flows to run [default = all]')
+    parser.add_argument('--baseline', required=True, help='the baseline file')
+    parser.add_argument('--output', help='the file to write the results into')
+    parser.add_argument('--threshold', type=float, default=0.15, help='the allowed relative slowdown [default = 0.15]')
+    parser.add_argument('--min-time', type=float, default=0.05, help='the allowed absolute slowdown in seconds [default = 0.05]')
+    parser.add_argument('--repeat', type=int, default=1, help='the number of runs, the fastest is kept [default = 1]')
+    parser.add_argument('--timeout', type=float, default=3600, help='the timeout of one run in seconds [default = 3600]')
+    parser.add_argument('--update', action='store_true', help='write the results into the baseline file')
+    args = parser.parse_args()
+
+    split = lambda s: [x for x in re.split(r'[,;]', s) if x]
+    flows = split(args.flows)
+    for flow in flows:
+        if flow not in FLOWS:
+            parser.error('unknown flow "%s" (known flows: %s)' % (flow, ', '.join(FLOWS)))
+
+    results = {}
+    for name in split(args.corpus):
+        design = os.path.join(args.bench_dir, name if name.endswith('.aig') else name + '.aig')
+        if not os.path.exists(design):
+            parser.error('cannot find design "%s"' % design)
+        name = os.path.splitext(os.path.basename(design))[0]
+        for flow in flows:
+            best = None
+            for _ in range(max(args.repeat, 1)):
+                res = run_one(args.abc, design, flow, args.timeout)
+                if best is None or res['wall'] < best['wall']:
+                    best = res
+            key = '%s/%s' % (name, flow)
+            results[key] = best
+            print('%-32s %-14s %9.3f s %9d KB %9s nodes' % (key, best['status'], best['wall'],
+                  best['rss_kb'], best.get('nodes', '-')))
+            sys.stdout.flush()
+
+    report = {'abc': os.path.abspath(args.abc), 'threshold': args.threshold, 'results': results}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+
+    if args.update or not os.path.exists(args.baseline):
+        with open(args.baseline, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+        print('The baseline was written into "%s".' % args.baseline)
+        failed = [k for k, r in results.items() if r['status'] != 'ok']
+        for key in failed:
+            print('%s: %s' % (key, results[key]['status']))
+        return 1 if failed else 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)['results']
+    problems = compare(results, baseline, args.threshold, args.min_time)
+    for problem in problems:
+        print('REGRESSION %s' % problem)
+    if problems:
+        print('%d regressions (threshold = %.0f%%).' % (len(problems), 100 * args.threshold))
+        return 1
+    print('No regressions against "%s" (threshold = %.0f%%).' % (args.baseline, 100 * args.threshold))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())